@@ -5,19 +5,31 @@
 #include "platform/library_manager.h"
 #include "platform/process_manager.h"
 #include "options/options.h"
+#include <unordered_map>
 
 
 // 桌面窗口管理器管理。
 // 动态加载dwmapi.dll并提供对缓存API状态的访问。
 // 主窗口需要调用此功能来处理广播消息。
+// 函数指针只在构造时解析一次；窗口边框查询按帧缓存，
+// 同一跟踪周期内对同一窗口只查询一次。
+// 帧缓存不加锁，getExtendedFrameBounds、endFrame和wmDwmCompositionChanged只能在UI线程调用。
 //
 class Dwm {
     using DwmIsCompositionEnabled_Ptr = HRESULT (WINAPI*)(BOOL*);
+    using DwmGetWindowAttribute_Ptr = HRESULT (WINAPI*)(HWND, DWORD, PVOID, DWORD);
+    using DwmFlush_Ptr = HRESULT (WINAPI*)();
 public:
     Dwm() {
         dll = libraryManager_.loadLibrary(L"dwmapi");
         if (dll) {
             DwmIsCompositionEnabled_ = libraryManager_.getProcAddress<DwmIsCompositionEnabled_Ptr>(dll, "DwmIsCompositionEnabled");
+            DwmGetWindowAttribute_ = libraryManager_.getProcAddress<DwmGetWindowAttribute_Ptr>(dll, "DwmGetWindowAttribute");
+            DwmFlush_ = libraryManager_.getProcAddress<DwmFlush_Ptr>(dll, "DwmFlush");
+        }
+        LARGE_INTEGER freq;
+        if (QueryPerformanceFrequency(&freq)) {
+            memoTtl_ = freq.QuadPart * MEMO_TTL_MS / 1000;
         }
         wmDwmCompositionChanged();
     }
@@ -30,12 +42,44 @@ public:
     void wmDwmCompositionChanged() {
         BOOL b;
         cachedIsCompositionEnabled = dll && DwmIsCompositionEnabled_ && SUCCEEDED(DwmIsCompositionEnabled_(&b)) && b;
+        frameMemo_.clear();
     }
+
+    bool hasGetWindowAttribute() const { return DwmGetWindowAttribute_ != nullptr; }
+    bool hasFlush() const { return DwmFlush_ != nullptr; }
+
+    // DwmGetWindowAttribute的直接封装，不可用时返回E_NOTIMPL
+    HRESULT getWindowAttribute(HWND wnd, DWORD attr, PVOID data, DWORD size) const;
+
+    // 等待下一次DWM合成，不可用时返回E_NOTIMPL
+    HRESULT flush() const;
+
+    // 获取窗口的扩展边框（实际可视区域，不含阴影），结果在当前帧内缓存（仅UI线程）。
+    // DWM没有一次查询多个窗口的接口，同一帧内各图钉的查询由帧缓存合并，不另设批量接口
+    bool getExtendedFrameBounds(HWND wnd, RECT& rect);
+
+    // 帧边界：丢弃本帧缓存的查询结果（一次跟踪周期提交后调用）
+    void endFrame() { frameMemo_.clear(); }
+
 private:
+    // 帧缓存的最长有效期（毫秒）；没有提交发生时防止缓存结果长期有效。
+    // 用QPC计时：GetTickCount的分辨率约15.6毫秒，与有效期相当
+    static constexpr LONGLONG MEMO_TTL_MS = 16;
+
+    struct MemoEntry {
+        RECT rect;
+        bool valid;
+        LONGLONG stamp;     // 查询时的QPC计数
+    };
+
     Platform::LibraryManager libraryManager_;
     HMODULE dll = nullptr;
     DwmIsCompositionEnabled_Ptr DwmIsCompositionEnabled_ = nullptr;
+    DwmGetWindowAttribute_Ptr DwmGetWindowAttribute_ = nullptr;
+    DwmFlush_Ptr DwmFlush_ = nullptr;
     bool cachedIsCompositionEnabled = false;
+    LONGLONG memoTtl_ = 0;  // 有效期的QPC计数，为0时缓存只由endFrame()清除
+    std::unordered_map<HWND, MemoEntry> frameMemo_;    // 仅UI线程访问
 };
 
 
@@ -62,12 +106,18 @@ struct App {
         WM_PINREQ,
         WM_QUEUEWINDOW,
         WM_CMDLINE_OPTION,
+        WM_COMMITZORDER,
+        WM_HOOKEVENTS,
+        WM_PINFRAME,
+        WM_AUTOPINTITLE,
         WM_PIN_ASSIGNWND = WM_USER,
         WM_PIN_RESETTIMER,
         WM_PIN_GETPINNEDWND,
+        WM_PIN_WAKE,
         HOTID_ENTERPINMODE = 0,
         HOTID_TOGGLEPIN = 1,
         TIMERID_AUTOPIN = 1,
+        TIMERID_TRACK,
     };
     App() = default;
     ~App() { 
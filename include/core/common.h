@@ -30,11 +30,19 @@ namespace Constants {
     constexpr int MAX_TRACK_RATE = 1000;     // 毫秒
     constexpr int DEFAULT_TRACK_RATE_NEW = 20;   // Win2000/XP
     constexpr int DEFAULT_TRACK_RATE_OLD = 100;  // 旧版Windows
+    constexpr int DEFAULT_IDLE_TRACK_RATE = 250; // 毫秒，目标窗口静止时的跟踪间隔
+    constexpr int IDLE_TRACK_DELAY = 1000;   // 毫秒，目标窗口静止多久后开始降低跟踪频率
+    constexpr int PREDICTION_HORIZON = 16;   // 毫秒，运动预测外推的时间（约一个合成帧）
+    constexpr int MIN_PROXY_RETRY = 50;      // 毫秒，代理窗口查找失败后的首次重试间隔
+    constexpr int MAX_PROXY_RETRY = 2000;    // 毫秒，代理窗口查找失败后的最长重试间隔
     constexpr int MIN_AUTOPIN_DELAY = 100;   // 毫秒
     constexpr int MAX_AUTOPIN_DELAY = 10000; // 毫秒
     constexpr int DEFAULT_AUTOPIN_DELAY = 200; // 毫秒
+    constexpr int AUTOPIN_TITLE_WATCH = 30000; // 毫秒，未匹配的窗口在此期间内标题变化时重新检查
+    constexpr int AUTOPIN_RECHECK_INTERVAL = 250; // 毫秒，同一窗口两次重新检查的最小间隔
     constexpr int TOP_STYLE_CHECK_INTERVAL = 500; // 毫秒，层级检查间隔
     constexpr int FIX_VISIBLE_INTERVAL = 100; // 毫秒，可见性修复间隔
+    constexpr int STATS_REPORT_INTERVAL = 10000; // 毫秒，调试日志中统计信息的输出间隔
     
     // UI相关
     constexpr int DEFAULT_LAYER_WND_POS = 100; // 层窗口默认位置
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Foundation {
+
+    // 自适应轮询间隔
+    // 观察到变化时立即回到快速间隔；连续idleDelay毫秒没有变化后，每次轮询把间隔加倍，直到慢速间隔。
+    // 逐步放慢而不是直接切换，避免间歇变化时间隔来回跳动。
+    // 时间为毫秒，按32位无符号数回绕（与GetTickCount相同）。
+    // 不依赖任何平台接口。
+    class AdaptiveInterval {
+    public:
+        // 以fast间隔重新开始，并把now视为最近一次变化
+        void reset(int fast, uint32_t now);
+
+        // 一次轮询的结果，返回之后使用的间隔；slow小于快速间隔时按快速间隔处理
+        int update(bool changed, uint32_t now, int slow, uint32_t idleDelay);
+
+        // 外部通知有变化（如窗口事件），回到快速间隔；返回间隔是否因此改变
+        bool wake(uint32_t now);
+
+        int current() const { return m_current; }
+        int fast() const { return m_fast; }
+
+    private:
+        int m_fast = 0;
+        int m_current = 0;
+        uint32_t m_lastActivity = 0;
+    };
+
+} // namespace Foundation
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Foundation {
+
+    // 绑定窗口集合及其位置缓存
+    // 保存绑定的窗口、已提交（或观察到）的位置和已请求移动、尚未确认提交的目标位置。
+    // 图钉增减时逐个加入/移除窗口，只查询变化的那一个窗口的位置；也可以用完整列表重建。
+    // 位置通过调用者提供的locate(wnd, Point&)查询，返回false表示不记录该窗口的位置。
+    // 不依赖任何平台接口；Handle为窗口句柄类型，Point为位置类型。
+    template<typename Handle, typename Point>
+    class BoundWindowSet {
+    public:
+        // 加入窗口并记录其位置；窗口已在集合中时不做任何事并返回false
+        template<typename Locate>
+        bool add(Handle wnd, Locate&& locate) {
+            if (!m_windows.insert(wnd).second) return false;
+            Point point;
+            if (locate(wnd, point)) {
+                m_committed[wnd] = point;
+            }
+            return true;
+        }
+
+        // 移除窗口及其位置；窗口不在集合中时返回false
+        bool remove(Handle wnd) {
+            m_committed.erase(wnd);
+            m_targets.erase(wnd);
+            return m_windows.erase(wnd) != 0;
+        }
+
+        // 用完整列表替换集合，并重新记录全部位置
+        template<typename Locate>
+        void assign(const std::vector<Handle>& windows, Locate&& locate) {
+            m_windows.clear();
+            m_windows.insert(windows.begin(), windows.end());
+            relocate(locate);
+        }
+
+        // 丢弃全部位置（包括目标位置），重新查询集合中每个窗口的位置
+        template<typename Locate>
+        void relocate(Locate&& locate) {
+            m_committed.clear();
+            m_targets.clear();
+            for (Handle wnd : m_windows) {
+                Point point;
+                if (locate(wnd, point)) {
+                    m_committed[wnd] = point;
+                }
+            }
+        }
+
+        void clear() {
+            m_windows.clear();
+            m_committed.clear();
+            m_targets.clear();
+        }
+
+        bool contains(Handle wnd) const { return m_windows.count(wnd) != 0; }
+        size_t size() const { return m_windows.size(); }
+        const std::unordered_set<Handle>& windows() const { return m_windows; }
+
+        // 位置变化量相对已提交的位置计算
+        std::unordered_map<Handle, Point>& committed() { return m_committed; }
+        // 已请求移动、尚未确认提交的目标位置
+        std::unordered_map<Handle, Point>& targets() { return m_targets; }
+
+    private:
+        std::unordered_set<Handle> m_windows;
+        std::unordered_map<Handle, Point> m_committed;
+        std::unordered_map<Handle, Point> m_targets;
+    };
+
+} // namespace Foundation
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <cwchar>
+#include <string>
+#include <string_view>
+
+namespace Foundation {
+
+    // 定长内联宽字符串
+    // 字符保存在对象内部，不分配堆内存；超过容量的部分被截断。
+    // Capacity包含结尾的0，可直接作为Win32 API的输出缓冲区（buffer()/capacity()，写入后调用setLength）。
+    // 复制时只复制实际长度的字符。
+    template<size_t Capacity>
+    class InlineWString {
+        static_assert(Capacity >= 1, "Capacity至少为1");
+
+    public:
+        static constexpr size_t npos = std::wstring_view::npos;
+
+        InlineWString() { m_data[0] = L'\0'; }
+        InlineWString(const wchar_t* s) { assign(s); }
+        InlineWString(std::wstring_view s) { assign(s.data(), s.size()); }
+
+        InlineWString(const InlineWString& other) { assign(other.m_data, other.m_length); }
+        InlineWString& operator=(const InlineWString& other) {
+            if (this != &other) {
+                assign(other.m_data, other.m_length);
+            }
+            return *this;
+        }
+
+        InlineWString& operator=(const wchar_t* s) { assign(s); return *this; }
+        InlineWString& operator=(std::wstring_view s) { assign(s.data(), s.size()); return *this; }
+
+        void assign(const wchar_t* s, size_t length) {
+            m_length = length < Capacity ? length : Capacity - 1;
+            if (m_length) {
+                memmove(m_data, s, m_length * sizeof(wchar_t));
+            }
+            m_data[m_length] = L'\0';
+        }
+
+        void assign(const wchar_t* s) {
+            assign(s ? s : L"", s ? wcsnlen(s, Capacity - 1) : 0);
+        }
+
+        void clear() {
+            m_length = 0;
+            m_data[0] = L'\0';
+        }
+
+        // 供API直接写入的缓冲区，写入后必须调用setLength
+        wchar_t* buffer() { return m_data; }
+        static constexpr size_t capacity() { return Capacity; }
+
+        // 设置写入的字符数（超出容量时截断），并补上结尾的0
+        void setLength(size_t length) {
+            m_length = length < Capacity ? length : Capacity - 1;
+            m_data[m_length] = L'\0';
+        }
+
+        const wchar_t* c_str() const { return m_data; }
+        const wchar_t* data() const { return m_data; }
+        size_t size() const { return m_length; }
+        size_t length() const { return m_length; }
+        bool empty() const { return m_length == 0; }
+
+        std::wstring_view view() const { return std::wstring_view(m_data, m_length); }
+        std::wstring str() const { return std::wstring(m_data, m_length); }
+
+        size_t find(std::wstring_view s, size_t pos = 0) const { return view().find(s, pos); }
+
+        friend bool operator==(const InlineWString& a, std::wstring_view b) { return a.view() == b; }
+        friend bool operator!=(const InlineWString& a, std::wstring_view b) { return a.view() != b; }
+        friend bool operator==(const InlineWString& a, const wchar_t* b) { return a.view() == b; }
+        friend bool operator!=(const InlineWString& a, const wchar_t* b) { return a.view() != b; }
+        friend bool operator==(const InlineWString& a, const InlineWString& b) { return a.view() == b.view(); }
+        friend bool operator!=(const InlineWString& a, const InlineWString& b) { return a.view() != b.view(); }
+
+    private:
+        size_t m_length = 0;
+        wchar_t m_data[Capacity];
+    };
+
+} // namespace Foundation
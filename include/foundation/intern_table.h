@@ -0,0 +1,89 @@
+#pragma once
+
+#include "foundation/inline_string.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Foundation {
+
+    // 不区分大小写的名称驻留表
+    // 名称按ASCII转为小写（与_wcsicmp在默认区域设置下一致）后映射为从1开始的连续ID，0表示未知；
+    // 同时保存名称第一次出现时的大小写。查找时在栈上转换大小写，不分配堆内存。
+    // 名称超过Capacity-1个字符时截断。不加锁，不依赖任何平台接口。
+    template<size_t Capacity>
+    class InternTable {
+    public:
+        using Id = uint32_t;
+        using Name = InlineWString<Capacity>;
+
+        InternTable() {
+            // ID 0保留给未知的名称
+            m_folded.emplace_back();
+            m_names.emplace_back();
+        }
+
+        // 按ASCII转为小写
+        static void fold(std::wstring_view name, Name& folded) {
+            size_t length = (std::min)(name.size(), folded.capacity() - 1);
+            wchar_t* out = folded.buffer();
+            for (size_t n = 0; n < length; ++n) {
+                wchar_t c = name[n];
+                out[n] = (c >= L'A' && c <= L'Z') ? static_cast<wchar_t>(c + (L'a' - L'A')) : c;
+            }
+            folded.setLength(length);
+        }
+
+        // 驻留名称，返回其ID；空名称返回0。added表示是否为新加入的名称
+        Id intern(std::wstring_view name, bool* added = nullptr) {
+            if (added) *added = false;
+            if (name.empty()) return 0;
+
+            Name folded;
+            fold(name, folded);
+            auto it = m_ids.find(folded.view());
+            if (it != m_ids.end()) {
+                return it->second;
+            }
+
+            Id id = static_cast<Id>(m_folded.size());
+            m_folded.push_back(folded.str());
+            m_names.emplace_back(name.substr(0, folded.size()));
+            m_ids.emplace(std::wstring_view(m_folded.back()), id);
+            if (added) *added = true;
+            return id;
+        }
+
+        // 只查找不驻留，不存在时返回0
+        Id find(std::wstring_view name) const {
+            Name folded;
+            fold(name, folded);
+            auto it = m_ids.find(folded.view());
+            return it != m_ids.end() ? it->second : 0;
+        }
+
+        // 第一次出现时的名称；未知的ID返回空
+        std::wstring_view name(Id id) const {
+            return id < m_names.size() ? std::wstring_view(m_names[id]) : std::wstring_view();
+        }
+
+        // 转为小写后的名称
+        std::wstring_view folded(Id id) const {
+            return id < m_folded.size() ? std::wstring_view(m_folded[id]) : std::wstring_view();
+        }
+
+        // 已驻留的名称数量
+        size_t size() const { return m_folded.size() - 1; }
+
+    private:
+        std::deque<std::wstring> m_folded;              // 按ID保存的小写名称，地址稳定，供m_ids的键引用
+        std::vector<std::wstring> m_names;              // 按ID保存的原始名称
+        std::unordered_map<std::wstring_view, Id> m_ids;
+    };
+
+} // namespace Foundation
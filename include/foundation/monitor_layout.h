@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Foundation {
+
+    // 显示器布局
+    // 保存一组显示器的矩形、工作区和DPI，按x坐标把桌面切成若干竖条，
+    // 每个竖条内的显示器按y排序，点查询为两次二分查找（O(log n)）。
+    // 点不在任何显示器上时返回最近的显示器，与MONITOR_DEFAULTTONEAREST一致。
+    // 不依赖任何平台接口。
+    class MonitorLayout {
+    public:
+        // 矩形（右、下边界不包含在内）
+        struct Rect {
+            int left;
+            int top;
+            int right;
+            int bottom;
+
+            bool contains(int x, int y) const { return x >= left && x < right && y >= top && y < bottom; }
+            bool empty() const { return right <= left || bottom <= top; }
+        };
+
+        struct Monitor {
+            uintptr_t id;       // 平台的显示器句柄
+            Rect bounds;        // 显示器矩形
+            Rect workArea;      // 工作区（去掉任务栏等）
+            int dpi;
+        };
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        // 替换全部显示器并重建索引
+        void assign(std::vector<Monitor> monitors);
+
+        const std::vector<Monitor>& monitors() const { return m_monitors; }
+        bool empty() const { return m_monitors.empty(); }
+
+        // 返回包含该点的显示器序号；不在任何显示器上时返回最近的，没有显示器时返回npos
+        size_t fromPoint(int x, int y) const;
+
+        // 返回与矩形相交面积最大的显示器序号；不相交时返回离矩形中心最近的
+        size_t fromRect(const Rect& rc) const;
+
+    private:
+        // 竖条：[left, right)范围内的显示器，按top排序
+        struct Slab {
+            int left;
+            int right;
+            std::vector<size_t> monitors;
+        };
+
+        // 只查找包含该点的显示器，不存在时返回npos
+        size_t lookup(int x, int y) const;
+        size_t nearest(int x, int y) const;
+
+        std::vector<Monitor> m_monitors;
+        std::vector<Slab> m_slabs;
+    };
+
+} // namespace Foundation
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Foundation {
+
+    // 运动预测器
+    // 对带时间戳的二维位置采样做 alpha-beta 滤波估计速度，
+    // 把位置外推到指定的时间，用于让图钉在拖动时跟上窗口。
+    // 位置不变或采样间隔过长时立即停止外推，回到实际位置。
+    // 不依赖任何平台接口。
+    class MotionPredictor {
+    public:
+        // 位置（像素）
+        struct Point {
+            int x;
+            int y;
+        };
+
+        // alpha: 位置修正系数，beta: 速度修正系数
+        explicit MotionPredictor(double alpha = 0.85, double beta = 0.5)
+            : m_alpha(alpha), m_beta(beta) {}
+
+        // 清除状态（目标改变或图钉被外部移动时调用）
+        void reset();
+
+        // 加入一个采样，时间单位为毫秒
+        void addSample(double timeMs, Point pos);
+
+        // 预测指定时刻的位置；静止或没有速度估计时返回最后一次采样的位置
+        Point predict(double timeMs) const;
+
+        // 最后一次采样的位置
+        Point last() const { return m_last; }
+
+        bool hasSample() const { return m_hasSample; }
+        bool isMoving() const { return m_moving; }
+
+        // 预测误差统计：每个新采样与上一状态对该时刻的预测之间的距离
+        double averageError() const { return m_errorSamples ? m_errorSum / m_errorSamples : 0.0; }
+        size_t errorSamples() const { return m_errorSamples; }
+
+        // 采样间隔超过此值（毫秒）时认为运动已中断，速度清零
+        static constexpr double MAX_SAMPLE_GAP = 100.0;
+        // 外推距离上限（像素），避免速度估计异常时图钉飞出
+        static constexpr double MAX_EXTRAPOLATION = 120.0;
+        // 间隔小于此值（毫秒）的采样视为同一时刻的重复读取
+        static constexpr double MIN_SAMPLE_INTERVAL = 2.0;
+
+    private:
+        double m_alpha;
+        double m_beta;
+
+        bool m_hasSample = false;
+        bool m_moving = false;
+        Point m_last = {};
+        double m_lastTime = 0.0;
+        double m_x = 0.0, m_y = 0.0;        // 滤波后的位置
+        double m_vx = 0.0, m_vy = 0.0;      // 速度（像素/毫秒）
+
+        double m_errorSum = 0.0;
+        size_t m_errorSamples = 0;
+    };
+
+} // namespace Foundation
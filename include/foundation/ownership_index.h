@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace Foundation {
+
+    // 顶级窗口所有关系的索引
+    // 按线程保存顶级窗口（按z-order从上到下）及其所有者，并按窗口索引所在线程和所有者。
+    // 可以用一次完整枚举的结果替换整个线程，也可以按窗口创建、销毁、所有者改变逐项更新。
+    // 不依赖任何平台接口；Handle为窗口句柄类型，ThreadId为线程标识。
+    template<typename Handle, typename ThreadId>
+    class OwnershipIndex {
+    public:
+        // 用完整枚举的结果替换线程的全部窗口；owners与windows一一对应
+        void assign(ThreadId thread, const std::vector<Handle>& windows, const std::vector<Handle>& owners) {
+            Thread& node = m_threads[thread];
+            forget(node);
+            node.windows = windows;
+            node.owners = owners;
+            for (size_t n = 0; n < windows.size(); ++n) {
+                m_windows[windows[n]] = Window{ owners[n], thread };
+            }
+        }
+
+        // 移除线程及其全部窗口
+        void removeThread(ThreadId thread) {
+            auto it = m_threads.find(thread);
+            if (it == m_threads.end()) return;
+            forget(it->second);
+            m_threads.erase(it);
+        }
+
+        bool hasThread(ThreadId thread) const { return m_threads.count(thread) != 0; }
+
+        // 线程上新出现的顶级窗口：新建的窗口位于z-order顶部，放在线程的最前面。
+        // 窗口已在索引中时只更新所有者
+        void insert(ThreadId thread, Handle wnd, Handle owner) {
+            if (setOwner(wnd, owner)) return;
+            Thread& node = m_threads[thread];
+            node.windows.insert(node.windows.begin(), wnd);
+            node.owners.insert(node.owners.begin(), owner);
+            m_windows[wnd] = Window{ owner, thread };
+        }
+
+        // 移除窗口（销毁或变为子窗口）；不在索引中时返回false
+        bool erase(Handle wnd) {
+            auto it = m_windows.find(wnd);
+            if (it == m_windows.end()) return false;
+            Thread& node = m_threads[it->second.thread];
+            size_t n = position(node, wnd);
+            node.windows.erase(node.windows.begin() + n);
+            node.owners.erase(node.owners.begin() + n);
+            m_windows.erase(it);
+            return true;
+        }
+
+        // 更新窗口的所有者；不在索引中时返回false
+        bool setOwner(Handle wnd, Handle owner) {
+            auto it = m_windows.find(wnd);
+            if (it == m_windows.end()) return false;
+            it->second.owner = owner;
+            Thread& node = m_threads[it->second.thread];
+            node.owners[position(node, wnd)] = owner;
+            return true;
+        }
+
+        bool contains(Handle wnd) const { return m_windows.count(wnd) != 0; }
+
+        // 已索引窗口的所有者；窗口不在索引中时返回false
+        bool ownerOf(Handle wnd, Handle& owner) const {
+            auto it = m_windows.find(wnd);
+            if (it == m_windows.end()) return false;
+            owner = it->second.owner;
+            return true;
+        }
+
+        // 已索引窗口所在的线程；窗口不在索引中时返回false
+        bool threadOf(Handle wnd, ThreadId& thread) const {
+            auto it = m_windows.find(wnd);
+            if (it == m_windows.end()) return false;
+            thread = it->second.thread;
+            return true;
+        }
+
+        // 线程上的owner本身及被owner拥有的顶级窗口，按z-order从上到下
+        std::vector<Handle> ownedWindows(ThreadId thread, Handle owner) const {
+            std::vector<Handle> result;
+            auto it = m_threads.find(thread);
+            if (it == m_threads.end()) return result;
+            const Thread& node = it->second;
+            for (size_t n = 0; n < node.windows.size(); ++n) {
+                if (node.windows[n] == owner || node.owners[n] == owner) {
+                    result.push_back(node.windows[n]);
+                }
+            }
+            return result;
+        }
+
+        // 线程的顶级窗口，按z-order从上到下；线程不在索引中时返回nullptr
+        const std::vector<Handle>* windows(ThreadId thread) const {
+            auto it = m_threads.find(thread);
+            return it != m_threads.end() ? &it->second.windows : nullptr;
+        }
+
+        size_t size() const { return m_windows.size(); }
+
+    private:
+        struct Thread {
+            std::vector<Handle> windows;    // 按z-order
+            std::vector<Handle> owners;     // 与windows一一对应
+        };
+
+        struct Window {
+            Handle owner;
+            ThreadId thread;
+        };
+
+        static size_t position(const Thread& node, Handle wnd) {
+            return static_cast<size_t>(std::find(node.windows.begin(), node.windows.end(), wnd) - node.windows.begin());
+        }
+
+        void forget(const Thread& node) {
+            for (Handle wnd : node.windows) {
+                m_windows.erase(wnd);
+            }
+        }
+
+        std::unordered_map<ThreadId, Thread> m_threads;
+        std::unordered_map<Handle, Window> m_windows;
+    };
+
+} // namespace Foundation
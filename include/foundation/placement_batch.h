@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace Foundation {
+
+    // 一帧内窗口位置/层级请求的收集与剔除，不访问任何窗口
+    // 同一窗口的多次请求合并为一项，后到的覆盖先到的；
+    // 取出计划时剔除与上次成功应用的位置相同的移动，既不移动也不调整层级的项不进入计划。
+    // Handle为窗口句柄类型，需可作为unordered_map的键。
+    template<typename Handle>
+    class PlacementBatch {
+    public:
+        // 单个窗口在一帧内的位置/层级请求
+        struct Request {
+            Handle wnd{};
+            bool move = false;           // 是否需要移动
+            int x = 0, y = 0;
+            bool zorder = false;         // 是否需要调整层级
+            Handle insertAfter{};        // HWND_TOP / HWND_TOPMOST / HWND_NOTOPMOST 等
+        };
+
+        // 获取窗口的待处理请求，不存在时创建；merged表示本帧已有该窗口的请求
+        Request& request(Handle wnd, bool& merged) {
+            auto it = m_index.find(wnd);
+            merged = it != m_index.end();
+            if (merged) {
+                return m_pending[it->second];
+            }
+            m_index[wnd] = m_pending.size();
+            m_pending.emplace_back();
+            m_pending.back().wnd = wnd;
+            return m_pending.back();
+        }
+
+        void requestMove(Handle wnd, int x, int y, bool& merged) {
+            Request& req = request(wnd, merged);
+            req.move = true;
+            req.x = x;
+            req.y = y;
+        }
+
+        void requestZOrder(Handle wnd, Handle insertAfter, bool& merged) {
+            Request& req = request(wnd, merged);
+            req.zorder = true;
+            req.insertAfter = insertAfter;
+        }
+
+        // 丢弃窗口的待处理请求和已应用位置
+        void forget(Handle wnd) {
+            m_applied.erase(wnd);
+
+            auto it = m_index.find(wnd);
+            if (it == m_index.end()) return;
+
+            // 只清空请求内容，保持其他项的索引不变
+            m_pending[it->second].move = false;
+            m_pending[it->second].zorder = false;
+        }
+
+        bool empty() const { return m_pending.empty(); }
+
+        // 窗口是否有尚未取出的移动请求
+        bool hasPendingMove(Handle wnd) const {
+            auto it = m_index.find(wnd);
+            return it != m_index.end() && m_pending[it->second].move;
+        }
+
+        // 取出本帧的请求并开始新的一帧
+        std::vector<Request> take() {
+            std::vector<Request> pending;
+            pending.swap(m_pending);
+            m_index.clear();
+            return pending;
+        }
+
+        // 根据已应用的位置剔除无变化的请求，返回需要实际应用的计划
+        std::vector<Request> buildPlan(const std::vector<Request>& pending) const {
+            std::vector<Request> plan;
+            plan.reserve(pending.size());
+
+            for (Request req : pending) {
+                if (req.move) {
+                    auto it = m_applied.find(req.wnd);
+                    if (it != m_applied.end() && it->second.x == req.x && it->second.y == req.y) {
+                        req.move = false;
+                    }
+                }
+                if (req.move || req.zorder) {
+                    plan.push_back(req);
+                }
+            }
+            return plan;
+        }
+
+        // 记录已成功应用的请求；应用失败的请求不记录，下次相同的移动不会被剔除
+        void markApplied(const Request& req) {
+            if (req.move) {
+                m_applied[req.wnd] = Position{ req.x, req.y };
+            }
+        }
+
+    private:
+        struct Position {
+            int x, y;
+        };
+
+        std::vector<Request> m_pending;
+        std::unordered_map<Handle, size_t> m_index;
+        std::unordered_map<Handle, Position> m_applied;
+    };
+
+} // namespace Foundation
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Foundation {
+
+    // 多模式正则表达式集合
+    // 所有模式合并为一个Thompson NFA；匹配时按需构造DFA状态并缓存（惰性DFA），
+    // 缓存超过内存预算时整体清空后继续，因此一次匹配的时间与文本长度成线性关系，不会回溯。
+    // 字符按所有模式中出现的字符集划分为等价类，DFA转移表按等价类索引。
+    // 支持的语法：字面字符、.、[...]/[^...]、\d \w \s \D \W \S、\t \n \r \xHH \uHHHH及标点转义、
+    // ( )、(?: )、|、* + ? {m} {m,} {m,n}（非贪婪形式按相同方式处理）、开头的(?i)（ASCII不区分大小写）。
+    // .匹配包括换行在内的任意字符；[或[^之后紧跟的]是字面字符（如[]a]、[^]]）。
+    // ^和$只能出现在模式的首尾，分别把整个模式锚定到文本开头和结尾；未锚定时匹配文本的任意子串。
+    // 锚点作用于整个模式而不是第一个或最后一个分支：^a|b$等价于^(?:a|b)$。
+    // 分组最多嵌套64层。
+    // 不支持反向引用和环视。字符按代码单元处理（Windows上为UTF-16）。
+    // 不是线程安全的，调用者需要串行化。
+    class RegexSet {
+    public:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+        static constexpr size_t DEFAULT_MEMORY_BUDGET = 1 << 20;
+
+        // 统计信息
+        struct Stats {
+            size_t matches;         // 匹配次数
+            size_t states;          // 当前缓存的DFA状态数
+            size_t statesBuilt;     // 累计构造的DFA状态数
+            size_t cacheResets;     // 超出预算而清空缓存的次数
+            size_t memory;          // 缓存估计占用的字节数
+        };
+
+        explicit RegexSet(size_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+
+        // 添加模式，返回其序号；语法错误或模式过大时返回npos，错误说明写入error
+        size_t add(std::wstring_view pattern, std::wstring* error = nullptr);
+
+        size_t size() const { return m_starts.size(); }
+        bool empty() const { return m_starts.empty(); }
+        void clear();
+
+        // 匹配文本，matched中按模式序号置位（每64个模式一个字）
+        void match(std::wstring_view text, std::vector<uint64_t>& matched);
+
+        static bool isSet(const std::vector<uint64_t>& matched, size_t index) {
+            return index / 64 < matched.size() && (matched[index / 64] >> (index % 64)) & 1;
+        }
+
+        Stats getStats() const;
+
+    private:
+        struct Range {
+            uint32_t lo;
+            uint32_t hi;
+        };
+
+        enum NfaKind : uint8_t {
+            NFA_CHARS,      // 匹配字符集m_sets[arg]后转到out
+            NFA_SPLIT,      // 同时转到out和out1
+            NFA_EMPTY,      // 直接转到out
+            NFA_MATCH,      // 模式arg匹配成功
+        };
+
+        struct NfaState {
+            NfaKind kind;
+            int32_t out;
+            int32_t out1;
+            uint32_t arg;
+        };
+
+        struct StateHash {
+            size_t operator()(const std::vector<int32_t>& v) const;
+        };
+
+        struct DfaState {
+            const std::vector<int32_t>* nfa;    // 指向m_stateIndex中的键
+            bool dead;                          // 没有任何NFA状态，之后不可能再匹配
+        };
+
+        friend class RegexCompiler;
+
+        // 计算字符等价类
+        void prepare();
+
+        uint32_t classOf(uint32_t c) const;
+
+        // 从seeds出发的ε闭包，只保留字符和匹配状态，结果排序后写入result
+        void closure(const int32_t* seeds, size_t count, std::vector<int32_t>& result);
+
+        // 查找或创建DFA状态，必要时先清空缓存
+        int32_t stateFor(const std::vector<int32_t>& nfa);
+
+        // 计算状态s在等价类cls上的转移
+        int32_t step(int32_t s, uint32_t cls);
+
+        void resetCache();
+
+        size_t m_budget;
+
+        // NFA
+        std::vector<NfaState> m_nfa;
+        std::vector<std::vector<Range>> m_sets;
+        std::vector<int32_t> m_starts;      // 各模式的起始状态
+
+        // 等价类
+        bool m_prepared = false;
+        std::vector<uint32_t> m_bounds;     // 等价类的分界（每个类的起点，第0类从0开始）
+        std::vector<uint32_t> m_lowClasses; // 0-255的等价类
+        size_t m_classCount = 0;
+        size_t m_classWords = 0;
+        std::vector<uint64_t> m_setClasses; // 每个字符集包含哪些等价类
+
+        // 惰性DFA
+        std::unordered_map<std::vector<int32_t>, int32_t, StateHash> m_stateIndex;
+        std::vector<DfaState> m_states;
+        std::vector<int32_t> m_trans;       // 状态 × 等价类，-1表示尚未计算
+        std::vector<uint64_t> m_accepts;    // 状态 × 模式字，匹配成功的模式
+        int32_t m_initial = -1;
+        size_t m_memory = 0;
+
+        // 闭包计算的临时空间
+        std::vector<uint32_t> m_marks;
+        uint32_t m_stamp = 0;
+        std::vector<int32_t> m_stack;
+        std::vector<int32_t> m_seeds;
+        std::vector<int32_t> m_next;
+
+        Stats m_stats = {};
+    };
+
+} // namespace Foundation
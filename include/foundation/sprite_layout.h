@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Foundation {
+
+    // 把许多小图像（精灵）合成到一块位图上所需的布局计算，供图钉覆盖层使用
+    // 包括矩形运算、位图范围的选择、按单元格的空间索引和预乘Alpha的像素合成。
+    // 不依赖任何平台接口；Rect为带有left/top/right/bottom成员的矩形类型（如RECT），
+    // 右边和下边不包含在内。像素为32位ARGB预乘Alpha，位图自上而下逐行存放。
+
+    template<typename Rect>
+    bool rectEmpty(const Rect& rc) {
+        return rc.right <= rc.left || rc.bottom <= rc.top;
+    }
+
+    template<typename Rect>
+    long long rectArea(const Rect& rc) {
+        return rectEmpty(rc) ? 0 : (long long)(rc.right - rc.left) * (rc.bottom - rc.top);
+    }
+
+    // 两个矩形的交集；不相交时out为空矩形并返回false
+    template<typename Rect>
+    bool intersectRect(Rect& out, const Rect& a, const Rect& b) {
+        Rect rc = a;
+        rc.left = (std::max)(a.left, b.left);
+        rc.top = (std::max)(a.top, b.top);
+        rc.right = (std::min)(a.right, b.right);
+        rc.bottom = (std::min)(a.bottom, b.bottom);
+        if (rectEmpty(rc)) {
+            out = Rect{};
+            return false;
+        }
+        out = rc;
+        return true;
+    }
+
+    // 包含两个矩形的最小矩形；其中一个为空时返回另一个
+    template<typename Rect>
+    Rect unionRect(const Rect& a, const Rect& b) {
+        if (rectEmpty(a)) return b;
+        if (rectEmpty(b)) return a;
+        Rect rc = a;
+        rc.left = (std::min)(a.left, b.left);
+        rc.top = (std::min)(a.top, b.top);
+        rc.right = (std::max)(a.right, b.right);
+        rc.bottom = (std::max)(a.bottom, b.bottom);
+        return rc;
+    }
+
+    // 待重绘区域：互不相交的若干矩形
+    // 与已有矩形相交的新矩形合并为外接矩形；矩形数量达到上限时，新矩形并入使面积增加最少的已有矩形。
+    // 许多图钉同时移动时只重绘和提交它们各自附近的区域，而不是所有变化的外接矩形。
+    template<typename Rect>
+    class DirtyRegion {
+    public:
+        explicit DirtyRegion(size_t maxRects = 64) : m_maxRects(maxRects) {}
+
+        void add(Rect rc) {
+            if (rectEmpty(rc)) return;
+            for (;;) {
+                // 合并所有相交的矩形，合并后的矩形可能与更多矩形相交
+                size_t n = 0;
+                while (n < m_rects.size()) {
+                    Rect overlap;
+                    if (intersectRect(overlap, m_rects[n], rc)) {
+                        rc = unionRect(rc, m_rects[n]);
+                        m_rects.erase(m_rects.begin() + n);
+                        n = 0;
+                    } else {
+                        ++n;
+                    }
+                }
+                if (m_rects.size() < m_maxRects) break;
+
+                size_t best = 0;
+                long long bestGrowth = -1;
+                for (size_t i = 0; i < m_rects.size(); ++i) {
+                    long long growth = rectArea(unionRect(m_rects[i], rc)) - rectArea(m_rects[i]);
+                    if (bestGrowth < 0 || growth < bestGrowth) {
+                        best = i;
+                        bestGrowth = growth;
+                    }
+                }
+                rc = unionRect(rc, m_rects[best]);
+                m_rects.erase(m_rects.begin() + best);
+            }
+            m_rects.push_back(rc);
+        }
+
+        void clear() { m_rects.clear(); }
+        bool empty() const { return m_rects.empty(); }
+        const std::vector<Rect>& rects() const { return m_rects; }
+
+    private:
+        size_t m_maxRects;
+        std::vector<Rect> m_rects;
+    };
+
+    // 预乘Alpha的 src over dst
+    inline uint32_t blendOver(uint32_t dst, uint32_t src) {
+        uint32_t a = src >> 24;
+        if (a == 255) return src;
+        if (a == 0) return dst;
+        uint32_t inv = 255 - a;
+        uint32_t rb = ((dst & 0x00FF00FF) * inv / 255) & 0x00FF00FF;
+        uint32_t ag = (((dst >> 8) & 0x00FF00FF) * inv / 255) & 0x00FF00FF;
+        return src + (rb | (ag << 8));
+    }
+
+    // 清除覆盖bounds的位图中的区域rc（rc位于bounds之内）
+    template<typename Rect>
+    void clearPixels(uint32_t* bits, const Rect& bounds, const Rect& rc) {
+        size_t width = size_t(bounds.right - bounds.left);
+        for (auto y = rc.top; y < rc.bottom; ++y) {
+            std::fill_n(bits + size_t(y - bounds.top) * width + (rc.left - bounds.left), rc.right - rc.left, 0u);
+        }
+    }
+
+    // 把覆盖sprite的图像中与clip相交的部分合成到覆盖bounds的位图（clip位于两者之内）
+    template<typename Rect>
+    void blendPixels(uint32_t* bits, const Rect& bounds, const uint32_t* image, const Rect& sprite, const Rect& clip) {
+        size_t width = size_t(bounds.right - bounds.left);
+        size_t imageWidth = size_t(sprite.right - sprite.left);
+        for (auto y = clip.top; y < clip.bottom; ++y) {
+            const uint32_t* src = image + size_t(y - sprite.top) * imageWidth + (clip.left - sprite.left);
+            uint32_t* dst = bits + size_t(y - bounds.top) * width + (clip.left - bounds.left);
+            for (auto x = 0; x < clip.right - clip.left; ++x) {
+                dst[x] = blendOver(dst[x], src[x]);
+            }
+        }
+    }
+
+    // 位图范围的选择规则
+    // 新位图覆盖精灵的外接矩形并在四周留出余量（区域宽高的1/marginDivisor，至少minMargin），
+    // 移动精灵时不必频繁重新分配；现有位图仍包含外接矩形且面积不超过新范围的shrinkRatio倍时保留。
+    struct SpriteBoundsRule {
+        int minMargin;
+        int marginDivisor;
+        long long shrinkRatio;
+
+        // needed为外接矩形（位于area之内），current为现有位图的范围，没有位图时为nullptr。
+        // 可以保留现有位图时返回false，否则返回true并在target中给出新位图的范围
+        template<typename Rect>
+        bool fit(const Rect& needed, const Rect& area, const Rect* current, Rect& target) const {
+            Rect inflated = needed;
+            auto dx = (std::max)(minMargin, int(area.right - area.left) / marginDivisor);
+            auto dy = (std::max)(minMargin, int(area.bottom - area.top) / marginDivisor);
+            inflated.left -= dx;
+            inflated.top -= dy;
+            inflated.right += dx;
+            inflated.bottom += dy;
+            intersectRect(target, inflated, area);
+
+            Rect covered;
+            if (current && intersectRect(covered, needed, *current) &&
+                covered.left == needed.left && covered.top == needed.top &&
+                covered.right == needed.right && covered.bottom == needed.bottom &&
+                rectArea(*current) <= rectArea(target) * shrinkRatio) {
+                return false;
+            }
+            return true;
+        }
+    };
+
+    // 按单元格的空间索引：单元格 -> 与其相交的精灵
+    // 只索引与area相交的部分，单元格以area左上角为原点。
+    template<typename Handle, typename Rect>
+    class SpriteGrid {
+    public:
+        // 设置索引覆盖的区域和单元格大小，并清空索引
+        void reset(const Rect& area, int cellSize) {
+            m_area = area;
+            m_cellSize = cellSize;
+            m_cells.clear();
+        }
+
+        void clear() { m_cells.clear(); }
+
+        void insert(Handle handle, const Rect& rc) {
+            Rect cells;
+            if (!cellRange(rc, cells)) return;
+            for (auto cy = cells.top; cy <= cells.bottom; ++cy) {
+                for (auto cx = cells.left; cx <= cells.right; ++cx) {
+                    m_cells[key(cx, cy)].push_back(handle);
+                }
+            }
+        }
+
+        // rc须与加入时相同
+        void remove(Handle handle, const Rect& rc) {
+            Rect cells;
+            if (!cellRange(rc, cells)) return;
+            for (auto cy = cells.top; cy <= cells.bottom; ++cy) {
+                for (auto cx = cells.left; cx <= cells.right; ++cx) {
+                    auto it = m_cells.find(key(cx, cy));
+                    if (it == m_cells.end()) continue;
+                    std::vector<Handle>& handles = it->second;
+                    handles.erase(std::remove(handles.begin(), handles.end(), handle), handles.end());
+                    if (handles.empty()) {
+                        m_cells.erase(it);
+                    }
+                }
+            }
+        }
+
+        // 与rc相交的单元格中的精灵，去重并排序后放入out
+        void query(const Rect& rc, std::vector<Handle>& out) const {
+            out.clear();
+            Rect cells;
+            if (!cellRange(rc, cells)) return;
+            for (auto cy = cells.top; cy <= cells.bottom; ++cy) {
+                for (auto cx = cells.left; cx <= cells.right; ++cx) {
+                    auto it = m_cells.find(key(cx, cy));
+                    if (it != m_cells.end()) {
+                        out.insert(out.end(), it->second.begin(), it->second.end());
+                    }
+                }
+            }
+            std::sort(out.begin(), out.end());
+            out.erase(std::unique(out.begin(), out.end()), out.end());
+        }
+
+        // 点所在单元格中的精灵；点不在区域内或单元格为空时返回nullptr
+        template<typename Coord>
+        const std::vector<Handle>* at(Coord x, Coord y) const {
+            if (x < m_area.left || x >= m_area.right || y < m_area.top || y >= m_area.bottom) {
+                return nullptr;
+            }
+            auto it = m_cells.find(key(int(x - m_area.left) / m_cellSize, int(y - m_area.top) / m_cellSize));
+            return it != m_cells.end() ? &it->second : nullptr;
+        }
+
+        // 非空单元格数量
+        size_t cellCount() const { return m_cells.size(); }
+
+    private:
+        // 与区域相交部分的单元格范围（含两端），不相交时返回false
+        bool cellRange(const Rect& rc, Rect& cells) const {
+            Rect clip;
+            if (!intersectRect(clip, rc, m_area)) {
+                return false;
+            }
+            cells = clip;
+            cells.left = (clip.left - m_area.left) / m_cellSize;
+            cells.top = (clip.top - m_area.top) / m_cellSize;
+            cells.right = (clip.right - 1 - m_area.left) / m_cellSize;
+            cells.bottom = (clip.bottom - 1 - m_area.top) / m_cellSize;
+            return true;
+        }
+
+        static uint32_t key(int cx, int cy) {
+            return (uint32_t(cy) << 16) | (uint32_t(cx) & 0xFFFF);
+        }
+
+        Rect m_area{};
+        int m_cellSize = 1;
+        std::unordered_map<uint32_t, std::vector<Handle>> m_cells;
+    };
+
+} // namespace Foundation
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace Foundation {
+
+    // 单生产者单消费者无锁环形队列
+    // 生产者只写 m_tail，消费者只写 m_head，两者位于不同缓存行，避免伪共享。
+    // Capacity 必须为2的幂。
+    template<typename T, size_t Capacity>
+    class SpscQueue {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity必须为2的幂");
+
+    public:
+        SpscQueue() = default;
+
+        // 禁止复制
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        // 生产者线程调用；队列已满时返回false
+        bool push(const T& item) {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) >= Capacity) {
+                return false;
+            }
+            m_items[tail & (Capacity - 1)] = item;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // 消费者线程调用；队列为空时返回false
+        bool pop(T& item) {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+            item = m_items[head & (Capacity - 1)];
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // 近似的元素数量（仅用于统计）
+        size_t size() const {
+            return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+        }
+
+    private:
+        alignas(64) std::atomic<size_t> m_head{0};
+        alignas(64) std::atomic<size_t> m_tail{0};
+        alignas(64) T m_items[Capacity];
+    };
+
+} // namespace Foundation
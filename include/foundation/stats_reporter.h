@@ -0,0 +1,35 @@
+#pragma once
+
+#include "core/common.h"
+#include <cstdint>
+
+namespace Foundation {
+
+    // 统计信息的定期输出
+    // 保存上次输出时的统计快照，每隔Constants::STATS_REPORT_INTERVAL毫秒调用一次
+    // format(当前统计, 上次输出时的统计, 经过的毫秒数)，由各模块格式化自己的日志。
+    // format返回false表示本次不算输出，快照和时间不更新，之后每次调用都会再试。
+    // 第一次调用只记录时间。不加锁；Tick为GetTickCount或GetTickCount64的返回类型。
+    template<typename Stats, typename Tick = uint32_t>
+    class StatsReporter {
+    public:
+        template<typename Format>
+        void update(Tick now, const Stats& stats, Format&& format) {
+            if (!m_lastTick) {
+                m_lastTick = now;
+                return;
+            }
+            Tick elapsed = now - m_lastTick;
+            if (elapsed < static_cast<Tick>(Constants::STATS_REPORT_INTERVAL)) return;
+            if (!format(stats, m_reported, elapsed)) return;
+
+            m_reported = stats;
+            m_lastTick = now;
+        }
+
+    private:
+        Tick m_lastTick = 0;
+        Stats m_reported{};
+    };
+
+} // namespace Foundation
@@ -25,5 +25,8 @@ namespace StringUtils {
     std::wstring utf8ToWide(const std::string& utf8Str);
     std::string wideToUtf8(const std::wstring& wideStr);
 
+    // 句柄的十六进制表示，例如0x1A2B3C
+    std::wstring handleToHex(const void* handle);
+
 } // namespace StringUtils
 } // namespace Foundation
\ No newline at end of file
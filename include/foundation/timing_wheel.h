@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Foundation {
+
+    // 周期性到期项的两级时间轮
+    // 第一级每格一个刻度，第二级每格一整圈第一级，共覆盖64×64个刻度；
+    // 更远的到期时刻放在第二级最远的一格，级联时重新计算。
+    // 重新调度和移除不查找旧记录，而是递增epoch使时间轮中的旧记录失效。
+    // 刻度的含义由调用者决定（例如毫秒数除以定时器精度），只要求单调不减。
+    // 不依赖任何平台接口。
+    class TimingWheel {
+    public:
+        static constexpr size_t WHEEL_BITS = 6;
+        static constexpr size_t WHEEL_SIZE = size_t(1) << WHEEL_BITS;
+
+        // 添加一项，每interval个刻度到期一次，第一次在now + interval；
+        // 返回的编号在项存在期间保持不变，移除后会被复用
+        unsigned add(uint64_t interval, uint64_t now);
+
+        // 以新的间隔从now重新开始计时
+        void reschedule(unsigned id, uint64_t interval, uint64_t now);
+
+        void remove(unsigned id);
+
+        bool contains(unsigned id) const { return id < m_entries.size() && m_entries[id].active; }
+        size_t size() const { return m_count; }
+        bool empty() const { return m_count == 0; }
+
+        // 推进到now，对每个到期项先安排下一个周期，再调用callback(id)。
+        // callback中可以添加、移除或重新调度任意项（包括自身），
+        // 本次到期但在调用前已被移除或重新调度的项不再调用；callback中不能再调用dispatch。
+        // 返回调用callback的次数
+        template<typename Callback>
+        size_t dispatch(uint64_t now, Callback&& callback) {
+            m_due.clear();
+            advance(now, m_due);
+
+            size_t dispatched = 0;
+            for (size_t n = 0; n < m_due.size(); ++n) {
+                const Slot slot = m_due[n];
+                if (!isCurrent(slot)) {
+                    continue;
+                }
+                Entry& e = m_entries[slot.index];
+                e.deadline = now + e.interval;
+                ++e.epoch;
+                insert(slot.index);
+
+                callback(slot.index);
+                ++dispatched;
+            }
+            return dispatched;
+        }
+
+        // 下一次需要调用dispatch的刻度（可能因失效的记录而提前，不会推迟）；没有项时返回0
+        uint64_t nextDeadline() const;
+
+    private:
+        // 项保存在连续数组中，空闲位置复用
+        struct Entry {
+            uint64_t interval;
+            uint64_t deadline;
+            unsigned epoch;         // 每次重新调度时递增，使时间轮中的旧记录失效
+            bool active;
+        };
+
+        // 时间轮中的一条记录
+        struct Slot {
+            unsigned index;
+            unsigned epoch;
+        };
+
+        static constexpr size_t WHEEL_MASK = WHEEL_SIZE - 1;
+
+        // 把项放入对应的时间轮格子
+        void insert(unsigned index);
+
+        // 推进到指定刻度，收集到期的项
+        void advance(uint64_t target, std::vector<Slot>& due);
+
+        bool isCurrent(const Slot& slot) const {
+            const Entry& e = m_entries[slot.index];
+            return e.active && e.epoch == slot.epoch;
+        }
+
+        std::vector<Entry> m_entries;
+        std::vector<unsigned> m_free;
+        size_t m_count = 0;
+
+        std::vector<Slot> m_wheel[2][WHEEL_SIZE];
+        uint64_t m_current = 0;         // 已处理到的刻度
+        std::vector<Slot> m_due;        // 本次到期的项（复用以避免分配）
+    };
+
+} // namespace Foundation
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Foundation {
+namespace Utf {
+    // UTF-8与宽字符串（wchar_t为2字节时是UTF-16，为4字节时是UTF-32）之间的转换
+    // 一次遍历直接写入调用者提供的缓冲区，不需要先查询长度；
+    // 连续的ASCII字符按块处理（x86/x64使用SSE2，其余平台按机器字处理）。
+    // 非法输入不会失败：无效的UTF-8序列（按最长有效前缀计）和孤立的代理项都替换为U+FFFD，
+    // 与MultiByteToWideChar/WideCharToMultiByte的行为一致。
+    // 不依赖任何平台接口。
+
+    // 替换字符
+    constexpr char32_t REPLACEMENT_CHAR = 0xFFFD;
+
+    // 转换length个字节所需的最大宽字符数
+    inline size_t maxWideLength(size_t utf8Length) { return utf8Length; }
+
+    // 转换length个宽字符所需的最大字节数（UTF-16的代理对是2个单元4个字节，单个单元最多3个字节）
+    inline size_t maxUtf8Length(size_t wideLength) { return wideLength * (sizeof(wchar_t) == 2 ? 3 : 4); }
+
+    // 转换到dst，返回写入的宽字符数；dst至少需要maxWideLength(length)个元素，不写入结尾的0
+    size_t utf8ToWide(const char* src, size_t length, wchar_t* dst);
+
+    // 转换到dst，返回写入的字节数；dst至少需要maxUtf8Length(length)个元素，不写入结尾的0
+    size_t wideToUtf8(const wchar_t* src, size_t length, char* dst);
+
+    // 转换后追加到字符串末尾
+    void appendWide(std::wstring& out, const char* src, size_t length);
+    void appendUtf8(std::string& out, const wchar_t* src, size_t length);
+
+} // namespace Utf
+} // namespace Foundation
@@ -10,6 +10,9 @@ namespace DpiManager {
     // 获取窗口DPI
     int getDpiForWindow(HWND hwnd);
     
+    // 获取显示器DPI（不支持时返回系统DPI）
+    int getDpiForMonitor(HMONITOR monitor);
+    
     // 获取系统DPI
     int getSystemDpi();
     
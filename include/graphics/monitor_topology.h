@@ -0,0 +1,53 @@
+#pragma once
+
+#include "core/common.h"
+#include "foundation/monitor_layout.h"
+
+namespace Graphics {
+
+    // 显示器拓扑缓存
+    // 缓存所有显示器的矩形、工作区和DPI，供图钉定位时查询，
+    // 避免每次定位都调用SystemParametersInfo/GetMonitorInfo。
+    // 主窗口收到WM_DISPLAYCHANGE、WM_SETTINGCHANGE(SPI_SETWORKAREA)、WM_DPICHANGED时调用invalidate，
+    // 下一次查询时重新枚举。查找本身由Foundation::MonitorLayout完成。
+    // 仅在UI线程使用。
+    class MonitorTopology {
+    public:
+        // 获取单例实例
+        static MonitorTopology& getInstance();
+
+        // 标记缓存失效
+        void invalidate() { m_valid = false; }
+
+        // 返回与矩形相交面积最大的显示器；没有显示器时返回nullptr
+        HMONITOR monitorFromRect(const RECT& rc);
+
+        // 获取矩形所在显示器的工作区，失败时返回false
+        bool workAreaFromRect(const RECT& rc, RECT& workArea);
+
+        // 获取矩形所在显示器的DPI
+        int dpiFromRect(const RECT& rc);
+
+        size_t monitorCount();
+
+    private:
+        MonitorTopology() = default;
+        ~MonitorTopology() = default;
+
+        // 禁止复制和移动
+        MonitorTopology(const MonitorTopology&) = delete;
+        MonitorTopology& operator=(const MonitorTopology&) = delete;
+
+        // 需要时重新枚举显示器
+        void ensureValid();
+
+        // 查询矩形所在的显示器，返回nullptr表示没有显示器
+        const Foundation::MonitorLayout::Monitor* find(const RECT& rc);
+
+        static BOOL CALLBACK enumMonitorProc(HMONITOR monitor, HDC dc, LPRECT rect, LPARAM param);
+
+        Foundation::MonitorLayout m_layout;
+        bool m_valid = false;
+    };
+
+} // namespace Graphics
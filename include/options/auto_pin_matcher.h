@@ -0,0 +1,49 @@
+#pragma once
+
+#include "foundation/regex_set.h"
+#include "foundation/stats_reporter.h"
+#include "window/class_registry.h"
+#include <vector>
+
+struct AutoPinRule;
+
+
+// 自动图钉规则的匹配器。
+// 通配符规则逐条匹配，类名模式不含通配符的规则先按类ID预筛选；
+// 正则规则在加载时编译，所有标题模式合并为一个自动机、所有类名模式合并为另一个，每个窗口的标题和类名各扫描一次即可得到全部正则规则的结果。
+// 无效的正则规则记录警告后永不匹配。
+// 只在主线程使用。
+//
+class AutoPinMatcher {
+public:
+    // 编译规则，返回无效的正则规则数
+    size_t compile(const std::vector<AutoPinRule>& rules);
+
+    // 窗口是否匹配任一启用的规则
+    bool match(HWND wnd) const;
+
+    // 窗口的类名是否符合任一启用的规则（不检查标题）
+    // 类名不变，不符合的窗口无论标题怎样变化都不会匹配
+    bool matchClass(HWND wnd) const;
+
+private:
+    struct RegexRule {
+        size_t title;   // m_titles中的模式序号
+        size_t cls;     // m_classes中的模式序号
+    };
+
+    void reportStats() const;
+
+    std::vector<AutoPinRule> m_globRules;
+    // 与m_globRules对应：类名模式不含通配符时为其类ID，编译时驻留；否则为CLASS_UNKNOWN
+    std::vector<Window::ClassId> m_globClasses;
+    std::vector<RegexRule> m_regexRules;
+
+    // 匹配时按需构造DFA状态，因此为mutable
+    mutable Foundation::RegexSet m_titles;
+    mutable Foundation::RegexSet m_classes;
+    mutable std::vector<uint64_t> m_titleHits;
+    mutable std::vector<uint64_t> m_classHits;
+
+    mutable Foundation::StatsReporter<size_t> m_statsReporter;    // 统计类名模式的匹配次数
+};
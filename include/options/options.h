@@ -1,6 +1,7 @@
 #pragma once
 
 #include "foundation/error_handler.h"
+#include "options/auto_pin_matcher.h"
 #include "resource.h"
 #include "system/language_manager.h"
 
@@ -63,12 +64,15 @@ struct AutoPinRule {
     std::wstring ttl;
     std::wstring cls;
     bool enabled;
+    bool regex;     // ttl和cls是正则表达式而不是通配符
 
     AutoPinRule(const std::wstring& d = L"New Rule", 
         const std::wstring& t = L"", 
         const std::wstring& c = L"", 
-        bool b = true) : descr(d), ttl(t), cls(c), enabled(b) {}
+        bool b = true,
+        bool r = false) : descr(d), ttl(t), cls(c), enabled(b), regex(r) {}
 
+    // 按通配符匹配；正则规则由AutoPinMatcher统一匹配
     bool match(HWND wnd) const;
 
     bool load(HKEY key, int i);
@@ -203,6 +207,11 @@ public:
     // pins
     std::wstring  pinImagePath;  // 图钉图像文件路径（相对于程序目录）
     IntOption     trackRate;
+    bool          adaptiveTracking;  // 目标窗口静止时降低跟踪频率
+    IntOption     idleTrackRate;     // 静止时的跟踪间隔（自适应跟踪的上限）
+    bool          frameSync;         // 按DWM合成帧定位图钉
+    bool          predictMotion;     // 拖动时预测图钉位置
+    bool          overlayPins;       // 每个显示器用一个覆盖层绘制所有图钉
     bool          dblClkTray;
     bool          runOnStartup;
     bool          bindWindows;   // 绑定置顶窗口功能状态
@@ -213,7 +222,9 @@ public:
     // autopin
     bool          autoPinOn;
     AutoPinRules  autoPinRules;
+    AutoPinMatcher autoPinMatcher;   // 由autoPinRules编译，规则改变后需重新编译
     IntOption     autoPinDelay;
+    bool          autoPinTitleWatch; // 未匹配的窗口标题变化时重新检查
     // lang
     std::wstring  language;   // language code like "zh_CN", "en_US", empty means auto-detect
 
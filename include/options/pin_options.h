@@ -13,7 +13,7 @@ protected:
     static void apply(HWND wnd);
 
     static void updatePinWnds();
-    static BOOL CALLBACK resetPinTimersEnumProc(HWND wnd, LPARAM param);
+    static void resetPinTimers(int rate);
     
     static bool selectIconFile(HWND wnd);
     static bool resetToDefault(HWND wnd);
@@ -1,24 +1,37 @@
 #pragma once
 
+#include "window/window_strings.h"
+#include "window/class_registry.h"
+#include "foundation/stats_reporter.h"
+
 class Options;
 
 // 创建窗口的自动图钉检查。
 // 记住每个窗口添加的时间，因此在检查时
 // 只处理那些已经通过自动图钉延迟的窗口。
+// 可选：类名符合规则但标题不符合的窗口在一段时间内继续监视标题变化，
+// 标题变为符合规则时立即创建图钉（例如浏览器窗口的标题从"新标签页"变为实际页面）。
 //
 class PendingWindows {
 public:
     void add(HWND wnd);
     void check(HWND wnd, const Options& opt);
 
+    // 被监视窗口的标题发生了变化
+    void titleChanged(HWND target, HWND wnd, const Options& opt);
+
+    // 停止监视所有窗口并释放钩子
+    void unwatchAll();
+
 protected:
     struct Entry {
         HWND wnd;
-        std::wstring title;
-        std::wstring className;
+        Window::WindowText title;
+        Window::ClassId classId;
         ULONGLONG time;
-        Entry(HWND h = 0, const std::wstring& t = L"", const std::wstring& c = L"", ULONGLONG tm = 0) 
-            : wnd(h), title(t), className(c), time(tm) {}
+        Entry(HWND h = 0, const Window::WindowText& t = Window::WindowText(),
+              Window::ClassId c = Window::ClassRegistry::CLASS_UNKNOWN, ULONGLONG tm = 0) 
+            : wnd(h), title(t), classId(c), time(tm) {}
     };
     std::vector<Entry> m_wnds;
 
@@ -29,6 +42,37 @@ protected:
     };
     std::vector<BlacklistEntry> m_blacklist;
 
+    struct WatchEntry {
+        HWND wnd;
+        DWORD processId;
+        ULONGLONG since;        // 开始监视的时间
+        ULONGLONG lastCheck;    // 上次检查的时间
+        bool dirty;             // 检查间隔内标题又发生了变化，尚未检查
+    };
+    std::vector<WatchEntry> m_watched;
+
+    // 统计信息
+    struct Stats {
+        size_t watched;         // 开始监视的窗口数
+        size_t events;          // 被监视窗口的标题变化次数
+        size_t rechecks;        // 重新检查的次数
+        size_t pinned;          // 重新检查后创建图钉的窗口数
+    };
+    Stats m_stats = {};
+    Foundation::StatsReporter<Stats, ULONGLONG> m_statsReporter;
+
+    // 检查黑名单和错误对话框后批量创建图钉
+    void pinTargets(HWND wnd, std::vector<HWND>& targets, const Options& opt);
+
+    void watch(HWND target);
+    void unwatch(size_t index);
+    void recheck(size_t index, HWND wnd, const Options& opt);
+    void checkWatched(HWND wnd, const Options& opt);
+    void reportStats();
+
+    static void CALLBACK titleEventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd,
+                                        LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime);
+
     bool timeToChkWnd(ULONGLONG t, const Options& opt);
     bool checkWnd(HWND target, const Options& opt);
     bool isErrorDialog(HWND wnd);
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "core/common.h"
+#include "foundation/stats_reporter.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Pin {
+
+    // 帧同步定位（可选）
+    // 后台线程通过DwmFlush等待每次DWM合成，有待更新的图钉时每帧唤醒UI线程一次，
+    // 由UI线程批量更新所有待更新图钉的位置并一次提交。
+    // 没有待更新的图钉时线程挂起，不产生任何唤醒。
+    class FrameSync {
+    public:
+        // 图钉在帧上的处理函数，返回图钉位置是否发生了变化
+        using FrameHandler = bool (*)(HWND wnd);
+
+        // 统计信息
+        struct Stats {
+            size_t frames;        // 处理的帧数
+            size_t skipped;       // 没有任何图钉移动的帧数
+            size_t dropped;       // UI线程来不及处理而错过的帧数
+            size_t moves;         // 图钉移动次数
+            size_t lagFrames;     // 从目标移动到图钉跟上的累计帧数
+            size_t lagSamples;
+            LONGLONG cpuMicros;   // UI线程处理帧的累计耗时
+        };
+
+        // 获取单例实例
+        static FrameSync& getInstance();
+
+        // 启动帧线程；每帧向notifyWnd发送notifyMsg。DwmFlush不可用时返回false
+        bool start(HWND notifyWnd, UINT notifyMsg);
+
+        // 停止帧线程
+        void stop();
+
+        bool isRunning() const { return m_thread.joinable(); }
+
+        // 标记图钉需要在接下来的帧上更新位置
+        void markDirty(HWND wnd, FrameHandler handler);
+
+        // 移除图钉（图钉销毁时调用）
+        void remove(HWND wnd);
+
+        // UI线程：处理一帧
+        void onFrame();
+
+        Stats getStats() const { return m_stats; }
+
+    private:
+        FrameSync() = default;
+        ~FrameSync();
+
+        // 禁止复制和移动
+        FrameSync(const FrameSync&) = delete;
+        FrameSync& operator=(const FrameSync&) = delete;
+
+        void threadProc();
+        void reportStats();
+
+        // 待更新的图钉
+        struct Item {
+            HWND wnd;
+            FrameHandler handler;
+            size_t markedFrame;     // 被标记时的帧序号，用于统计延迟
+            bool measured;          // 本次标记的延迟是否已统计
+            int idleFrames;         // 连续未移动的帧数
+        };
+
+        std::thread m_thread;
+        HANDLE m_activeEvent = nullptr;     // 有待更新图钉时置位
+        std::atomic<bool> m_stop{false};
+        std::atomic<bool> m_framePosted{false};
+        std::atomic<size_t> m_frame{0};     // 帧线程观察到的合成帧序号
+        HWND m_notifyWnd = nullptr;
+        UINT m_notifyMsg = 0;
+
+        // 仅UI线程访问
+        std::vector<Item> m_dirty;
+        size_t m_lastFrame = 0;
+        LONGLONG m_qpcFrequency = 0;
+
+        Stats m_stats = {};
+        Foundation::StatsReporter<Stats> m_statsReporter;
+    };
+
+} // namespace Pin
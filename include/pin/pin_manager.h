@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/common.h"
+#include <vector>
 
 namespace Pin {
 
@@ -8,6 +9,24 @@ namespace Pin {
     // 负责图钉的创建、检查和切换操作
     class PinManager {
     public:
+        // 批量操作作用域
+        // 作用域内创建的图钉暂不显示，位置/层级调整与绑定列表更新推迟到最外层作用域结束时，
+        // 通过一次层级提交和一次绑定更新统一完成。
+        class BatchScope {
+        public:
+            BatchScope();
+            ~BatchScope();
+            BatchScope(const BatchScope&) = delete;
+            BatchScope& operator=(const BatchScope&) = delete;
+        };
+
+        // 是否处于批量操作中
+        static bool inBatch() { return s_batchDepth > 0; }
+
+        // 批量操作中创建的图钉，在批量结束时显示
+        static void deferShow(HWND pin) { s_deferredPins.push_back(pin); }
+
+
         // 为指定窗口创建图钉
         // wnd: 图钉窗口句柄
         // targetWnd: 目标窗口句柄
@@ -28,10 +47,22 @@ namespace Pin {
         // 返回: 成功返回true，失败返回false
         static bool togglePin(HWND wnd, HWND targetWnd, int trackRate);
         
+        // 批量为多个窗口创建图钉，不显示逐个的错误提示
+        // 返回: 成功创建的图钉数量
+        static int pinWindows(HWND wnd, const std::vector<HWND>& targetWnds, int trackRate);
+        
+        // 批量移除所有图钉
+        // 返回: 移除的图钉数量
+        static int unpinAll();
+        
         // 恢复所有被图钉置顶的窗口状态
         // 在应用程序退出时调用，将所有被置顶的窗口恢复为非置顶状态
         // 返回: 恢复的窗口数量
         static int restoreAllPinnedWindows();
+
+    private:
+        static int s_batchDepth;
+        static std::vector<HWND> s_deferredPins;
     };
 
 } // namespace Pin
\ No newline at end of file
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "core/common.h"
+#include "foundation/sprite_layout.h"
+#include "foundation/stats_reporter.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Pin {
+
+    // 图钉覆盖层
+    // 可选的绘制方式：每个显示器只创建一个透明的分层窗口，把该显示器上的所有图钉
+    // 合成到同一块预乘Alpha的位图中，通过UpdateLayeredWindowIndirect只提交变化的区域。
+    // 位图只覆盖图钉的外接矩形（留有余量），图钉移出该范围时才重新分配。
+    // 图钉窗口（PinWnd）仍保存跟踪状态但保持隐藏，位置和可见性由它们转交给本类。
+    // 覆盖层中Alpha为0的像素不接收鼠标，点击图钉图像时通过网格索引找到对应的图钉并移除。
+    // 仅在UI线程使用。
+    class PinOverlay {
+    public:
+        // 统计信息
+        struct Stats {
+            size_t commits;         // 有变化的提交次数
+            size_t updates;         // UpdateLayeredWindowIndirect调用次数
+            ULONGLONG dirtyPixels;  // 重绘的像素总数
+            size_t surfaces;        // 当前覆盖层（显示器）数量
+            size_t surfaceBytes;    // 当前覆盖层位图占用的内存
+        };
+
+        // 获取单例实例
+        static PinOverlay& getInstance();
+
+        // 注册覆盖层窗口类
+        static ATOM registerClass();
+        static LPCWSTR className;
+
+        // 启用或禁用覆盖层绘制（创建图钉之前调用）
+        void setEnabled(bool enabled);
+        bool isEnabled() const { return m_enabled; }
+
+        // 设置图钉左上角的屏幕位置
+        void setPosition(HWND pin, int x, int y);
+
+        // 显示或隐藏图钉
+        void setVisible(HWND pin, bool visible);
+        bool isVisible(HWND pin) const;
+
+        // 移除图钉（图钉窗口销毁时调用）
+        void remove(HWND pin);
+
+        // 图钉图像改变（DPI或图像更新）后重建图像并重绘所有覆盖层
+        void invalidateImage();
+
+        // 显示器配置改变后重建所有覆盖层
+        void resetSurfaces();
+
+        // 把覆盖层重新置于所有置顶窗口之前（被钉住的窗口激活后调用）
+        void raise();
+
+        // 重绘有变化的区域（在层级管理器提交时调用）
+        void commit();
+
+        // 返回屏幕坐标处的图钉
+        HWND hitTest(POINT pt) const;
+
+        Stats getStats() const;
+
+    private:
+        PinOverlay() = default;
+        ~PinOverlay();
+
+        // 禁止复制和移动
+        PinOverlay(const PinOverlay&) = delete;
+        PinOverlay& operator=(const PinOverlay&) = delete;
+
+        struct Surface;
+
+        struct Item {
+            POINT pos = {};
+            bool visible = false;
+            bool dirty = false;             // 已加入m_dirtyItems
+            RECT drawn = {};                // 已绘制到覆盖层上的矩形（屏幕坐标）
+            Surface* surface = nullptr;     // 所在的覆盖层
+        };
+
+        // 每个显示器一个覆盖层
+        struct Surface {
+            HMONITOR monitor = nullptr;
+            RECT area = {};                 // 显示器矩形（屏幕坐标），网格索引以其左上角为原点
+            RECT bounds = {};               // 位图和覆盖层窗口的矩形（屏幕坐标），位于area之内
+            HWND wnd = nullptr;
+            HDC dc = nullptr;
+            HBITMAP bmp = nullptr;
+            HGDIOBJ oldBmp = nullptr;
+            UINT32* bits = nullptr;         // 自上而下的32位预乘Alpha像素
+            Foundation::DirtyRegion<RECT> dirty; // 待提交区域（屏幕坐标），最多64个互不相交的矩形
+            bool shown = false;
+            bool resized = false;           // 位图已重新分配，下次提交整个位图
+            size_t items = 0;
+            // 网格索引：单元格 -> 与其相交的图钉
+            Foundation::SpriteGrid<HWND, RECT> grid;
+        };
+
+        // 标记图钉需要重新放置，并确保主窗口会调用commit
+        void markDirty(HWND pin, Item& item);
+        void requestCommit();
+
+        // 获取显示器的覆盖层，不存在时创建
+        Surface* surfaceFor(HMONITOR monitor);
+        void destroySurface(Surface& surface);
+
+        // 使覆盖层位图覆盖其上所有图钉，需要时重新分配；失败时返回false
+        bool fitSurface(Surface& surface);
+
+        // 把屏幕矩形加入覆盖层的待提交区域
+        static void addDirty(Surface& surface, const RECT& rc);
+
+        // 重绘并提交覆盖层的待提交区域
+        void redraw(Surface& surface);
+
+        // 从当前图钉图像生成预乘Alpha图像
+        bool buildImage();
+
+        static LRESULT CALLBACK proc(HWND wnd, UINT msg, WPARAM wparam, LPARAM lparam);
+
+        void reportStats();
+
+        bool m_enabled = false;
+        bool m_pending = false;             // 已请求提交
+        bool m_raise = false;
+        std::unordered_map<HWND, Item> m_items;
+        std::vector<HWND> m_dirtyItems;     // 位置或可见性改变的图钉
+        std::vector<std::unique_ptr<Surface>> m_surfaces;
+
+        // 预乘Alpha的图钉图像
+        std::vector<UINT32> m_image;
+        int m_imageW = 0;
+        int m_imageH = 0;
+        bool m_imageValid = false;
+
+        Stats m_stats = {};
+        Foundation::StatsReporter<Stats> m_statsReporter;
+    };
+
+} // namespace Pin
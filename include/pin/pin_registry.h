@@ -0,0 +1,47 @@
+#pragma once
+
+#include "core/common.h"
+#include <vector>
+#include <unordered_map>
+
+namespace Pin {
+
+    // 图钉注册表
+    // 在进程内维护 图钉→目标 与 目标→图钉 的映射，
+    // 替代通过 FindWindowEx 枚举所有顶级窗口再逐个 SendMessage 的查找方式。
+    // 由图钉窗口在绑定目标成功和销毁时同步更新，仅在UI线程使用。
+    class PinRegistry {
+    private:
+        static std::unordered_map<HWND, HWND> s_pinToTarget;   // 图钉 → 目标窗口
+        static std::unordered_map<HWND, HWND> s_targetToPin;   // 目标窗口 → 图钉
+
+    public:
+        // 注册图钉与目标窗口的关联
+        static void add(HWND pin, HWND target);
+
+        // 注销图钉
+        static void remove(HWND pin);
+
+        // 获取目标窗口对应的图钉，不存在时返回nullptr
+        static HWND findPin(HWND target);
+
+        // 获取图钉对应的目标窗口，不存在时返回nullptr
+        static HWND getTarget(HWND pin);
+
+        // 检查窗口是否为已注册的图钉
+        static bool isPin(HWND wnd) { return s_pinToTarget.count(wnd) != 0; }
+
+        // 已注册的图钉数量
+        static size_t count() { return s_pinToTarget.size(); }
+
+        // 所有图钉的快照（可在遍历时安全地销毁图钉）
+        static std::vector<HWND> pins();
+
+        // 所有目标窗口的快照
+        static std::vector<HWND> targets();
+
+        // 调试检查：与窗口枚举的结果比对，不一致时记录日志并返回false
+        static bool verify();
+    };
+
+} // namespace Pin
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "foundation/adaptive_interval.h"
+#include "foundation/motion_predictor.h"
 
 // 图钉形状的小弹出窗口。
 // 完全负责使目标窗口保持在最前面。
@@ -10,6 +12,17 @@ public:
     static LRESULT CALLBACK proc(HWND wnd, UINT msg, WPARAM wparam, LPARAM lparam);
     static LPCWSTR className;
 
+    // 代理窗口查找统计
+    struct ProxyStats {
+        size_t searches;            // 实际执行的查找次数
+        size_t failures;            // 未找到代理窗口的次数
+        size_t skipped;             // 因退避而跳过的次数
+        size_t childEnumerations;   // EnumChildWindows调用次数
+    };
+
+    // 获取图钉的代理窗口查找统计，图钉无效时返回false
+    static bool getProxyStats(HWND pin, ProxyStats& stats);
+
 protected:
     // 窗口数据对象。
     //
@@ -50,17 +63,54 @@ protected:
             return proxyMode ? proxyWnd : topMostWnd;
         }
 
+        // 每个图钉自己的跟踪状态，定时器中直接访问，无需查找或分配。
+        // 随图钉窗口一起销毁，长时间运行也不会增长。
+        struct TrackState {
+            DWORD lastTopStyleCheck = 0;    // 上次检查层级样式的时刻
+            bool lastMinimized = false;     // 目标窗口上次是否处于最小化状态
+            bool modernApp = false;         // 目标是否为现代Windows应用（绑定时确定）
+            bool hasPlacedPos = false;      // lastPlacedPos是否有效
+            POINT lastPlacedPos = {};       // 上次请求的图钉位置
+
+            // 自适应跟踪：目标静止时逐步放慢定时器，检测到变化时立即恢复
+            Foundation::AdaptiveInterval rate;  // 快速间隔为用户设置的跟踪间隔
+            RECT lastTargetRect = {};       // 上次检查时目标窗口的位置
+            bool lastVisible = false;       // 上次检查时目标是否可见
+            bool lastForeground = false;    // 上次检查时目标是否为前台窗口
+            DWORD hookProcessId = 0;        // 已订阅事件的目标进程，0表示未订阅
+            DWORD graphThreadId = 0;        // 代理模式下在所有关系图中跟踪的目标线程
+
+            // 代理窗口查找失败后按指数退避重试，目标线程有新窗口出现或显示时立即重试
+            DWORD proxyBackoff = 0;         // 当前退避间隔，0表示上次查找成功或尚未查找
+            DWORD proxyRetryTick = 0;       // 允许再次查找的时刻
+            size_t proxyGeneration = 0;     // 上次失败时目标线程的事件计数
+            ProxyStats proxyStats = {};
+
+            // 拖动时预测目标在下一帧的位置
+            Foundation::MotionPredictor predictor;
+        } track;
+
     private:
         Data(HWND wnd) : callbackWnd(wnd), proxyMode(false), topMostWnd(0), proxyWnd(0) {}
     };
 
-    static BOOL CALLBACK enumThreadWndProc(HWND wnd, LPARAM param);
+    static void assignProxy(HWND pin, Data& pd, HWND proxy);
     static BOOL CALLBACK enumChildWndProc(HWND wnd, LPARAM param);
-    static bool selectProxy(HWND wnd, const Data& pd);
+    static bool selectProxy(HWND wnd, Data& pd);
+    static bool trySelectProxy(HWND wnd, Data& pd, DWORD now);
     static void fixTopStyle(HWND wnd, const Data& pd);
-    static void placeOnCaption(HWND wnd, const Data& pd);
+    static void placeOnCaption(HWND wnd, Data& pd);
     static bool fixVisible(HWND wnd, const Data& pd);
+    static bool isPinShown(HWND wnd);
     static void fixPopupZOrder(HWND appWnd);
+    static void setTrackRate(HWND wnd, int rate);
+    static void trackTick(HWND wnd);
+    static bool syncToFrame(HWND wnd);
+    static void updateTrackRate(HWND wnd, Data& pd, HWND targetWnd, DWORD now);
+    static void subscribeTarget(Data& pd);
+    static void unsubscribeTarget(Data& pd);
+    static void CALLBACK targetEventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd,
+                                         LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime);
 
     static LRESULT evCreate(HWND wnd, Data& pd);
     static void evDestroy(HWND wnd, Data& pd);
@@ -71,4 +121,5 @@ protected:
     static bool evPinAssignWnd(HWND wnd, Data& pd, HWND target, int pollRate);
     static HWND evGetPinnedWnd(HWND wnd, Data& pd);
     static void evPinResetTimer(HWND wnd, Data& pd, int pollRate);
+    static void evPinWake(HWND wnd, Data& pd);
 };
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "core/common.h"
+#include "foundation/timing_wheel.h"
+#include "foundation/stats_reporter.h"
+#include <vector>
+#include <unordered_map>
+
+namespace Pin {
+
+    // 图钉跟踪调度器
+    // 所有图钉共用主窗口上的一个定时器，由两级时间轮（Foundation::TimingWheel）保存各图钉的下次跟踪时刻，
+    // 每次唤醒只处理到期的图钉，并把它们的位置/层级调整合并为一次提交。
+    // 定时器只在最近的到期时刻唤醒，没有到期图钉时不会空转。
+    // 仅在UI线程使用。
+    class TrackScheduler {
+    public:
+        // 图钉到期时调用的处理函数
+        using TickHandler = void (*)(HWND wnd);
+
+        // 统计信息
+        struct Stats {
+            size_t wakeups;       // 定时器唤醒次数
+            size_t dispatched;    // 调用处理函数的次数
+            size_t batches;       // 处理了多个图钉的唤醒次数
+        };
+
+        // 获取单例实例
+        static TrackScheduler& getInstance();
+
+        // 设置承载定时器的窗口（主窗口）
+        void setNotifyWindow(HWND wnd);
+
+        // 以指定间隔周期性调用处理函数，第一次在interval毫秒后；
+        // 已调度的窗口会以新间隔重新开始计时
+        void schedule(HWND wnd, int interval, TickHandler handler);
+
+        // 取消窗口的调度
+        void cancel(HWND wnd);
+
+        // 主窗口收到定时器消息时调用
+        void onTimer();
+
+        size_t count() const { return m_index.size(); }
+
+        Stats getStats() const { return m_stats; }
+
+    private:
+        TrackScheduler() = default;
+        ~TrackScheduler() = default;
+
+        // 禁止复制和移动
+        TrackScheduler(const TrackScheduler&) = delete;
+        TrackScheduler& operator=(const TrackScheduler&) = delete;
+
+        // 时间轮的刻度（毫秒）
+        static constexpr ULONGLONG GRANULARITY = Constants::MIN_TRACK_RATE;
+
+        // 时间轮中的一项对应的图钉，按时间轮的编号保存
+        struct Target {
+            HWND wnd;
+            TickHandler handler;
+        };
+
+        static ULONGLONG nowTicks();
+
+        // 按时间轮中最近的到期时刻重新设置定时器
+        void rearm();
+
+        void reportStats();
+
+        HWND m_notifyWnd = nullptr;
+        bool m_armed = false;           // 定时器是否已设置
+        bool m_dispatching = false;     // 正在调用处理函数，结束后统一重新设置定时器
+
+        Foundation::TimingWheel m_wheel;
+        std::vector<Target> m_targets;
+        std::unordered_map<HWND, unsigned> m_index;
+
+        Stats m_stats = {};
+        Foundation::StatsReporter<Stats> m_statsReporter;
+    };
+
+} // namespace Pin
@@ -1,8 +1,8 @@
 #pragma once
 
 #include "core/common.h"
+#include "foundation/bound_window_set.h"
 #include <vector>
-#include <unordered_set>
 #include <unordered_map>
 
 namespace Pin {
@@ -13,10 +13,11 @@ namespace Pin {
     class WindowBindingManager {
     private:
         static bool s_bindingEnabled;                           // 绑定功能是否启用
-        static std::unordered_set<HWND> s_boundWindows;        // 已绑定的窗口集合
-        static HWINEVENTHOOK s_minimizeEventHook;              // 窗口最小化事件钩子
-        static HWINEVENTHOOK s_moveEventHook;                  // 窗口移动事件钩子
-        static std::unordered_map<HWND, POINT> s_windowPositions; // 存储窗口位置，用于计算相对位置
+        static Foundation::BoundWindowSet<HWND, POINT> s_bound; // 已绑定的窗口集合及其已提交/目标位置
+        static bool s_initialized;                              // 是否已初始化
+        static std::unordered_map<HWND, DWORD> s_windowProcesses;  // 绑定窗口 → 所属进程（用于释放钩子引用）
+        static int s_deferDepth;                                // 推迟更新的嵌套深度
+        static std::unordered_map<HWND, bool> s_deferred;       // 推迟期间的变更：窗口 → 是否添加
         
         // 窗口事件回调函数 - 最小化/恢复事件
         static void CALLBACK MinimizeEventProc(HWINEVENTHOOK hWinEventHook, DWORD event, 
@@ -31,6 +32,9 @@ namespace Pin {
         // 获取所有已置顶的窗口
         static std::vector<HWND> getAllPinnedWindows();
         
+        // 查询可见、未最小化窗口的位置，用于位置缓存
+        static bool locateWindow(HWND hwnd, POINT& position);
+        
         // 最小化所有绑定的窗口（除了触发窗口）
         static void minimizeAllBoundWindows(HWND excludeWindow);
         
@@ -40,6 +44,11 @@ namespace Pin {
         // 移动所有绑定的窗口（除了触发窗口）
         static void moveAllBoundWindows(HWND movedWindow, int deltaX, int deltaY);
         
+        // 为窗口所属进程增加/减少最小化和位置变化钩子的引用
+        static void acquireHooks(HWND hwnd);
+        static void releaseHooks(HWND hwnd);
+        static void releaseAllHooks();
+        
     public:
         // 初始化窗口绑定管理器
         static bool initialize();
@@ -53,9 +62,20 @@ namespace Pin {
         // 获取绑定功能是否启用
         static bool isBindingEnabled() { return s_bindingEnabled; }
         
-        // 更新绑定的窗口列表（当有新图钉创建或删除时调用）
+        // 从图钉注册表完整重建绑定窗口列表和位置缓存
+        // 仅在初始化、启用绑定或需要恢复一致性时调用
         static void updateBoundWindows();
         
+        // 增量更新：新图钉绑定了目标窗口
+        static void addBoundWindow(HWND hwnd);
+        
+        // 增量更新：目标窗口的图钉已移除
+        static void removeBoundWindow(HWND hwnd);
+        
+        // 推迟增量更新：期间的添加/移除只记录最终状态，结束时一次应用（用于批量图钉操作）
+        static void beginDeferUpdate();
+        static void endDeferUpdate();
+        
         // 检查窗口是否在绑定列表中
         static bool isWindowBound(HWND hwnd);
         
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "core/common.h"
+#include "foundation/placement_batch.h"
+#include "foundation/stats_reporter.h"
+#include <vector>
+
+namespace Pin {
+
+    // 单个窗口在一帧内的位置/层级请求
+    // 同一窗口的多次请求会合并为一项，后到的覆盖先到的
+    using ZOrderRequest = Foundation::PlacementBatch<HWND>::Request;
+
+    // 层级管理器
+    // 收集图钉及绑定窗口在一帧内的位置与层级调整，
+    // 在提交时通过一次 BeginDeferWindowPos/EndDeferWindowPos 批量应用，
+    // 避免多个图钉各自调用 SetWindowPos 互相争抢并引发多次 DWM 重组。
+    // 仅在UI线程使用。
+    class ZOrderManager {
+    public:
+        // 统计信息
+        struct Stats {
+            size_t requests;      // 收到的请求次数（即旧实现中的 SetWindowPos 次数）
+            size_t merged;        // 同一帧内被合并的请求
+            size_t skipped;       // 与已应用状态相同而被剔除的请求
+            size_t applied;       // 实际应用的窗口项
+            size_t batches;       // 批量提交次数
+            size_t fallbacks;     // 批量失败后逐个回退的次数
+        };
+
+        // 获取单例实例
+        static ZOrderManager& getInstance();
+
+        // 设置接收提交通知的窗口（主窗口）
+        void setNotifyWindow(HWND wnd) { m_notifyWnd = wnd; }
+
+        // 请求移动窗口（不改变大小）
+        void requestMove(HWND wnd, int x, int y);
+
+        // 请求调整窗口层级
+        void requestZOrder(HWND wnd, HWND insertAfter);
+
+        // 丢弃窗口的待处理请求和已应用状态（窗口销毁或被外部移动时调用）
+        void forget(HWND wnd);
+
+        // 请求在消息循环空闲时提交（没有窗口请求但需要重绘图钉覆盖层时调用）
+        void requestCommit();
+
+        // 应用所有待处理的请求
+        void commit();
+
+        bool hasPending() const { return !m_batch.empty(); }
+
+        // 窗口是否有尚未提交的移动请求
+        bool hasPendingMove(HWND wnd) const { return m_batch.hasPendingMove(wnd); }
+
+        Stats getStats() const { return m_stats; }
+
+        // 批量应用计划；返回true表示批量成功，false表示已逐个回退。
+        // applied[i]表示plan[i]是否已成功应用
+        static bool applyBatch(const std::vector<ZOrderRequest>& plan, std::vector<bool>& applied);
+
+    private:
+        ZOrderManager() = default;
+        ~ZOrderManager() = default;
+
+        // 禁止复制和移动
+        ZOrderManager(const ZOrderManager&) = delete;
+        ZOrderManager& operator=(const ZOrderManager&) = delete;
+
+        // 统计合并的请求，本帧的第一个请求时通知提交
+        void countRequest(bool merged);
+
+        // 定期输出调用频率
+        void reportStats();
+
+        HWND m_notifyWnd = nullptr;
+        bool m_commitPosted = false;
+        Foundation::PlacementBatch<HWND> m_batch;
+
+        Stats m_stats = {};
+        Foundation::StatsReporter<Stats> m_statsReporter;
+    };
+
+} // namespace Pin
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "core/common.h"
+#include "foundation/stats_reporter.h"
+#include <unordered_map>
+#include <mutex>
+
+namespace Platform {
+
+    // 进程分类缓存
+    // 以 PID 为键缓存进程级分类结果，
+    // 持有进程句柄（带SYNCHRONIZE权限）以便检测进程退出，持有期间PID不会被重用，
+    // 避免每次查询都调用 OpenProcess；进程退出后尽早关闭句柄。
+    class ProcessClassifier {
+    public:
+        // 进程分类标志
+        enum Flags : unsigned {
+            PACKAGED   = 1 << 0,    // 打包应用（UWP / MSIX）
+            ACCESSIBLE = 1 << 1,    // 能够打开进程进行查询
+        };
+
+        // 统计信息
+        struct Stats {
+            size_t lookups;         // 查询次数
+            size_t hits;            // 缓存命中次数
+            size_t openProcess;     // OpenProcess 调用次数
+            size_t evictions;       // 因进程退出而移除的项
+            size_t entries;         // 当前缓存项数量
+        };
+
+        // 获取单例实例
+        static ProcessClassifier& getInstance();
+
+        // 获取窗口所属进程的分类标志
+        unsigned classifyWindow(HWND wnd);
+
+        // 获取进程的分类标志
+        unsigned classifyProcess(DWORD pid);
+
+        // 进程是否为打包应用
+        bool isPackagedProcess(DWORD pid) { return (classifyProcess(pid) & PACKAGED) != 0; }
+
+        // 移除已退出进程的缓存项
+        void pruneExited();
+
+        Stats getStats() const;
+
+        // 清空所有缓存并关闭句柄
+        void clear();
+
+    private:
+        ProcessClassifier() = default;
+        ~ProcessClassifier();
+
+        // 禁止复制和移动
+        ProcessClassifier(const ProcessClassifier&) = delete;
+        ProcessClassifier& operator=(const ProcessClassifier&) = delete;
+
+        struct Entry {
+            HANDLE process = nullptr;       // 用于检测退出的进程句柄
+            unsigned flags = 0;
+            DWORD classifiedTick = 0;       // 无法打开进程时用于定期重试
+        };
+
+        // 检查缓存项是否仍对应同一个正在运行的进程
+        static bool isEntryAlive(const Entry& entry, DWORD now);
+
+        // 打开进程并完成分类
+        Entry classify(DWORD pid);
+
+        static void closeEntry(Entry& entry);
+
+        // 移除已退出进程的缓存项（需持有锁）
+        void pruneLocked(DWORD now);
+
+        void reportStats(DWORD now);
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<DWORD, Entry> m_entries;
+        DWORD m_lastPruneTick = 0;
+
+        Stats m_stats = {};
+        Foundation::StatsReporter<Stats> m_statsReporter;
+    };
+
+} // namespace Platform
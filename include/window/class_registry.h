@@ -0,0 +1,95 @@
+#pragma once
+
+#include "core/common.h"
+#include "window/window_strings.h"
+#include "foundation/intern_table.h"
+#include "foundation/stats_reporter.h"
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Window {
+
+    // 窗口类ID，0表示未知
+    using ClassId = uint32_t;
+
+    // 窗口类名驻留表
+    // 把类名（按ASCII不区分大小写，与_wcsicmp一致）映射为进程内唯一的小整数ID，
+    // 检测函数和自动图钉规则的预筛选只需比较整数或检查特性位。
+    // 窗口的类通过类原子（GetClassLongPtr(GCW_ATOM)，不发送消息）查找，
+    // 原子未见过时才调用GetClassName；类注销后原子可能被重用，因此原子映射定期清空。
+    // 常用的类预先驻留，ID固定。
+    // 可在任意线程使用。
+    class ClassRegistry {
+    public:
+        // 预先驻留的类
+        enum WellKnown : ClassId {
+            CLASS_UNKNOWN = 0,
+            CLASS_PROGMAN,                  // ProgMan
+            CLASS_SHELL_TRAY,               // Shell_TrayWnd
+            CLASS_VCL_APPLICATION,          // TApplication
+            CLASS_APPLICATION_FRAME,        // ApplicationFrameWindow
+            CLASS_CORE_WINDOW,              // Windows.UI.Core.CoreWindow
+            CLASS_XAML_POPUP,               // XAML_WindowedPopupClass
+            CLASS_DIRECT_UI,                // DirectUIHWND
+            WELL_KNOWN_COUNT
+        };
+
+        // 类的特性位，驻留时根据类名计算一次
+        enum Trait : uint8_t {
+            TRAIT_MODERN_APP    = 1 << 0,   // 现代应用的框架/内容窗口
+            TRAIT_PROXY_CONTENT = 1 << 1,   // 适合作为现代应用代理窗口的内容窗口
+        };
+
+        // 统计信息
+        struct Stats {
+            size_t lookups;         // classOf调用次数
+            size_t atomHits;        // 由类原子直接得到ID的次数
+            size_t nameFetches;     // 调用GetClassName的次数
+            size_t classes;         // 已驻留的类数
+        };
+
+        // 获取单例实例
+        static ClassRegistry& getInstance();
+
+        // 驻留类名，返回其ID；空字符串返回CLASS_UNKNOWN
+        ClassId intern(std::wstring_view name);
+
+        // 只查找不驻留，不存在时返回CLASS_UNKNOWN
+        ClassId find(std::wstring_view name) const;
+
+        // 窗口所属类的ID，窗口无效时返回CLASS_UNKNOWN
+        ClassId classOf(HWND wnd);
+
+        // 驻留时的类名（第一次出现时的大小写）
+        WindowClassName name(ClassId id) const;
+
+        bool hasTrait(ClassId id, Trait trait) const;
+
+        Stats getStats() const;
+
+    private:
+        ClassRegistry();
+        ~ClassRegistry() = default;
+
+        // 禁止复制和移动
+        ClassRegistry(const ClassRegistry&) = delete;
+        ClassRegistry& operator=(const ClassRegistry&) = delete;
+
+        // 需持有锁
+        ClassId internLocked(std::wstring_view name);
+        ClassId findLocked(std::wstring_view name) const;
+
+        mutable std::mutex m_mutex;
+        Foundation::InternTable<Constants::MAX_CLASSNAME_LEN> m_classes;
+        std::vector<uint8_t> m_traits;                  // 按ID保存的特性位
+        std::unordered_map<ATOM, ClassId> m_atoms;
+        DWORD m_atomsClearedTick = 0;
+
+        Stats m_stats = {};
+        Foundation::StatsReporter<Stats> m_statsReporter;
+    };
+
+} // namespace Window
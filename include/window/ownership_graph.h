@@ -0,0 +1,92 @@
+#pragma once
+
+#include "core/common.h"
+#include "foundation/ownership_index.h"
+#include <unordered_map>
+#include <vector>
+
+namespace Window {
+
+    // 窗口所有关系图
+    // 缓存被跟踪线程的顶级窗口（按z-order）及其所有者，用于回答
+    // “顶级父窗口”、“线程上被X拥有的窗口”和“最佳代理窗口”，不必每次调用EnumThreadWindows。
+    // 跟踪期间订阅目标进程的创建/销毁/显示/重排/父窗口改变/前台事件：创建、销毁和父窗口改变直接更新缓存，
+    // 重排和前台切换无法得知新的z-order，只把对应线程标记为失效，下一次查询时重新枚举；
+    // 另有定期校验作为遗漏事件（如通过GWLP_HWNDPARENT更换所有者）的保险。
+    // 未跟踪的线程每次查询都直接枚举。
+    // 仅在UI线程使用。
+    class OwnershipGraph {
+    public:
+        // 统计信息
+        struct Stats {
+            size_t queries;         // 查询次数
+            size_t enumerations;    // 实际调用EnumThreadWindows的次数
+            size_t invalidations;   // 事件导致的失效次数
+            size_t updates;         // 由事件直接更新缓存的次数
+        };
+
+        // 获取单例实例
+        static OwnershipGraph& getInstance();
+
+        // 开始跟踪窗口所在的线程（引用计数），返回线程ID，失败时返回0
+        DWORD track(HWND wnd);
+
+        // 停止跟踪线程
+        void untrack(DWORD threadId);
+
+        // 标记线程的缓存失效（本程序调整了该线程窗口的层级后调用）
+        void invalidateThread(DWORD threadId);
+
+        // 线程的事件计数：每收到一个窗口创建/销毁/显示等事件加一，未跟踪的线程返回0。
+        // 调用者可据此判断上次查询之后线程是否有变化
+        size_t generation(DWORD threadId) const;
+
+        // 返回owner及其所在线程上被owner拥有的顶级窗口，按z-order从上到下
+        std::vector<HWND> ownedWindows(HWND owner);
+
+        // 返回owner拥有的第一个可见、未最小化且矩形非空的窗口，不存在时返回nullptr
+        HWND findProxy(HWND owner);
+
+        // 沿父窗口/所有者链找到最终的顶级窗口，与Window::getTopParent相同
+        HWND topParent(HWND wnd);
+
+        Stats getStats() const { return m_stats; }
+
+    private:
+        OwnershipGraph() = default;
+        ~OwnershipGraph() = default;
+
+        // 禁止复制和移动
+        OwnershipGraph(const OwnershipGraph&) = delete;
+        OwnershipGraph& operator=(const OwnershipGraph&) = delete;
+
+        struct ThreadNode {
+            DWORD processId = 0;
+            int refCount = 0;
+            bool valid = false;
+            DWORD refreshedTick = 0;
+            size_t generation = 0;
+        };
+
+        // 返回线程的有效节点（需要时重新枚举）；线程未被跟踪时返回nullptr
+        ThreadNode* validNode(DWORD threadId);
+
+        // 枚举线程的顶级窗口
+        void enumerate(DWORD threadId, std::vector<HWND>& windows, std::vector<HWND>& owners);
+
+        // 按窗口创建/销毁/父窗口改变事件更新线程的缓存
+        void applyEvent(DWORD event, HWND hwnd, DWORD threadId);
+
+        // 窗口的所有者：已缓存时直接返回，否则查询系统
+        HWND ownerOf(HWND wnd);
+
+        static BOOL CALLBACK enumProc(HWND wnd, LPARAM param);
+        static void CALLBACK eventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd,
+                                       LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime);
+
+        std::unordered_map<DWORD, ThreadNode> m_threads;
+        Foundation::OwnershipIndex<HWND, DWORD> m_index;   // 被跟踪线程的顶级窗口及其所有者
+        Stats m_stats = {};
+    };
+
+} // namespace Window
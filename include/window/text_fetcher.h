@@ -0,0 +1,82 @@
+#pragma once
+
+#include "core/common.h"
+#include "window/window_strings.h"
+#include "foundation/stats_reporter.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace Window {
+
+    // 窗口文本获取服务
+    // 对其他进程的窗口，GetWindowText会同步发送WM_GETTEXT，目标程序无响应时调用线程会一直阻塞。
+    // 本服务立即返回最后已知的文本（首次查询使用不发送消息的InternalGetWindowText），
+    // 过期时仍返回缓存的文本，由后台线程通过SendMessageTimeout(SMTO_ABORTIFHUNG)刷新；
+    // 超时的窗口标记为无响应，在重试间隔内不再发送消息，改用InternalGetWindowText。
+    // 本进程的窗口直接使用GetWindowText。
+    class TextFetcher {
+    public:
+        // 统计信息
+        struct Stats {
+            size_t requests;            // 查询次数
+            size_t refreshes;           // 后台刷新次数
+            size_t timeouts;            // 刷新超时（目标无响应）次数
+            size_t hungSkips;           // 因目标无响应而跳过刷新的次数
+            ULONGLONG blockedMicros;    // 后台线程在SendMessageTimeout中的累计阻塞时间
+            ULONGLONG maxBlockedMicros; // 单次最长阻塞时间
+            ULONGLONG callerMicros;     // 调用线程在getText中的累计耗时
+        };
+
+        // 获取单例实例
+        static TextFetcher& getInstance();
+
+        // 获取窗口文本，不会被无响应的程序阻塞；超过MAX_WINDOWTEXT_LEN的部分被截断
+        WindowText getText(HWND wnd);
+
+        // 停止后台线程（程序退出前调用）
+        void shutdown();
+
+        Stats getStats() const;
+
+    private:
+        TextFetcher() = default;
+        ~TextFetcher();
+
+        // 禁止复制和移动
+        TextFetcher(const TextFetcher&) = delete;
+        TextFetcher& operator=(const TextFetcher&) = delete;
+
+        struct Entry {
+            WindowText text;
+            DWORD fetchedTick = 0;      // 上次成功获取的时刻
+            DWORD retryTick = 0;        // 无响应时允许再次刷新的时刻
+            bool hung = false;
+            bool pending = false;       // 已在刷新队列中
+        };
+
+        // 后台线程
+        void workerProc();
+
+        // 通过SendMessageTimeout获取文本，返回是否成功
+        static bool fetchWithTimeout(HWND wnd, WindowText& text);
+
+        // 移除已销毁窗口的缓存项（需持有锁）
+        void pruneLocked();
+
+        void reportStats(DWORD now);
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::unordered_map<HWND, Entry> m_entries;
+        std::deque<HWND> m_queue;
+        std::thread m_worker;
+        bool m_stop = false;
+
+        Stats m_stats = {};
+        Foundation::StatsReporter<Stats> m_statsReporter;
+    };
+
+} // namespace Window
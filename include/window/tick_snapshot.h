@@ -0,0 +1,116 @@
+#pragma once
+
+#include "core/common.h"
+#include "foundation/stats_reporter.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Window {
+
+    // 跟踪周期内的窗口状态快照
+    // 一次跟踪周期（调度器的一个刻度或FrameSync的一帧）内，多个图钉和多个调用点会反复查询同一批窗口。
+    // 快照按窗口分配一行，矩形、样式、可见性、所有者等按列（结构数组）保存，
+    // 每一列在周期内首次被读取时才查询系统，之后的读取直接返回，因此每个窗口的每项Win32查询每个周期最多一次。
+    // 本程序修改了窗口（ShowWindow、SetWindowLong等）后应调用invalidate，下一次读取会重新查询。
+    // 周期之外的读取直接查询系统，不做缓存。
+    // 仅在UI线程使用。
+    class TickSnapshot {
+    public:
+        // 统计信息
+        struct Stats {
+            size_t ticks;           // 周期数
+            size_t reads;           // 周期内的读取次数
+            size_t calls;           // 周期内实际调用Win32的次数
+            size_t maxCalls;        // 单个周期内最多的Win32调用次数
+            size_t maxWindows;      // 单个周期内最多涉及的窗口数
+        };
+
+        // 一个跟踪周期的作用域，可以嵌套，最外层结束时丢弃快照
+        class Scope {
+        public:
+            Scope() { TickSnapshot::getInstance().begin(); }
+            ~Scope() { TickSnapshot::getInstance().end(); }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        };
+
+        // 获取单例实例
+        static TickSnapshot& getInstance();
+
+        // 当前是否处于跟踪周期内
+        bool isActive() const { return m_depth > 0; }
+
+        // 丢弃窗口已读取的状态
+        void invalidate(HWND wnd);
+
+        bool isWindow(HWND wnd);
+        bool getRect(HWND wnd, RECT& rect);
+        bool isVisible(HWND wnd);
+        bool isIconic(HWND wnd);
+        bool isEnabled(HWND wnd);
+        LONG getStyle(HWND wnd);
+        LONG getExStyle(HWND wnd);
+        HWND getOwner(HWND wnd);
+
+        Stats getStats() const { return m_stats; }
+
+    private:
+        TickSnapshot() = default;
+        ~TickSnapshot() = default;
+
+        // 禁止复制和移动
+        TickSnapshot(const TickSnapshot&) = delete;
+        TickSnapshot& operator=(const TickSnapshot&) = delete;
+
+        // 各列的已读取标志
+        enum : uint8_t {
+            LOADED_VALID    = 1 << 0,
+            LOADED_RECT     = 1 << 1,
+            LOADED_VISIBLE  = 1 << 2,
+            LOADED_ICONIC   = 1 << 3,
+            LOADED_ENABLED  = 1 << 4,
+            LOADED_STYLE    = 1 << 5,
+            LOADED_EXSTYLE  = 1 << 6,
+            LOADED_OWNER    = 1 << 7,
+        };
+
+        // 布尔状态位
+        enum : uint8_t {
+            FLAG_VALID      = 1 << 0,
+            FLAG_RECT       = 1 << 1,   // GetWindowRect成功
+            FLAG_VISIBLE    = 1 << 2,
+            FLAG_ICONIC     = 1 << 3,
+            FLAG_ENABLED    = 1 << 4,
+        };
+
+        void begin();
+        void end();
+
+        // 窗口所在的行，不存在时追加
+        uint32_t row(HWND wnd);
+
+        // 读取一个布尔状态位，需要时查询系统
+        bool flag(HWND wnd, uint8_t loaded, uint8_t bit, BOOL (WINAPI* query)(HWND));
+
+        void reportStats();
+
+        int m_depth = 0;
+        size_t m_tickCalls = 0;
+
+        // 按列保存，下标为行号
+        std::vector<HWND> m_wnds;
+        std::vector<uint8_t> m_loaded;
+        std::vector<uint8_t> m_flags;
+        std::vector<RECT> m_rects;
+        std::vector<LONG> m_styles;
+        std::vector<LONG> m_exStyles;
+        std::vector<HWND> m_owners;
+        std::unordered_map<HWND, uint32_t> m_index;
+
+        Stats m_stats = {};
+        Foundation::StatsReporter<Stats> m_statsReporter;
+    };
+
+} // namespace Window
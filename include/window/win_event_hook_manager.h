@@ -0,0 +1,82 @@
+#pragma once
+
+#include "core/common.h"
+#include "foundation/stats_reporter.h"
+#include <atomic>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+namespace Window {
+
+    // WinEvent钩子管理器
+    // 按 (事件范围, 回调函数, 进程ID) 对钩子进行引用计数，
+    // 相同组合只安装一个钩子；进程ID为0表示全局钩子。
+    // 所有钩子共用一个分发函数，用于统计每秒接收的事件数量。
+    // 钩子安装在窗口事件线程上（见WinEventThread），回调经队列在UI线程执行；
+    // 引用计数只在UI线程维护。
+    class WinEventHookManager {
+    public:
+        // 统计信息
+        struct Stats {
+            size_t hooks;           // 当前安装的钩子数量
+            size_t globalHooks;     // 其中全局钩子的数量
+            size_t events;          // 累计接收的事件数量
+        };
+
+        // 获取单例实例
+        static WinEventHookManager& getInstance();
+
+        // 增加钩子引用，首次引用时安装钩子；返回钩子是否可用
+        bool acquire(DWORD eventMin, DWORD eventMax, WINEVENTPROC handler, DWORD processId = 0);
+
+        // 减少钩子引用，引用归零时卸载钩子
+        void release(DWORD eventMin, DWORD eventMax, WINEVENTPROC handler, DWORD processId = 0);
+
+        // 卸载指定回调函数的所有钩子
+        void releaseAll(WINEVENTPROC handler);
+
+        // 卸载所有钩子（在停止事件线程之前调用）
+        void shutdown();
+
+        Stats getStats() const;
+
+    private:
+        WinEventHookManager() = default;
+        ~WinEventHookManager();
+
+        // 禁止复制和移动
+        WinEventHookManager(const WinEventHookManager&) = delete;
+        WinEventHookManager& operator=(const WinEventHookManager&) = delete;
+
+        // 所有钩子的统一入口：计数后转发到注册的回调函数
+        static void CALLBACK dispatch(HWINEVENTHOOK hook, DWORD event, HWND hwnd,
+                                      LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime);
+
+        // 在安装钩子的线程上卸载钩子
+        void unhook(HWINEVENTHOOK hook);
+
+        // UI线程：安装（delta>0）或卸载钩子后更新计数
+        void countHook(HWINEVENTHOOK hook, DWORD processId, int delta);
+
+        void reportStats(DWORD now);
+
+        using Key = std::tuple<DWORD, DWORD, uintptr_t, DWORD>;    // 事件范围、回调、进程ID
+
+        struct Entry {
+            HWINEVENTHOOK hook;
+            WINEVENTPROC handler;
+            int refCount;
+        };
+
+        std::map<Key, Entry> m_entries;
+        std::unordered_map<HWINEVENTHOOK, WINEVENTPROC> m_handlers;     // 仅在承载钩子的线程访问
+
+        std::atomic<size_t> m_events{0};
+        // 已安装的钩子数量，由UI线程维护，统计输出可能在事件线程上读取
+        std::atomic<size_t> m_hookCount{0};
+        std::atomic<size_t> m_globalHookCount{0};
+        Foundation::StatsReporter<size_t> m_statsReporter;    // 统计m_events
+    };
+
+} // namespace Window
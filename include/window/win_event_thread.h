@@ -0,0 +1,102 @@
+#pragma once
+
+#include "core/common.h"
+#include "foundation/spsc_queue.h"
+#include "foundation/stats_reporter.h"
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Window {
+
+    // 一条窗口事件记录
+    struct WinEventRecord {
+        WINEVENTPROC handler;
+        HWINEVENTHOOK hook;
+        DWORD event;
+        HWND hwnd;
+        LONG idObject;
+        LONG idChild;
+        DWORD eventThread;
+        DWORD eventTime;
+        LONGLONG received;      // 事件线程收到事件时的QPC计数
+    };
+
+    // 窗口事件线程
+    // 拥有自己的消息循环并承载所有WinEvent钩子，在此线程上完成过滤与合并，
+    // 通过无锁队列把事件交给UI线程；UI线程只在有待处理事件时被唤醒一次。
+    class WinEventThread {
+    public:
+        // 获取单例实例
+        static WinEventThread& getInstance();
+
+        // 启动事件线程；有待处理事件时向notifyWnd发送notifyMsg
+        bool start(HWND notifyWnd, UINT notifyMsg);
+
+        // 停止事件线程（调用前应先卸载所有钩子）
+        void stop();
+
+        bool isRunning() const { return m_threadId != 0; }
+
+        // 当前是否在事件线程上
+        bool isCurrentThread() const { return m_threadId != 0 && GetCurrentThreadId() == m_threadId; }
+
+        // 在事件线程上同步执行任务；线程未运行时直接在当前线程执行
+        void invoke(const std::function<void()>& task);
+
+        // 事件线程：记录一个事件，在本轮消息处理结束后统一提交
+        void enqueue(const WinEventRecord& record);
+
+        // UI线程：处理所有排队的事件
+        void drain();
+
+    private:
+        WinEventThread() = default;
+        ~WinEventThread();
+
+        // 禁止复制和移动
+        WinEventThread(const WinEventThread&) = delete;
+        WinEventThread& operator=(const WinEventThread&) = delete;
+
+        void threadProc();
+
+        // 事件线程：把本轮合并后的事件放入队列并唤醒UI线程；队列已满时剩余事件留到下一轮
+        void flushBatch();
+
+        // UI线程：记录从收到事件到处理完毕的延迟
+        void recordLatency(LONGLONG received, LONGLONG now);
+        void reportStats(DWORD now);
+
+        static constexpr size_t QUEUE_CAPACITY = 4096;
+        static constexpr size_t LATENCY_BUCKETS = 24;   // 按微秒取log2分桶
+
+        // 累计的处理延迟分布
+        struct LatencyStats {
+            size_t processed;
+            size_t buckets[LATENCY_BUCKETS];
+        };
+
+        std::thread m_thread;
+        std::atomic<DWORD> m_threadId{0};
+        HWND m_notifyWnd = nullptr;
+        UINT m_notifyMsg = 0;
+
+        // 仅事件线程访问
+        std::vector<WinEventRecord> m_batch;
+        std::unordered_map<HWND, size_t> m_batchLocation;   // 位置变化事件在本轮中的索引，用于合并
+        UINT_PTR m_retryTimer = 0;                          // 队列已满时重新提交的线程定时器
+
+        Foundation::SpscQueue<WinEventRecord, QUEUE_CAPACITY> m_queue;
+        std::atomic<bool> m_wakePending{false};
+        std::atomic<size_t> m_coalesced{0};
+        std::atomic<size_t> m_deferred{0};
+
+        // 仅UI线程访问
+        LONGLONG m_qpcFrequency = 0;
+        LatencyStats m_latency = {};
+        Foundation::StatsReporter<LatencyStats> m_statsReporter;
+    };
+
+} // namespace Window
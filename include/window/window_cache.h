@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/common.h"
+#include "window/window_strings.h"
 #include <string>
 #include <unordered_map>
 #include <chrono>
@@ -18,8 +19,8 @@ namespace Window {
 
     // 窗口状态缓存项
     struct WindowCacheEntry {
-        std::wstring windowText;
-        std::wstring className;
+        WindowText windowText;
+        WindowClassName className;
         RECT windowRect;
         bool isVisible;
         bool isIconic;
@@ -47,10 +48,10 @@ namespace Window {
         static WindowCache& getInstance();
 
         // 获取窗口文本（带缓存）
-        std::wstring getWindowText(HWND wnd, bool forceRefresh = false);
+        WindowText getWindowText(HWND wnd, bool forceRefresh = false);
         
         // 获取窗口类名（带缓存）
-        std::wstring getWindowClassName(HWND wnd, bool forceRefresh = false);
+        WindowClassName getWindowClassName(HWND wnd, bool forceRefresh = false);
         
         // 获取窗口矩形（带缓存）
         bool getWindowRect(HWND wnd, RECT& rect, bool forceRefresh = false);
@@ -135,8 +136,8 @@ namespace Window {
 
     // 便利函数，使用缓存的窗口API
     namespace Cached {
-        std::wstring getWindowText(HWND wnd, bool forceRefresh = false);
-        std::wstring getWindowClassName(HWND wnd, bool forceRefresh = false);
+        WindowText getWindowText(HWND wnd, bool forceRefresh = false);
+        WindowClassName getWindowClassName(HWND wnd, bool forceRefresh = false);
         bool getWindowRect(HWND wnd, RECT& rect, bool forceRefresh = false);
         bool isWindowVisible(HWND wnd, bool forceRefresh = false);
         bool isWindowIconic(HWND wnd, bool forceRefresh = false);
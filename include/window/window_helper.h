@@ -1,13 +1,14 @@
 #pragma once
 
 #include "core/common.h"
+#include "window/window_strings.h"
 #include <string>
 
 namespace Window {
 
     // 窗口基本属性获取函数
-    std::wstring getWindowText(HWND wnd);
-    std::wstring getWindowClassName(HWND wnd);
+    WindowText getWindowText(HWND wnd);
+    WindowClassName getWindowClassName(HWND wnd);
     
     // 窗口状态检查函数
     bool isWndRectEmpty(HWND wnd);
@@ -18,7 +19,7 @@ namespace Window {
     HWND getNonChildParent(HWND wnd);
     HWND getTopParent(HWND wnd);
     
-    // 获取窗口的实际可视边框（考虑DWM扩展边框）
+    // 获取窗口的实际可视边框（考虑DWM扩展边框）；使用Dwm的帧缓存，仅在UI线程调用
     bool getVisibleWindowRect(HWND wnd, RECT& rect);
     
     // 窗口操作函数
@@ -32,13 +33,13 @@ namespace Window {
         WndHelper(HWND hwnd);
         
         // 获取窗口文本
-        std::wstring getText() const;
+        WindowText getText() const;
         
         // 设置窗口文本
         void setText(const std::wstring& text) const;
         
         // 获取窗口类名
-        std::wstring getClassName() const;
+        WindowClassName getClassName() const;
         
         // 获取窗口样式
         LONG getStyle() const;
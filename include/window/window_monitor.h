@@ -21,7 +21,7 @@ public:
     bool term();
 
 private:
-    static HWINEVENTHOOK hook;
+    static bool installed;
     static HWND wnd;
     static int msgId;
 
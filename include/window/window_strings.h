@@ -0,0 +1,13 @@
+#pragma once
+
+#include "core/common.h"
+#include "foundation/inline_string.h"
+
+namespace Window {
+
+    // 窗口标题和类名
+    // 长度受Constants中的上限约束，直接保存在对象内部，获取和复制时不分配堆内存
+    using WindowText = Foundation::InlineWString<Constants::MAX_WINDOWTEXT_LEN>;
+    using WindowClassName = Foundation::InlineWString<Constants::MAX_CLASSNAME_LEN>;
+
+} // namespace Window
@@ -3,11 +3,54 @@
 #include "ui/main_window.h"
 #include "pin/pin_window.h"
 #include "pin/pin_layer_window.h"
+#include "pin/pin_overlay.h"
 #include "resource.h"
 #include "system/language_manager.h"
 
 LPCWSTR App::APPNAME = L"TinyPin";
 
+namespace {
+    // DWMWA_EXTENDED_FRAME_BOUNDS，避免依赖dwmapi.h
+    constexpr DWORD DWM_ATTR_EXTENDED_FRAME_BOUNDS = 9;
+}
+
+HRESULT Dwm::getWindowAttribute(HWND wnd, DWORD attr, PVOID data, DWORD size) const {
+    if (!DwmGetWindowAttribute_) {
+        return E_NOTIMPL;
+    }
+    return DwmGetWindowAttribute_(wnd, attr, data, size);
+}
+
+HRESULT Dwm::flush() const {
+    if (!DwmFlush_) {
+        return E_NOTIMPL;
+    }
+    return DwmFlush_();
+}
+
+bool Dwm::getExtendedFrameBounds(HWND wnd, RECT& rect) {
+    if (!DwmGetWindowAttribute_ || !wnd) {
+        return false;
+    }
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    LONGLONG now = counter.QuadPart;
+    auto it = frameMemo_.find(wnd);
+    if (it != frameMemo_.end() && (!memoTtl_ || now - it->second.stamp <= memoTtl_)) {
+        rect = it->second.rect;
+        return it->second.valid;
+    }
+
+    MemoEntry entry = {};
+    entry.valid = SUCCEEDED(DwmGetWindowAttribute_(wnd, DWM_ATTR_EXTENDED_FRAME_BOUNDS, &entry.rect, sizeof(RECT)));
+    entry.stamp = now;
+    frameMemo_[wnd] = entry;
+
+    rect = entry.rect;
+    return entry.valid;
+}
+
 bool App::loadResMod(const std::wstring& file, HWND msgParent) {
     freeResMod();
 
@@ -62,7 +105,8 @@ bool App::chkPrevInst() {
 bool App::regWndCls() {
     return MainWnd::registerClass() && 
            PinWnd::registerClass() && 
-           PinLayerWnd::registerClass();
+           PinLayerWnd::registerClass() &&
+           Pin::PinOverlay::registerClass();
 }
 
 bool App::createMainWnd(Options& opt) {
@@ -86,12 +86,10 @@ int WINAPI WinMain(HINSTANCE inst, HINSTANCE, LPSTR, int)
     Pin::PinManager::restoreAllPinnedWindows();
     
     // 清理所有可能残留的窗口
-    HWND pin;
-    while ((pin = FindWindow(PinWnd::className, nullptr)) != nullptr) {
-        DestroyWindow(pin);
-    }
+    Pin::PinManager::unpinAll();
     
     // 清理图钉层窗口
+    HWND pin;
     while ((pin = FindWindow(PinLayerWnd::className, nullptr)) != nullptr) {
         DestroyWindow(pin);
     }
@@ -0,0 +1,38 @@
+#include "core/stdafx.h"
+#include "foundation/adaptive_interval.h"
+#include <algorithm>
+
+namespace Foundation {
+
+    void AdaptiveInterval::reset(int fast, uint32_t now) {
+        m_fast = fast;
+        m_current = fast;
+        m_lastActivity = now;
+    }
+
+    int AdaptiveInterval::update(bool changed, uint32_t now, int slow, uint32_t idleDelay) {
+        if (changed) {
+            m_lastActivity = now;
+            m_current = m_fast;
+            return m_current;
+        }
+
+        if (now - m_lastActivity >= idleDelay) {
+            int limit = (std::max)(slow, m_fast);
+            if (m_current < limit) {
+                m_current = (std::min)(m_current * 2, limit);
+            }
+        }
+        return m_current;
+    }
+
+    bool AdaptiveInterval::wake(uint32_t now) {
+        m_lastActivity = now;
+        if (m_current == m_fast) {
+            return false;
+        }
+        m_current = m_fast;
+        return true;
+    }
+
+} // namespace Foundation
@@ -0,0 +1,118 @@
+#include "core/stdafx.h"
+#include "foundation/monitor_layout.h"
+#include <algorithm>
+
+namespace Foundation {
+
+    namespace {
+        long long overlapArea(const MonitorLayout::Rect& a, const MonitorLayout::Rect& b) {
+            long long w = (std::min)(a.right, b.right) - (std::max)(a.left, b.left);
+            long long h = (std::min)(a.bottom, b.bottom) - (std::max)(a.top, b.top);
+            return (w > 0 && h > 0) ? w * h : 0;
+        }
+
+        // 点到矩形的距离平方（点在矩形内时为0）
+        long long distanceSq(const MonitorLayout::Rect& rc, int x, int y) {
+            long long dx = x < rc.left ? rc.left - x : (x >= rc.right ? x - rc.right + 1 : 0);
+            long long dy = y < rc.top ? rc.top - y : (y >= rc.bottom ? y - rc.bottom + 1 : 0);
+            return dx * dx + dy * dy;
+        }
+    }
+
+    void MonitorLayout::assign(std::vector<Monitor> monitors) {
+        m_monitors = std::move(monitors);
+        m_slabs.clear();
+
+        // 所有显示器的左右边界把桌面切成竖条
+        std::vector<int> edges;
+        edges.reserve(m_monitors.size() * 2);
+        for (const Monitor& m : m_monitors) {
+            if (m.bounds.empty()) continue;
+            edges.push_back(m.bounds.left);
+            edges.push_back(m.bounds.right);
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        for (size_t n = 0; n + 1 < edges.size(); ++n) {
+            Slab slab{ edges[n], edges[n + 1], {} };
+            for (size_t i = 0; i < m_monitors.size(); ++i) {
+                const Rect& rc = m_monitors[i].bounds;
+                if (!rc.empty() && rc.left <= slab.left && rc.right >= slab.right) {
+                    slab.monitors.push_back(i);
+                }
+            }
+            // 显示器互不重叠，同一竖条内按top排序即可二分
+            std::sort(slab.monitors.begin(), slab.monitors.end(), [this](size_t a, size_t b) {
+                return m_monitors[a].bounds.top < m_monitors[b].bounds.top;
+            });
+            m_slabs.push_back(std::move(slab));
+        }
+    }
+
+    size_t MonitorLayout::lookup(int x, int y) const {
+        // 最后一个left <= x的竖条
+        auto slab = std::upper_bound(m_slabs.begin(), m_slabs.end(), x,
+            [](int value, const Slab& s) { return value < s.left; });
+        if (slab == m_slabs.begin()) return npos;
+        --slab;
+        if (x >= slab->right) return npos;
+
+        // 竖条内最后一个top <= y的显示器
+        auto it = std::upper_bound(slab->monitors.begin(), slab->monitors.end(), y,
+            [this](int value, size_t index) { return value < m_monitors[index].bounds.top; });
+        if (it == slab->monitors.begin()) return npos;
+        --it;
+        return y < m_monitors[*it].bounds.bottom ? *it : npos;
+    }
+
+    size_t MonitorLayout::nearest(int x, int y) const {
+        size_t best = npos;
+        long long bestDist = 0;
+        for (size_t i = 0; i < m_monitors.size(); ++i) {
+            long long dist = distanceSq(m_monitors[i].bounds, x, y);
+            if (best == npos || dist < bestDist) {
+                best = i;
+                bestDist = dist;
+            }
+        }
+        return best;
+    }
+
+    size_t MonitorLayout::fromPoint(int x, int y) const {
+        size_t index = lookup(x, y);
+        return index != npos ? index : nearest(x, y);
+    }
+
+    size_t MonitorLayout::fromRect(const Rect& rc) const {
+        if (m_monitors.empty()) return npos;
+
+        int cx = rc.left + (rc.right - rc.left) / 2;
+        int cy = rc.top + (rc.bottom - rc.top) / 2;
+        if (rc.empty()) {
+            return fromPoint(cx, cy);
+        }
+
+        // 四个角落在同一显示器上时矩形完全在其中（常见情况）
+        size_t first = lookup(rc.left, rc.top);
+        if (first != npos
+            && lookup(rc.right - 1, rc.top) == first
+            && lookup(rc.left, rc.bottom - 1) == first
+            && lookup(rc.right - 1, rc.bottom - 1) == first) {
+            return first;
+        }
+
+        // 跨越多个显示器：取相交面积最大的
+        size_t best = npos;
+        long long bestArea = 0;
+        for (size_t i = 0; i < m_monitors.size(); ++i) {
+            long long area = overlapArea(m_monitors[i].bounds, rc);
+            if (area > bestArea) {
+                best = i;
+                bestArea = area;
+            }
+        }
+        return best != npos ? best : nearest(cx, cy);
+    }
+
+} // namespace Foundation
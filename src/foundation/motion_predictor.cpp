@@ -0,0 +1,88 @@
+#include "core/stdafx.h"
+#include "foundation/motion_predictor.h"
+#include <cmath>
+
+namespace Foundation {
+
+    void MotionPredictor::reset() {
+        m_hasSample = false;
+        m_moving = false;
+        m_vx = m_vy = 0.0;
+    }
+
+    void MotionPredictor::addSample(double timeMs, Point pos) {
+        if (!m_hasSample) {
+            m_hasSample = true;
+            m_last = pos;
+            m_lastTime = timeMs;
+            m_x = pos.x;
+            m_y = pos.y;
+            m_vx = m_vy = 0.0;
+            return;
+        }
+
+        double dt = timeMs - m_lastTime;
+        if (dt < MIN_SAMPLE_INTERVAL) {
+            // 同一时刻的重复读取只更新位置，不参与速度估计
+            if (pos.x != m_last.x || pos.y != m_last.y) {
+                m_last = pos;
+                m_x = pos.x;
+                m_y = pos.y;
+            }
+            return;
+        }
+
+        // 记录上一状态对此刻的预测误差
+        if (m_moving) {
+            Point predicted = predict(timeMs);
+            m_errorSum += std::hypot(double(predicted.x - pos.x), double(predicted.y - pos.y));
+            ++m_errorSamples;
+        }
+
+        bool stopped = pos.x == m_last.x && pos.y == m_last.y;
+        m_last = pos;
+        m_lastTime = timeMs;
+
+        // 停止或间隔过长：立即回到实际位置，不再外推
+        if (stopped || dt > MAX_SAMPLE_GAP) {
+            m_x = pos.x;
+            m_y = pos.y;
+            m_vx = m_vy = 0.0;
+            m_moving = false;
+            return;
+        }
+
+        // alpha-beta 滤波
+        double px = m_x + m_vx * dt;
+        double py = m_y + m_vy * dt;
+        double rx = pos.x - px;
+        double ry = pos.y - py;
+        m_x = px + m_alpha * rx;
+        m_y = py + m_alpha * ry;
+        m_vx += m_beta * rx / dt;
+        m_vy += m_beta * ry / dt;
+        m_moving = true;
+    }
+
+    MotionPredictor::Point MotionPredictor::predict(double timeMs) const {
+        if (!m_moving) {
+            return m_last;
+        }
+
+        double ahead = timeMs - m_lastTime;
+        if (ahead <= 0.0 || ahead > MAX_SAMPLE_GAP) {
+            return m_last;
+        }
+
+        // 从实际观察到的位置外推，滤波只用于估计速度
+        double dx = m_vx * ahead;
+        double dy = m_vy * ahead;
+        double dist = std::hypot(dx, dy);
+        if (dist > MAX_EXTRAPOLATION) {
+            dx *= MAX_EXTRAPOLATION / dist;
+            dy *= MAX_EXTRAPOLATION / dist;
+        }
+        return Point{ m_last.x + int(std::lround(dx)), m_last.y + int(std::lround(dy)) };
+    }
+
+} // namespace Foundation
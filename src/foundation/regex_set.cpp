@@ -0,0 +1,736 @@
+#include "core/stdafx.h"
+#include "foundation/regex_set.h"
+#include <algorithm>
+#include <type_traits>
+
+namespace Foundation {
+
+    namespace {
+        constexpr uint32_t MAX_CHAR = 0x10FFFF;
+        // 单个{m,n}允许的最大次数
+        constexpr int MAX_REPEAT = 1000;
+        // 分组允许的最大嵌套深度，解析和生成NFA都是递归的，限制深度以免栈溢出
+        constexpr int MAX_NESTING = 64;
+        // 所有模式合计允许的最大NFA状态数
+        constexpr size_t MAX_NFA_STATES = 1 << 16;
+        // 每个DFA状态除NFA集合和转移表外的估计开销（哈希表节点等）
+        constexpr size_t STATE_OVERHEAD = 64;
+
+        inline uint32_t unit(wchar_t c) {
+            return static_cast<uint32_t>(static_cast<std::make_unsigned<wchar_t>::type>(c));
+        }
+
+        // 语法树
+        struct Node {
+            enum Kind { SET, CAT, ALT, REPEAT, EMPTY } kind = EMPTY;
+            uint32_t set = 0;
+            int min = 0;
+            int max = 0;                // -1表示不限
+            std::vector<Node> children;
+        };
+    }
+
+    // 解析模式并生成NFA
+    class RegexCompiler {
+    public:
+        using Range = RegexSet::Range;
+
+        RegexCompiler(RegexSet& re, std::wstring_view pattern)
+            : m_re(re), m_pos(pattern.data()), m_end(pattern.data() + pattern.size()) {}
+
+        // 编译为第index个模式，失败时NFA保持不变
+        bool compile(uint32_t index, std::wstring& error) {
+            size_t nfaSize = m_re.m_nfa.size();
+            size_t setCount = m_re.m_sets.size();
+            if (!compileImpl(index)) {
+                m_re.m_nfa.resize(nfaSize);
+                m_re.m_sets.resize(setCount);
+                error = m_error;
+                return false;
+            }
+            return true;
+        }
+
+    private:
+        struct Patch {
+            int32_t state;
+            bool second;
+        };
+
+        struct Frag {
+            int32_t start;
+            std::vector<Patch> outs;
+        };
+
+        bool compileImpl(uint32_t index) {
+            if (m_end - m_pos >= 4 && std::wstring_view(m_pos, 4) == L"(?i)") {
+                m_icase = true;
+                m_pos += 4;
+            }
+
+            bool anchorStart = false, anchorEnd = false;
+            if (m_pos < m_end && *m_pos == L'^') {
+                anchorStart = true;
+                ++m_pos;
+            }
+            if (m_pos < m_end && m_end[-1] == L'$') {
+                // 结尾的$前面有奇数个反斜杠时是转义的字面字符
+                size_t slashes = 0;
+                for (const wchar_t* p = m_end - 1; p > m_pos && p[-1] == L'\\'; --p) {
+                    ++slashes;
+                }
+                if (slashes % 2 == 0) {
+                    anchorEnd = true;
+                    --m_end;
+                }
+            }
+
+            Node root;
+            if (!parseAlt(root)) return false;
+            if (m_pos != m_end) {
+                return fail(L"多余的')'");
+            }
+
+            Frag body;
+            if (!build(root, body)) return false;
+
+            int32_t match = newState(RegexSet::NFA_MATCH, index);
+            if (anchorEnd) {
+                patch(body.outs, match);
+            } else {
+                // 模式之后允许任意字符
+                int32_t split = anyLoop(match);
+                patch(body.outs, split);
+            }
+
+            int32_t start = anchorStart ? body.start : anyLoop(body.start);
+            if (m_re.m_nfa.size() > MAX_NFA_STATES) {
+                return fail(L"模式过大");
+            }
+            m_re.m_starts.push_back(start);
+            return true;
+        }
+
+        bool fail(const wchar_t* message) {
+            m_error = message;
+            return false;
+        }
+
+        // ---- 解析 ----
+
+        bool parseAlt(Node& node) {
+            Node first;
+            if (!parseCat(first)) return false;
+            if (m_pos == m_end || *m_pos != L'|') {
+                node = std::move(first);
+                return true;
+            }
+            node.kind = Node::ALT;
+            node.children.push_back(std::move(first));
+            while (m_pos < m_end && *m_pos == L'|') {
+                ++m_pos;
+                Node next;
+                if (!parseCat(next)) return false;
+                node.children.push_back(std::move(next));
+            }
+            return true;
+        }
+
+        bool parseCat(Node& node) {
+            node.kind = Node::CAT;
+            while (m_pos < m_end && *m_pos != L'|' && *m_pos != L')') {
+                Node atom;
+                if (!parseAtom(atom)) return false;
+                if (!parseQuantifier(atom)) return false;
+                node.children.push_back(std::move(atom));
+            }
+            if (node.children.empty()) {
+                node.kind = Node::EMPTY;
+            } else if (node.children.size() == 1) {
+                Node only = std::move(node.children[0]);
+                node = std::move(only);
+            }
+            return true;
+        }
+
+        bool parseAtom(Node& node) {
+            wchar_t c = *m_pos++;
+            switch (c) {
+            case L'(':
+                if (m_pos < m_end && *m_pos == L'?') {
+                    if (m_end - m_pos >= 2 && m_pos[1] == L':') {
+                        m_pos += 2;
+                    } else {
+                        return fail(L"不支持的分组语法");
+                    }
+                }
+                if (++m_depth > MAX_NESTING) {
+                    return fail(L"分组嵌套过深");
+                }
+                if (!parseAlt(node)) return false;
+                if (m_pos == m_end || *m_pos != L')') {
+                    return fail(L"缺少')'");
+                }
+                ++m_pos;
+                --m_depth;
+                return true;
+            case L'[':
+                return parseClass(node);
+            case L'.':
+                return setNode(node, { { 0, MAX_CHAR } });
+            case L'\\': {
+                std::vector<Range> ranges;
+                if (!parseEscape(ranges)) return false;
+                return setNode(node, std::move(ranges));
+            }
+            case L'^':
+            case L'$':
+                return fail(L"^和$只能出现在模式的首尾");
+            case L'*':
+            case L'+':
+            case L'?':
+                return fail(L"量词前没有可重复的内容");
+            default:
+                return setNode(node, { { unit(c), unit(c) } });
+            }
+        }
+
+        bool parseQuantifier(Node& atom) {
+            if (m_pos == m_end) return true;
+
+            int min, max;
+            wchar_t c = *m_pos;
+            if (c == L'*') {
+                min = 0; max = -1; ++m_pos;
+            } else if (c == L'+') {
+                min = 1; max = -1; ++m_pos;
+            } else if (c == L'?') {
+                min = 0; max = 1; ++m_pos;
+            } else if (c == L'{') {
+                // 不是合法的{m,n}时按字面字符处理
+                const wchar_t* save = m_pos;
+                ++m_pos;
+                if (!parseNumber(min)) {
+                    m_pos = save;
+                    return true;
+                }
+                max = min;
+                if (m_pos < m_end && *m_pos == L',') {
+                    ++m_pos;
+                    if (!parseNumber(max)) max = -1;
+                }
+                if (m_pos == m_end || *m_pos != L'}') {
+                    m_pos = save;
+                    return true;
+                }
+                ++m_pos;
+                if (min > MAX_REPEAT || max > MAX_REPEAT) return fail(L"重复次数过大");
+                if (max >= 0 && max < min) return fail(L"重复次数范围无效");
+            } else {
+                return true;
+            }
+
+            // 非贪婪量词不影响是否匹配
+            if (m_pos < m_end && *m_pos == L'?') ++m_pos;
+            if (m_pos < m_end && (*m_pos == L'*' || *m_pos == L'+' || *m_pos == L'?')) {
+                return fail(L"连续的量词");
+            }
+
+            Node repeat;
+            repeat.kind = Node::REPEAT;
+            repeat.min = min;
+            repeat.max = max;
+            repeat.children.push_back(std::move(atom));
+            atom = std::move(repeat);
+            return true;
+        }
+
+        bool parseNumber(int& value) {
+            if (m_pos == m_end || *m_pos < L'0' || *m_pos > L'9') return false;
+            value = 0;
+            while (m_pos < m_end && *m_pos >= L'0' && *m_pos <= L'9') {
+                value = (std::min)(value * 10 + (*m_pos - L'0'), MAX_REPEAT + 1);
+                ++m_pos;
+            }
+            return true;
+        }
+
+        static bool hexValue(wchar_t c, uint32_t& value) {
+            if (c >= L'0' && c <= L'9') value = c - L'0';
+            else if (c >= L'a' && c <= L'f') value = c - L'a' + 10;
+            else if (c >= L'A' && c <= L'F') value = c - L'A' + 10;
+            else return false;
+            return true;
+        }
+
+        // 解析反斜杠之后的转义，结果追加到ranges
+        bool parseEscape(std::vector<Range>& ranges) {
+            if (m_pos == m_end) return fail(L"模式以'\\'结尾");
+            wchar_t c = *m_pos++;
+            switch (c) {
+            case L'd': ranges.push_back({ L'0', L'9' }); return true;
+            case L'w': appendWord(ranges); return true;
+            case L's': appendSpace(ranges); return true;
+            case L'D': case L'W': case L'S': {
+                std::vector<Range> positive;
+                if (c == L'D') positive.push_back({ L'0', L'9' });
+                else if (c == L'W') appendWord(positive);
+                else appendSpace(positive);
+                std::vector<Range> negative = complement(normalize(std::move(positive)));
+                ranges.insert(ranges.end(), negative.begin(), negative.end());
+                return true;
+            }
+            case L't': ranges.push_back({ L'\t', L'\t' }); return true;
+            case L'n': ranges.push_back({ L'\n', L'\n' }); return true;
+            case L'r': ranges.push_back({ L'\r', L'\r' }); return true;
+            case L'x':
+            case L'u': {
+                int digits = c == L'x' ? 2 : 4;
+                uint32_t value = 0;
+                for (int n = 0; n < digits; ++n) {
+                    uint32_t digit;
+                    if (m_pos == m_end || !hexValue(*m_pos, digit)) return fail(L"无效的十六进制转义");
+                    value = value * 16 + digit;
+                    ++m_pos;
+                }
+                ranges.push_back({ value, value });
+                return true;
+            }
+            default:
+                // 字母和数字保留给将来的转义，其余字符转义后表示自身
+                if ((c >= L'a' && c <= L'z') || (c >= L'A' && c <= L'Z') || (c >= L'0' && c <= L'9')) {
+                    return fail(L"不支持的转义");
+                }
+                ranges.push_back({ unit(c), unit(c) });
+                return true;
+            }
+        }
+
+        bool parseClass(Node& node) {
+            bool negate = false;
+            if (m_pos < m_end && *m_pos == L'^') {
+                negate = true;
+                ++m_pos;
+            }
+
+            std::vector<Range> ranges;
+            bool first = true;
+            for (;;) {
+                if (m_pos == m_end) return fail(L"缺少']'");
+                wchar_t c = *m_pos;
+                if (c == L']' && !first) {
+                    ++m_pos;
+                    break;
+                }
+                first = false;
+
+                uint32_t lo;
+                ++m_pos;
+                if (c == L'\\') {
+                    std::vector<Range> escaped;
+                    if (!parseEscape(escaped)) return false;
+                    if (escaped.size() != 1 || escaped[0].lo != escaped[0].hi) {
+                        // \d等字符类不能作为范围的端点
+                        ranges.insert(ranges.end(), escaped.begin(), escaped.end());
+                        continue;
+                    }
+                    lo = escaped[0].lo;
+                } else {
+                    lo = unit(c);
+                }
+
+                uint32_t hi = lo;
+                if (m_end - m_pos >= 2 && *m_pos == L'-' && m_pos[1] != L']') {
+                    ++m_pos;
+                    wchar_t h = *m_pos++;
+                    if (h == L'\\') {
+                        std::vector<Range> escaped;
+                        if (!parseEscape(escaped)) return false;
+                        if (escaped.size() != 1 || escaped[0].lo != escaped[0].hi) {
+                            return fail(L"无效的字符范围");
+                        }
+                        hi = escaped[0].lo;
+                    } else {
+                        hi = unit(h);
+                    }
+                    if (hi < lo) return fail(L"无效的字符范围");
+                }
+                ranges.push_back({ lo, hi });
+            }
+
+            // 不区分大小写时先补全大小写再取反
+            ranges = normalize(foldCase(std::move(ranges)));
+            if (negate) {
+                ranges = complement(ranges);
+            }
+            return setNode(node, std::move(ranges), false);
+        }
+
+        static void appendWord(std::vector<Range>& ranges) {
+            ranges.push_back({ L'0', L'9' });
+            ranges.push_back({ L'A', L'Z' });
+            ranges.push_back({ L'_', L'_' });
+            ranges.push_back({ L'a', L'z' });
+        }
+
+        static void appendSpace(std::vector<Range>& ranges) {
+            ranges.push_back({ L'\t', L'\r' });
+            ranges.push_back({ L' ', L' ' });
+        }
+
+        static std::vector<Range> normalize(std::vector<Range> ranges) {
+            std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) { return a.lo < b.lo; });
+            std::vector<Range> merged;
+            for (const Range& r : ranges) {
+                if (!merged.empty() && r.lo <= merged.back().hi + 1) {
+                    merged.back().hi = (std::max)(merged.back().hi, r.hi);
+                } else {
+                    merged.push_back(r);
+                }
+            }
+            return merged;
+        }
+
+        static std::vector<Range> complement(const std::vector<Range>& ranges) {
+            std::vector<Range> result;
+            uint32_t next = 0;
+            for (const Range& r : ranges) {
+                if (r.lo > next) result.push_back({ next, r.lo - 1 });
+                next = r.hi + 1;
+            }
+            if (next <= MAX_CHAR) result.push_back({ next, MAX_CHAR });
+            return result;
+        }
+
+        std::vector<Range> foldCase(std::vector<Range> ranges) const {
+            if (!m_icase) return ranges;
+            size_t count = ranges.size();
+            for (size_t n = 0; n < count; ++n) {
+                Range r = ranges[n];
+                uint32_t lo = (std::max)(r.lo, uint32_t(L'A')), hi = (std::min)(r.hi, uint32_t(L'Z'));
+                if (lo <= hi) ranges.push_back({ lo + 32, hi + 32 });
+                lo = (std::max)(r.lo, uint32_t(L'a'));
+                hi = (std::min)(r.hi, uint32_t(L'z'));
+                if (lo <= hi) ranges.push_back({ lo - 32, hi - 32 });
+            }
+            return ranges;
+        }
+
+        bool setNode(Node& node, std::vector<Range> ranges, bool fold = true) {
+            node.kind = Node::SET;
+            node.set = static_cast<uint32_t>(m_re.m_sets.size());
+            m_re.m_sets.push_back(fold ? normalize(foldCase(std::move(ranges))) : std::move(ranges));
+            return true;
+        }
+
+        // ---- 生成NFA ----
+
+        int32_t newState(RegexSet::NfaKind kind, uint32_t arg = 0, int32_t out = -1, int32_t out1 = -1) {
+            m_re.m_nfa.push_back(RegexSet::NfaState{ kind, out, out1, arg });
+            return static_cast<int32_t>(m_re.m_nfa.size() - 1);
+        }
+
+        void patch(const std::vector<Patch>& outs, int32_t target) {
+            for (const Patch& p : outs) {
+                if (p.second) m_re.m_nfa[p.state].out1 = target;
+                else m_re.m_nfa[p.state].out = target;
+            }
+        }
+
+        // 任意字符的循环，之后转到next；返回循环入口
+        int32_t anyLoop(int32_t next) {
+            if (m_anySet < 0) {
+                m_anySet = static_cast<int32_t>(m_re.m_sets.size());
+                m_re.m_sets.push_back({ { 0, MAX_CHAR } });
+            }
+            int32_t split = newState(RegexSet::NFA_SPLIT, 0, -1, next);
+            int32_t any = newState(RegexSet::NFA_CHARS, static_cast<uint32_t>(m_anySet), split);
+            m_re.m_nfa[split].out = any;
+            return split;
+        }
+
+        bool build(const Node& node, Frag& frag) {
+            if (m_re.m_nfa.size() > MAX_NFA_STATES) {
+                return fail(L"模式过大");
+            }
+
+            switch (node.kind) {
+            case Node::SET: {
+                int32_t s = newState(RegexSet::NFA_CHARS, node.set);
+                frag = Frag{ s, { { s, false } } };
+                return true;
+            }
+            case Node::EMPTY: {
+                int32_t s = newState(RegexSet::NFA_EMPTY);
+                frag = Frag{ s, { { s, false } } };
+                return true;
+            }
+            case Node::CAT: {
+                if (!build(node.children[0], frag)) return false;
+                for (size_t n = 1; n < node.children.size(); ++n) {
+                    Frag next;
+                    if (!build(node.children[n], next)) return false;
+                    patch(frag.outs, next.start);
+                    frag.outs = std::move(next.outs);
+                }
+                return true;
+            }
+            case Node::ALT: {
+                if (!build(node.children.back(), frag)) return false;
+                for (size_t n = node.children.size() - 1; n-- > 0; ) {
+                    Frag branch;
+                    if (!build(node.children[n], branch)) return false;
+                    int32_t split = newState(RegexSet::NFA_SPLIT, 0, branch.start, frag.start);
+                    branch.outs.insert(branch.outs.end(), frag.outs.begin(), frag.outs.end());
+                    frag = Frag{ split, std::move(branch.outs) };
+                }
+                return true;
+            }
+            case Node::REPEAT: {
+                const Node& child = node.children[0];
+                int32_t s = newState(RegexSet::NFA_EMPTY);
+                frag = Frag{ s, { { s, false } } };
+
+                // 必需的min次
+                for (int n = 0; n < node.min; ++n) {
+                    Frag copy;
+                    if (!build(child, copy)) return false;
+                    patch(frag.outs, copy.start);
+                    frag.outs = std::move(copy.outs);
+                }
+
+                if (node.max < 0) {
+                    // 之后任意次
+                    Frag copy;
+                    if (!build(child, copy)) return false;
+                    int32_t split = newState(RegexSet::NFA_SPLIT, 0, copy.start, -1);
+                    patch(copy.outs, split);
+                    patch(frag.outs, split);
+                    frag.outs = { { split, true } };
+                } else {
+                    // 之后最多max-min次可选
+                    for (int n = node.min; n < node.max; ++n) {
+                        Frag copy;
+                        if (!build(child, copy)) return false;
+                        int32_t split = newState(RegexSet::NFA_SPLIT, 0, copy.start, -1);
+                        patch(frag.outs, split);
+                        copy.outs.push_back({ split, true });
+                        frag.outs = std::move(copy.outs);
+                    }
+                }
+                return true;
+            }
+            }
+            return false;
+        }
+
+        RegexSet& m_re;
+        const wchar_t* m_pos;
+        const wchar_t* m_end;
+        bool m_icase = false;
+        int m_depth = 0;                // 当前分组嵌套深度
+        int32_t m_anySet = -1;
+        std::wstring m_error;
+    };
+
+    size_t RegexSet::StateHash::operator()(const std::vector<int32_t>& v) const {
+        size_t h = 14695981039346656037ULL & SIZE_MAX;
+        for (int32_t s : v) {
+            h = (h ^ static_cast<uint32_t>(s)) * (1099511628211ULL & SIZE_MAX);
+        }
+        return h;
+    }
+
+    RegexSet::RegexSet(size_t memoryBudget) : m_budget(memoryBudget) {
+    }
+
+    void RegexSet::clear() {
+        m_nfa.clear();
+        m_sets.clear();
+        m_starts.clear();
+        m_prepared = false;
+        resetCache();
+    }
+
+    size_t RegexSet::add(std::wstring_view pattern, std::wstring* error) {
+        std::wstring message;
+        RegexCompiler compiler(*this, pattern);
+        if (!compiler.compile(static_cast<uint32_t>(m_starts.size()), message)) {
+            if (error) *error = message;
+            return npos;
+        }
+
+        // 新模式改变了等价类和状态集合，缓存作废
+        m_prepared = false;
+        resetCache();
+        return m_starts.size() - 1;
+    }
+
+    void RegexSet::prepare() {
+        // 所有字符集的边界把字符空间切成等价类，同一类中的字符对所有字符集的归属相同
+        m_bounds.clear();
+        for (const std::vector<Range>& set : m_sets) {
+            for (const Range& r : set) {
+                if (r.lo > 0) m_bounds.push_back(r.lo);
+                if (r.hi < MAX_CHAR) m_bounds.push_back(r.hi + 1);
+            }
+        }
+        std::sort(m_bounds.begin(), m_bounds.end());
+        m_bounds.erase(std::unique(m_bounds.begin(), m_bounds.end()), m_bounds.end());
+        m_classCount = m_bounds.size() + 1;
+        m_classWords = (m_classCount + 63) / 64;
+
+        m_lowClasses.resize(256);
+        for (uint32_t c = 0; c < 256; ++c) {
+            m_lowClasses[c] = static_cast<uint32_t>(std::upper_bound(m_bounds.begin(), m_bounds.end(), c) - m_bounds.begin());
+        }
+
+        m_setClasses.assign(m_sets.size() * m_classWords, 0);
+        for (size_t s = 0; s < m_sets.size(); ++s) {
+            const std::vector<Range>& set = m_sets[s];
+            for (size_t k = 0; k < m_classCount; ++k) {
+                uint32_t c = k == 0 ? 0 : m_bounds[k - 1];
+                auto it = std::upper_bound(set.begin(), set.end(), c, [](uint32_t value, const Range& r) { return value < r.lo; });
+                if (it != set.begin() && c <= (it - 1)->hi) {
+                    m_setClasses[s * m_classWords + k / 64] |= uint64_t(1) << (k % 64);
+                }
+            }
+        }
+
+        m_marks.assign(m_nfa.size(), 0);
+        m_stamp = 0;
+        m_prepared = true;
+    }
+
+    uint32_t RegexSet::classOf(uint32_t c) const {
+        if (c < 256) return m_lowClasses[c];
+        return static_cast<uint32_t>(std::upper_bound(m_bounds.begin(), m_bounds.end(), c) - m_bounds.begin());
+    }
+
+    void RegexSet::closure(const int32_t* seeds, size_t count, std::vector<int32_t>& result) {
+        result.clear();
+        if (++m_stamp == 0) {
+            std::fill(m_marks.begin(), m_marks.end(), 0);
+            m_stamp = 1;
+        }
+
+        m_stack.assign(seeds, seeds + count);
+        while (!m_stack.empty()) {
+            int32_t s = m_stack.back();
+            m_stack.pop_back();
+            if (s < 0 || m_marks[s] == m_stamp) continue;
+            m_marks[s] = m_stamp;
+
+            const NfaState& state = m_nfa[s];
+            switch (state.kind) {
+            case NFA_CHARS:
+            case NFA_MATCH:
+                result.push_back(s);
+                break;
+            case NFA_SPLIT:
+                m_stack.push_back(state.out1);
+                m_stack.push_back(state.out);
+                break;
+            case NFA_EMPTY:
+                m_stack.push_back(state.out);
+                break;
+            }
+        }
+        std::sort(result.begin(), result.end());
+    }
+
+    void RegexSet::resetCache() {
+        m_stateIndex.clear();
+        m_states.clear();
+        m_trans.clear();
+        m_accepts.clear();
+        m_initial = -1;
+        m_memory = 0;
+    }
+
+    int32_t RegexSet::stateFor(const std::vector<int32_t>& nfa) {
+        auto it = m_stateIndex.find(nfa);
+        if (it != m_stateIndex.end()) {
+            return it->second;
+        }
+
+        size_t words = (m_starts.size() + 63) / 64;
+        size_t cost = STATE_OVERHEAD + nfa.size() * sizeof(int32_t)
+            + m_classCount * sizeof(int32_t) + words * sizeof(uint64_t);
+        if (!m_states.empty() && m_memory + cost > m_budget) {
+            // 超出预算：丢弃所有状态，从当前状态重新开始构造
+            resetCache();
+            ++m_stats.cacheResets;
+        }
+
+        int32_t id = static_cast<int32_t>(m_states.size());
+        auto inserted = m_stateIndex.emplace(nfa, id).first;
+        m_states.push_back(DfaState{ &inserted->first, nfa.empty() });
+        m_trans.resize(m_trans.size() + m_classCount, -1);
+        m_accepts.resize(m_accepts.size() + words, 0);
+        for (int32_t s : nfa) {
+            if (m_nfa[s].kind == NFA_MATCH) {
+                uint32_t pattern = m_nfa[s].arg;
+                m_accepts[id * words + pattern / 64] |= uint64_t(1) << (pattern % 64);
+            }
+        }
+        m_memory += cost;
+        ++m_stats.statesBuilt;
+        return id;
+    }
+
+    int32_t RegexSet::step(int32_t s, uint32_t cls) {
+        m_seeds.clear();
+        for (int32_t n : *m_states[s].nfa) {
+            const NfaState& state = m_nfa[n];
+            if (state.kind == NFA_CHARS
+                && (m_setClasses[state.arg * m_classWords + cls / 64] >> (cls % 64)) & 1) {
+                m_seeds.push_back(state.out);
+            }
+        }
+        closure(m_seeds.data(), m_seeds.size(), m_next);
+
+        size_t resets = m_stats.cacheResets;
+        int32_t next = stateFor(m_next);
+        // 清空缓存后s已不存在，不记录这次转移
+        if (m_stats.cacheResets == resets) {
+            m_trans[s * m_classCount + cls] = next;
+        }
+        return next;
+    }
+
+    void RegexSet::match(std::wstring_view text, std::vector<uint64_t>& matched) {
+        size_t words = (m_starts.size() + 63) / 64;
+        matched.assign(words, 0);
+        ++m_stats.matches;
+        if (m_starts.empty()) return;
+
+        if (!m_prepared) {
+            prepare();
+        }
+        if (m_initial < 0) {
+            closure(m_starts.data(), m_starts.size(), m_next);
+            m_initial = stateFor(m_next);
+        }
+
+        int32_t s = m_initial;
+        for (wchar_t ch : text) {
+            if (m_states[s].dead) break;
+            uint32_t cls = classOf(unit(ch));
+            int32_t next = m_trans[s * m_classCount + cls];
+            s = next >= 0 ? next : step(s, cls);
+        }
+
+        for (size_t w = 0; w < words; ++w) {
+            matched[w] = m_accepts[s * words + w];
+        }
+    }
+
+    RegexSet::Stats RegexSet::getStats() const {
+        Stats stats = m_stats;
+        stats.states = m_states.size();
+        stats.memory = m_memory;
+        return stats;
+    }
+
+} // namespace Foundation
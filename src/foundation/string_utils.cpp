@@ -1,5 +1,6 @@
 #include "core/stdafx.h"
 #include "foundation/string_utils.h"
+#include "foundation/utf_transcoder.h"
 #include <algorithm>
 
 namespace Foundation {
@@ -55,37 +56,25 @@ bool wildcardMatch(const wchar_t* pattern, const wchar_t* str)
 }
 
 // UTF-8 转换函数
+// 由Utf转码器一次完成，不再先查询长度再转换
 std::wstring utf8ToWide(const std::string& utf8Str) {
-    if (utf8Str.empty()) {
-        return std::wstring();
-    }
-    
-    int wideSize = MultiByteToWideChar(CP_UTF8, 0, utf8Str.c_str(), -1, NULL, 0);
-    if (wideSize <= 0) {
-        return std::wstring();
-    }
-    
-    std::wstring wideStr(wideSize - 1, 0);
-    MultiByteToWideChar(CP_UTF8, 0, utf8Str.c_str(), -1, &wideStr[0], wideSize);
-    
+    std::wstring wideStr;
+    Utf::appendWide(wideStr, utf8Str.data(), utf8Str.size());
     return wideStr;
 }
 
 std::string wideToUtf8(const std::wstring& wideStr) {
-    if (wideStr.empty()) {
-        return std::string();
-    }
-    
-    int utf8Size = WideCharToMultiByte(CP_UTF8, 0, wideStr.c_str(), -1, NULL, 0, NULL, NULL);
-    if (utf8Size <= 0) {
-        return std::string();
-    }
-    
-    std::string utf8Str(utf8Size - 1, 0);
-    WideCharToMultiByte(CP_UTF8, 0, wideStr.c_str(), -1, &utf8Str[0], utf8Size, NULL, NULL);
-    
+    std::string utf8Str;
+    Utf::appendUtf8(utf8Str, wideStr.data(), wideStr.size());
     return utf8Str;
 }
 
+// 句柄按十六进制输出，与调试工具（如Spy++）中的显示一致
+std::wstring handleToHex(const void* handle) {
+    wchar_t buffer[2 + 2 * sizeof(uintptr_t) + 1];
+    swprintf_s(buffer, L"0x%IX", reinterpret_cast<uintptr_t>(handle));
+    return buffer;
+}
+
 } // namespace StringUtils
 } // namespace Foundation
\ No newline at end of file
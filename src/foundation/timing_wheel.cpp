@@ -0,0 +1,141 @@
+#include "core/stdafx.h"
+#include "foundation/timing_wheel.h"
+#include <algorithm>
+
+namespace Foundation {
+
+    unsigned TimingWheel::add(uint64_t interval, uint64_t now) {
+        if (m_count == 0) {
+            // 时间轮为空时直接从当前刻度开始，无需补走空闲期间的刻度
+            m_current = now;
+        }
+
+        unsigned index;
+        if (!m_free.empty()) {
+            index = m_free.back();
+            m_free.pop_back();
+        } else {
+            index = static_cast<unsigned>(m_entries.size());
+            m_entries.push_back(Entry{});
+        }
+        m_entries[index].active = true;
+        ++m_count;
+
+        reschedule(index, interval, now);
+        return index;
+    }
+
+    void TimingWheel::reschedule(unsigned id, uint64_t interval, uint64_t now) {
+        if (!contains(id)) {
+            return;
+        }
+        Entry& e = m_entries[id];
+        e.interval = (std::max)(interval, uint64_t(1));
+        e.deadline = now + e.interval;
+        ++e.epoch;
+        insert(id);
+    }
+
+    void TimingWheel::remove(unsigned id) {
+        if (!contains(id)) {
+            return;
+        }
+        // 时间轮中的记录因epoch不匹配而失效，无需查找删除
+        Entry& e = m_entries[id];
+        e.active = false;
+        ++e.epoch;
+        m_free.push_back(id);
+        --m_count;
+    }
+
+    void TimingWheel::insert(unsigned index) {
+        const Entry& e = m_entries[index];
+        Slot slot = { index, e.epoch };
+
+        // 级联时到期刻度可能等于当前刻度，此时放入当前格子，由advance随后处理
+        uint64_t t = (std::max)(e.deadline, m_current);
+        if (t - m_current < WHEEL_SIZE) {
+            m_wheel[0][t & WHEEL_MASK].push_back(slot);
+            return;
+        }
+
+        // 超出第二级范围的放在最远的一格，级联时会重新计算
+        uint64_t round = (std::min)(t >> WHEEL_BITS, (m_current >> WHEEL_BITS) + WHEEL_MASK);
+        m_wheel[1][round & WHEEL_MASK].push_back(slot);
+    }
+
+    void TimingWheel::advance(uint64_t target, std::vector<Slot>& due) {
+        if (target <= m_current) {
+            return;
+        }
+
+        // 长时间未处理（如系统休眠）时所有项都已过期，直接全部到期
+        if (target - m_current >= WHEEL_SIZE * WHEEL_SIZE) {
+            for (auto& level : m_wheel) {
+                for (auto& bucket : level) {
+                    bucket.clear();
+                }
+            }
+            for (unsigned index = 0; index < m_entries.size(); ++index) {
+                if (m_entries[index].active) {
+                    due.push_back(Slot{ index, m_entries[index].epoch });
+                }
+            }
+            m_current = target;
+            return;
+        }
+
+        while (m_current < target) {
+            ++m_current;
+
+            // 进入第一级的新一圈：把第二级对应格子中的项下放到第一级
+            if ((m_current & WHEEL_MASK) == 0) {
+                std::vector<Slot> cascade;
+                cascade.swap(m_wheel[1][(m_current >> WHEEL_BITS) & WHEEL_MASK]);
+                for (const Slot& slot : cascade) {
+                    if (isCurrent(slot)) {
+                        insert(slot.index);
+                    }
+                }
+            }
+
+            std::vector<Slot>& bucket = m_wheel[0][m_current & WHEEL_MASK];
+            for (const Slot& slot : bucket) {
+                if (isCurrent(slot)) {
+                    due.push_back(slot);
+                }
+            }
+            bucket.clear();
+        }
+    }
+
+    uint64_t TimingWheel::nextDeadline() const {
+        if (m_count == 0) {
+            return 0;
+        }
+
+        // 第一级中最近的非空格子
+        uint64_t next = 0;
+        for (uint64_t t = m_current + 1; t < m_current + WHEEL_SIZE; ++t) {
+            if (!m_wheel[0][t & WHEEL_MASK].empty()) {
+                next = t;
+                break;
+            }
+        }
+
+        // 第二级中最近的非空格子，需要在它级联的那一圈开始时推进
+        uint64_t round = m_current >> WHEEL_BITS;
+        for (uint64_t r = round + 1; r <= round + WHEEL_SIZE; ++r) {
+            if (!m_wheel[1][r & WHEEL_MASK].empty()) {
+                uint64_t t = r << WHEEL_BITS;
+                if (!next || t < next) {
+                    next = t;
+                }
+                break;
+            }
+        }
+
+        return next ? next : m_current + 1;
+    }
+
+} // namespace Foundation
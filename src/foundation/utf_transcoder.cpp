@@ -0,0 +1,201 @@
+#include "core/stdafx.h"
+#include "foundation/utf_transcoder.h"
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define UTF_HAVE_SSE2 1
+#endif
+
+namespace Foundation {
+namespace Utf {
+
+namespace {
+    constexpr bool WIDE_IS_UTF16 = sizeof(wchar_t) == 2;
+    constexpr uint64_t HIGH_BITS = 0x8080808080808080ULL;
+
+    // 宽字符的无符号值（Linux上wchar_t有符号）
+    inline uint32_t unit(wchar_t c) {
+        return WIDE_IS_UTF16 ? static_cast<uint16_t>(c) : static_cast<uint32_t>(c);
+    }
+
+    inline wchar_t* putWide(wchar_t* dst, char32_t cp) {
+        if (WIDE_IS_UTF16 && cp > 0xFFFF) {
+            cp -= 0x10000;
+            *dst++ = static_cast<wchar_t>(0xD800 + (cp >> 10));
+            *dst++ = static_cast<wchar_t>(0xDC00 + (cp & 0x3FF));
+        } else {
+            *dst++ = static_cast<wchar_t>(cp);
+        }
+        return dst;
+    }
+
+    inline char* putUtf8(char* dst, char32_t cp) {
+        if (cp < 0x80) {
+            *dst++ = static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            *dst++ = static_cast<char>(0xC0 | (cp >> 6));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            *dst++ = static_cast<char>(0xE0 | (cp >> 12));
+            *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            *dst++ = static_cast<char>(0xF0 | (cp >> 18));
+            *dst++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        return dst;
+    }
+
+    // 解码src开头的一个非ASCII字符，返回消耗的字节数（至少为1）。
+    // 无效序列按最长有效前缀整体替换为U+FFFD（Unicode推荐的做法）
+    size_t decodeOne(const unsigned char* src, size_t length, char32_t& cp) {
+        unsigned char lead = src[0];
+        size_t need;
+        unsigned char lo = 0x80, hi = 0xBF;    // 第一个后续字节的有效范围，用于排除超长编码和代理项
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            need = 1;
+            cp = lead & 0x1F;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            need = 2;
+            cp = lead & 0x0F;
+            if (lead == 0xE0) lo = 0xA0;
+            else if (lead == 0xED) hi = 0x9F;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            need = 3;
+            cp = lead & 0x07;
+            if (lead == 0xF0) lo = 0x90;
+            else if (lead == 0xF4) hi = 0x8F;
+        } else {
+            // 后续字节、C0/C1超长前导字节或F5以上
+            cp = REPLACEMENT_CHAR;
+            return 1;
+        }
+
+        for (size_t k = 1; k <= need; ++k) {
+            if (k >= length || src[k] < lo || src[k] > hi) {
+                cp = REPLACEMENT_CHAR;
+                return k;
+            }
+            cp = (cp << 6) | (src[k] & 0x3F);
+            lo = 0x80;
+            hi = 0xBF;
+        }
+        return need + 1;
+    }
+
+    // 复制开头连续的ASCII字节，返回复制的个数
+    size_t copyAsciiToWide(const unsigned char* src, size_t length, wchar_t* dst) {
+        size_t i = 0;
+#ifdef UTF_HAVE_SSE2
+        if (WIDE_IS_UTF16) {
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 16 <= length; i += 16) {
+                __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                if (_mm_movemask_epi8(bytes)) break;
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi8(bytes, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpackhi_epi8(bytes, zero));
+            }
+        }
+#endif
+        for (; i + 8 <= length; i += 8) {
+            uint64_t word;
+            memcpy(&word, src + i, sizeof(word));
+            if (word & HIGH_BITS) break;
+            for (size_t k = 0; k < 8; ++k) {
+                dst[i + k] = static_cast<wchar_t>(src[i + k]);
+            }
+        }
+        while (i < length && src[i] < 0x80) {
+            dst[i] = static_cast<wchar_t>(src[i]);
+            ++i;
+        }
+        return i;
+    }
+
+    size_t copyAsciiToUtf8(const wchar_t* src, size_t length, char* dst) {
+        size_t i = 0;
+#ifdef UTF_HAVE_SSE2
+        if (WIDE_IS_UTF16) {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i nonAscii = _mm_set1_epi16(static_cast<short>(0xFF80));
+            for (; i + 16 <= length; i += 16) {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+                __m128i high = _mm_and_si128(_mm_or_si128(a, b), nonAscii);
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) != 0xFFFF) break;
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(a, b));
+            }
+        }
+#endif
+        while (i < length && unit(src[i]) < 0x80) {
+            dst[i] = static_cast<char>(src[i]);
+            ++i;
+        }
+        return i;
+    }
+}
+
+size_t utf8ToWide(const char* src, size_t length, wchar_t* dst) {
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(src);
+    wchar_t* out = dst;
+    size_t i = 0;
+    while (i < length) {
+        size_t ascii = copyAsciiToWide(s + i, length - i, out);
+        i += ascii;
+        out += ascii;
+
+        // 非ASCII字符逐个解码，遇到下一个ASCII字节时回到块处理
+        while (i < length && s[i] >= 0x80) {
+            char32_t cp;
+            i += decodeOne(s + i, length - i, cp);
+            out = putWide(out, cp);
+        }
+    }
+    return static_cast<size_t>(out - dst);
+}
+
+size_t wideToUtf8(const wchar_t* src, size_t length, char* dst) {
+    char* out = dst;
+    size_t i = 0;
+    while (i < length) {
+        size_t ascii = copyAsciiToUtf8(src + i, length - i, out);
+        i += ascii;
+        out += ascii;
+
+        while (i < length && unit(src[i]) >= 0x80) {
+            char32_t cp = unit(src[i++]);
+            if (WIDE_IS_UTF16) {
+                if (cp >= 0xD800 && cp <= 0xDBFF && i < length
+                    && unit(src[i]) >= 0xDC00 && unit(src[i]) <= 0xDFFF) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (unit(src[i++]) - 0xDC00);
+                } else if (cp >= 0xD800 && cp <= 0xDFFF) {
+                    cp = REPLACEMENT_CHAR;     // 孤立的代理项
+                }
+            } else if ((cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF) {
+                cp = REPLACEMENT_CHAR;
+            }
+            out = putUtf8(out, cp);
+        }
+    }
+    return static_cast<size_t>(out - dst);
+}
+
+void appendWide(std::wstring& out, const char* src, size_t length) {
+    // 按最坏情况预留后截断，只遍历一次输入
+    size_t old = out.size();
+    out.resize(old + maxWideLength(length));
+    out.resize(old + utf8ToWide(src, length, &out[0] + old));
+}
+
+void appendUtf8(std::string& out, const wchar_t* src, size_t length) {
+    size_t old = out.size();
+    out.resize(old + maxUtf8Length(length));
+    out.resize(old + wideToUtf8(src, length, &out[0] + old));
+}
+
+} // namespace Utf
+} // namespace Foundation
@@ -13,11 +13,13 @@ namespace {
     using SetProcessDpiAwareness_t = HRESULT(WINAPI*)(int);
     using GetDpiForWindow_t = UINT(WINAPI*)(HWND);
     using GetDpiForSystem_t = UINT(WINAPI*)(void);
+    using GetDpiForMonitor_t = HRESULT(WINAPI*)(HMONITOR, int, UINT*, UINT*);
     
     SetProcessDpiAwarenessContext_t SetProcessDpiAwarenessContext_ = nullptr;
     SetProcessDpiAwareness_t SetProcessDpiAwareness_ = nullptr;
     GetDpiForWindow_t GetDpiForWindow_ = nullptr;
     GetDpiForSystem_t GetDpiForSystem_ = nullptr;
+    GetDpiForMonitor_t GetDpiForMonitor_ = nullptr;
     
     HMODULE user32Dll_ = nullptr;
     HMODULE shcoreDll_ = nullptr;
@@ -42,6 +44,8 @@ namespace {
         if (shcoreDll_) {
             SetProcessDpiAwareness_ = libraryManager_.getProcAddress<SetProcessDpiAwareness_t>(
                 shcoreDll_, "SetProcessDpiAwareness");
+            GetDpiForMonitor_ = libraryManager_.getProcAddress<GetDpiForMonitor_t>(
+                shcoreDll_, "GetDpiForMonitor");
         }
         
         initialized_ = true;
@@ -82,6 +86,17 @@ int getDpiForWindow(HWND hwnd) {
     return getSystemDpi();
 }
 
+int getDpiForMonitor(HMONITOR monitor) {
+    loadDpiApis();
+    
+    UINT dpiX = 0, dpiY = 0;
+    if (GetDpiForMonitor_ && monitor
+        && SUCCEEDED(GetDpiForMonitor_(monitor, 0, &dpiX, &dpiY))) { // MDT_EFFECTIVE_DPI = 0
+        return static_cast<int>(dpiX);
+    }
+    return getSystemDpi();
+}
+
 int getSystemDpi() {
     loadDpiApis();
     
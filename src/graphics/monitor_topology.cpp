@@ -0,0 +1,77 @@
+#include "core/stdafx.h"
+#include "graphics/monitor_topology.h"
+#include "graphics/dpi_manager.h"
+#include "system/logger.h"
+#include <vector>
+
+namespace Graphics {
+
+    namespace {
+        Foundation::MonitorLayout::Rect toLayoutRect(const RECT& rc) {
+            return Foundation::MonitorLayout::Rect{ rc.left, rc.top, rc.right, rc.bottom };
+        }
+
+        RECT fromLayoutRect(const Foundation::MonitorLayout::Rect& rc) {
+            return RECT{ rc.left, rc.top, rc.right, rc.bottom };
+        }
+    }
+
+    MonitorTopology& MonitorTopology::getInstance() {
+        static MonitorTopology instance;
+        return instance;
+    }
+
+    BOOL CALLBACK MonitorTopology::enumMonitorProc(HMONITOR monitor, HDC, LPRECT, LPARAM param) {
+        auto* monitors = reinterpret_cast<std::vector<Foundation::MonitorLayout::Monitor>*>(param);
+
+        MONITORINFO mi = { sizeof(mi) };
+        if (GetMonitorInfo(monitor, &mi)) {
+            monitors->push_back(Foundation::MonitorLayout::Monitor{
+                reinterpret_cast<uintptr_t>(monitor),
+                toLayoutRect(mi.rcMonitor),
+                toLayoutRect(mi.rcWork),
+                DpiManager::getDpiForMonitor(monitor) });
+        }
+        return TRUE;
+    }
+
+    void MonitorTopology::ensureValid() {
+        if (m_valid) return;
+
+        std::vector<Foundation::MonitorLayout::Monitor> monitors;
+        EnumDisplayMonitors(nullptr, nullptr, enumMonitorProc, reinterpret_cast<LPARAM>(&monitors));
+        m_layout.assign(std::move(monitors));
+        m_valid = true;
+
+        LOG_DEBUG(L"显示器拓扑已更新: " + std::to_wstring(m_layout.monitors().size()) + L" 个显示器");
+    }
+
+    const Foundation::MonitorLayout::Monitor* MonitorTopology::find(const RECT& rc) {
+        ensureValid();
+        size_t index = m_layout.fromRect(toLayoutRect(rc));
+        return index != Foundation::MonitorLayout::npos ? &m_layout.monitors()[index] : nullptr;
+    }
+
+    HMONITOR MonitorTopology::monitorFromRect(const RECT& rc) {
+        const Foundation::MonitorLayout::Monitor* monitor = find(rc);
+        return monitor ? reinterpret_cast<HMONITOR>(monitor->id) : nullptr;
+    }
+
+    bool MonitorTopology::workAreaFromRect(const RECT& rc, RECT& workArea) {
+        const Foundation::MonitorLayout::Monitor* monitor = find(rc);
+        if (!monitor) return false;
+        workArea = fromLayoutRect(monitor->workArea);
+        return true;
+    }
+
+    int MonitorTopology::dpiFromRect(const RECT& rc) {
+        const Foundation::MonitorLayout::Monitor* monitor = find(rc);
+        return monitor ? monitor->dpi : DpiManager::getSystemDpi();
+    }
+
+    size_t MonitorTopology::monitorCount() {
+        ensureValid();
+        return m_layout.monitors().size();
+    }
+
+} // namespace Graphics
@@ -0,0 +1,137 @@
+#include "core/stdafx.h"
+#include "options/auto_pin_matcher.h"
+#include "options/options.h"
+#include "system/logger.h"
+#include "foundation/string_utils.h"
+
+
+size_t
+AutoPinMatcher::compile(const std::vector<AutoPinRule>& rules)
+{
+    m_globRules.clear();
+    m_globClasses.clear();
+    m_regexRules.clear();
+    m_titles.clear();
+    m_classes.clear();
+
+    size_t invalid = 0;
+    for (const AutoPinRule& rule : rules) {
+        if (!rule.enabled) {
+            continue;
+        }
+        if (!rule.regex) {
+            bool literal = !rule.cls.empty() && rule.cls.find_first_of(L"*?") == std::wstring::npos;
+            m_globRules.push_back(rule);
+            m_globClasses.push_back(literal ? Window::ClassRegistry::getInstance().intern(rule.cls)
+                                            : Window::ClassRegistry::CLASS_UNKNOWN);
+            continue;
+        }
+
+        // 类名模式无效时已加入的标题模式留在集合中，不被任何规则引用
+        std::wstring error;
+        size_t title = m_titles.add(rule.ttl, &error);
+        size_t cls = title == Foundation::RegexSet::npos ? title : m_classes.add(rule.cls, &error);
+        if (cls == Foundation::RegexSet::npos) {
+            LOG_WARNING(L"自动图钉规则\"" + rule.descr + L"\"的正则表达式无效: " + error);
+            ++invalid;
+            continue;
+        }
+        m_regexRules.push_back({ title, cls });
+    }
+    return invalid;
+}
+
+
+bool
+AutoPinMatcher::match(HWND wnd) const
+{
+    // 预筛选：类ID（不区分大小写）不同的规则一定不匹配，不必再获取类名和标题。
+    // 窗口的类ID只查询一次，所有规则共用
+    Window::ClassId wndClass = Window::ClassRegistry::CLASS_UNKNOWN;
+    bool classLooked = false;
+    for (size_t n = 0; n < m_globRules.size(); ++n) {
+        Window::ClassId ruleClass = m_globClasses[n];
+        if (ruleClass != Window::ClassRegistry::CLASS_UNKNOWN) {
+            if (!classLooked) {
+                wndClass = Window::ClassRegistry::getInstance().classOf(wnd);
+                classLooked = true;
+            }
+            if (wndClass != ruleClass) {
+                continue;
+            }
+        }
+        if (m_globRules[n].match(wnd)) {
+            return true;
+        }
+    }
+
+    if (m_regexRules.empty()) {
+        return false;
+    }
+
+    // 所有正则规则共用一次类名和标题的获取，各扫描一遍
+    Window::WndHelper helper(wnd);
+    m_classes.match(helper.getClassName().view(), m_classHits);
+
+    bool anyClass = false;
+    for (const RegexRule& rule : m_regexRules) {
+        if (Foundation::RegexSet::isSet(m_classHits, rule.cls)) {
+            anyClass = true;
+            break;
+        }
+    }
+
+    bool matched = false;
+    if (anyClass) {
+        m_titles.match(helper.getText().view(), m_titleHits);
+        for (const RegexRule& rule : m_regexRules) {
+            if (Foundation::RegexSet::isSet(m_classHits, rule.cls) &&
+                Foundation::RegexSet::isSet(m_titleHits, rule.title)) {
+                matched = true;
+                break;
+            }
+        }
+    }
+
+    reportStats();
+    return matched;
+}
+
+
+bool
+AutoPinMatcher::matchClass(HWND wnd) const
+{
+    Window::WindowClassName className = Window::WndHelper(wnd).getClassName();
+    for (const AutoPinRule& rule : m_globRules) {
+        if (rule.cls == L"*" || Foundation::StringUtils::wildcardMatch(rule.cls.c_str(), className.c_str())) {
+            return true;
+        }
+    }
+
+    if (m_regexRules.empty()) {
+        return false;
+    }
+
+    m_classes.match(className.view(), m_classHits);
+    for (const RegexRule& rule : m_regexRules) {
+        if (Foundation::RegexSet::isSet(m_classHits, rule.cls)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+void
+AutoPinMatcher::reportStats() const
+{
+    Foundation::RegexSet::Stats classes = m_classes.getStats();
+    m_statsReporter.update(GetTickCount(), classes.matches, [&](size_t matches, size_t reported, DWORD) {
+        Foundation::RegexSet::Stats titles = m_titles.getStats();
+        LOG_DEBUG(L"自动图钉正则: 匹配 " + std::to_wstring(matches - reported) +
+                  L" 个窗口, DFA状态 " + std::to_wstring(titles.states) + L"/" + std::to_wstring(classes.states) +
+                  L", 内存 " + std::to_wstring((titles.memory + classes.memory) / 1024) +
+                  L" KB, 缓存清空 " + std::to_wstring(titles.cacheResets + classes.cacheResets) + L" 次");
+        return true;
+    });
+}
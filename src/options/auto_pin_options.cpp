@@ -156,12 +156,12 @@ namespace {
 
                         if (tracking == 1) {
                             Window::WndHelper w(GetDlgItem(wnd, IDC_TITLE));
-                            w.setText(Window::WndHelper(hitWnd).getText());
+                            w.setText(Window::WndHelper(hitWnd).getText().str());
                             w.update();
                         }
                         else {
                             Window::WndHelper w(GetDlgItem(wnd, IDC_CLASS));
-                            w.setText(Window::WndHelper(hitWnd).getClassName());
+                            w.setText(Window::WndHelper(hitWnd).getClassName().str());
                             w.update();
                         }
 
@@ -652,6 +652,7 @@ void OptAutoPin::apply(HWND wnd, WindowCreationMonitor& winCreMon)
         KillTimer(app.mainWnd, App::TIMERID_AUTOPIN);
 
     rlist.getAll(opt.autoPinRules);
+    opt.autoPinMatcher.compile(opt.autoPinRules);
     
     // 立即保存设置到INI文件
     opt.saveImmediately();
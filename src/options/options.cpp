@@ -61,15 +61,18 @@ AutoPinRule::match(HWND wnd) const
     }
         
     // 使用WndHelper获取窗口信息
+    // 标题和类名保存在栈上，匹配过程不分配堆内存；模式为"*"时不必获取
     Window::WndHelper helper(wnd);
-    std::wstring windowTitle = helper.getText();
-    std::wstring className = helper.getClassName();
     
-    // 使用简单的通配符匹配
-    bool titleMatch = Foundation::StringUtils::wildcardMatch(ttl.c_str(), windowTitle.c_str());
-        bool classMatch = Foundation::StringUtils::wildcardMatch(cls.c_str(), className.c_str());
+    // 使用简单的通配符匹配，先匹配代价较小的类名
+    bool classMatch = cls == L"*" ||
+        Foundation::StringUtils::wildcardMatch(cls.c_str(), helper.getClassName().c_str());
+    if (!classMatch) {
+        return false;
+    }
     
-    return titleMatch && classMatch;
+    return ttl == L"*" ||
+        Foundation::StringUtils::wildcardMatch(ttl.c_str(), helper.getText().c_str());
 }
 
 
@@ -126,6 +129,13 @@ AutoPinRule::load(HKEY key, int i)
         return false;
     
     enabled = enabled_dw != 0;
+
+    // 正则标志是后来加入的，没有时按通配符规则处理
+    DWORD regex_dw = 0;
+    dwSize = sizeof(DWORD);
+    type = REG_DWORD;
+    regex = RegQueryValueExW(key, val(L'R').c_str(), nullptr, &type, reinterpret_cast<LPBYTE>(&regex_dw), &dwSize) == ERROR_SUCCESS &&
+            type == REG_DWORD && regex_dw != 0;
     return true;
 }
 
@@ -146,6 +156,11 @@ AutoPinRule::save(HKEY key, int i) const
     if (RegSetValueExW(key, val(L'E').c_str(), 0, REG_DWORD, reinterpret_cast<const BYTE*>(&enabled_dw), sizeof(DWORD)) != ERROR_SUCCESS)
         return false;
     
+    // 保存正则标志
+    DWORD regex_dw = regex ? 1 : 0;
+    if (RegSetValueExW(key, val(L'R').c_str(), 0, REG_DWORD, reinterpret_cast<const BYTE*>(&regex_dw), sizeof(DWORD)) != ERROR_SUCCESS)
+        return false;
+    
     return true;
 }
 
@@ -158,12 +173,18 @@ AutoPinRule::remove(HKEY key, int i)
     RegDeleteValueW(key, val(L'T').c_str());
     RegDeleteValueW(key, val(L'C').c_str());
     RegDeleteValueW(key, val(L'E').c_str());
+    RegDeleteValueW(key, val(L'R').c_str());
 }
 
 
 Options::Options() : 
     pinImagePath(L"assets\\images\\TinyPin.png"),  // 默认使用原始图钉文件
     trackRate(Constants::DEFAULT_TRACK_RATE_OLD, Constants::MIN_TRACK_RATE, Constants::MAX_TRACK_RATE, Constants::MIN_TRACK_RATE),
+    adaptiveTracking(true),
+    idleTrackRate(Constants::DEFAULT_IDLE_TRACK_RATE, Constants::MIN_TRACK_RATE, Constants::MAX_TRACK_RATE, Constants::MIN_TRACK_RATE),
+    frameSync(false),
+    predictMotion(false),
+    overlayPins(false),
     dblClkTray(false),
     runOnStartup(false),
     bindWindows(false),
@@ -172,6 +193,7 @@ Options::Options() :
     hotTogglePin(App::HOTID_TOGGLEPIN, VK_F12, MOD_CONTROL),
     autoPinOn(false),
     autoPinDelay(Constants::DEFAULT_AUTOPIN_DELAY, Constants::MIN_AUTOPIN_DELAY, Constants::MAX_AUTOPIN_DELAY, Constants::SMALL_BUFFER_SIZE),
+    autoPinTitleWatch(false),
     language(L"")    // empty means auto-detect
 {
     // 为Win2K+设置更高的跟踪频率（更高的WM_TIMER分辨率）
@@ -289,6 +311,35 @@ bool Options::loadSettingsFromIni()
             trackRate = rate;
         }
     }
+    
+    // 加载自适应跟踪设置
+    value = readUtf8IniValue(iniPath, L"Pins", L"AdaptiveTracking", L"");
+    if (!value.empty()) {
+        adaptiveTracking = (_wtoi(value.c_str()) != 0);
+    }
+    
+    value = readUtf8IniValue(iniPath, L"Pins", L"IdleTrackRate", L"");
+    if (!value.empty()) {
+        int rate = _wtoi(value.c_str());
+        if (idleTrackRate.inRange(rate)) {
+            idleTrackRate = rate;
+        }
+    }
+    
+    value = readUtf8IniValue(iniPath, L"Pins", L"FrameSync", L"");
+    if (!value.empty()) {
+        frameSync = (_wtoi(value.c_str()) != 0);
+    }
+    
+    value = readUtf8IniValue(iniPath, L"Pins", L"PredictMotion", L"");
+    if (!value.empty()) {
+        predictMotion = (_wtoi(value.c_str()) != 0);
+    }
+    
+    value = readUtf8IniValue(iniPath, L"Pins", L"OverlayPins", L"");
+    if (!value.empty()) {
+        overlayPins = (_wtoi(value.c_str()) != 0);
+    }
   // 加载托盘双击设置
     value = readUtf8IniValue(iniPath, L"Pins", L"TrayDblClick", L"");
     if (!value.empty()) {
@@ -324,6 +375,11 @@ bool Options::loadSettingsFromIni()
         }
     }
     
+    value = readUtf8IniValue(iniPath, L"AutoPin", L"TitleWatch", L"");
+    if (!value.empty()) {
+        autoPinTitleWatch = (_wtoi(value.c_str()) != 0);
+    }
+    
     loadAutoPinRulesFromIni();
     
     return true;
@@ -446,6 +502,7 @@ bool Options::loadAutoPinRulesFromIni()
     
     // 清空现有规则
     autoPinRules.clear();
+    autoPinMatcher.compile(autoPinRules);
     
     // 加载规则数量
     std::wstring ruleCountStr = readUtf8IniValue(iniPath, L"AutoPin", L"RuleCount", L"0");
@@ -473,9 +530,16 @@ bool Options::loadAutoPinRulesFromIni()
         std::wstring enabledStr = readUtf8IniValue(iniPath, sectionName, L"Enabled", L"1");
         rule.enabled = (_wtoi(enabledStr.c_str()) != 0);
         
+        // 加载匹配方式
+        std::wstring regexStr = readUtf8IniValue(iniPath, sectionName, L"Regex", L"0");
+        rule.regex = (_wtoi(regexStr.c_str()) != 0);
+        
         autoPinRules.push_back(rule);
     }
     
+    // 正则规则在加载时编译一次
+    autoPinMatcher.compile(autoPinRules);
+    
     return true;
 }
 
@@ -544,6 +608,16 @@ bool Options::saveFormattedSettingsToIni() const
         file << "PinImagePath=" << toUtf8(pinImagePath) << "\n";
         file << "; 窗口跟踪频率，单位毫秒 (10-1000)\n";
         file << "TrackRate=" << trackRate.value << "\n";
+        file << "; 自适应跟踪：目标窗口静止时降低跟踪频率 (0=禁用, 1=启用)\n";
+        file << "AdaptiveTracking=" << (adaptiveTracking ? 1 : 0) << "\n";
+        file << "; 目标窗口静止时的跟踪频率，单位毫秒 (10-1000)\n";
+        file << "IdleTrackRate=" << idleTrackRate.value << "\n";
+        file << "; 按屏幕刷新帧同步定位图钉，减少拖动窗口时的延迟和抖动 (0=禁用, 1=启用)\n";
+        file << "FrameSync=" << (frameSync ? 1 : 0) << "\n";
+        file << "; 拖动窗口时预测图钉位置，减少图钉落后于标题栏 (0=禁用, 1=启用)\n";
+        file << "PredictMotion=" << (predictMotion ? 1 : 0) << "\n";
+        file << "; 每个显示器用一个透明覆盖层绘制所有图钉，代替每个图钉一个窗口 (0=禁用, 1=启用)\n";
+        file << "OverlayPins=" << (overlayPins ? 1 : 0) << "\n";
         file << "; 托盘图标双击行为 (0=单击, 1=双击)\n";
         file << "TrayDblClick=" << (dblClkTray ? 1 : 0) << "\n";
         file << "; 绑定置顶窗口功能 (0=禁用, 1=启用)\n";
@@ -569,6 +643,8 @@ bool Options::saveFormattedSettingsToIni() const
         file << "Enabled=" << (autoPinOn ? 1 : 0) << "\n";
         file << "; 自动图钉延迟时间，单位毫秒 (100-10000)\n";
         file << "Delay=" << autoPinDelay.value << "\n";
+        file << "; 未匹配的窗口在" << Constants::AUTOPIN_TITLE_WATCH / 1000 << "秒内标题变化时重新检查 (0=禁用, 1=启用)\n";
+        file << "TitleWatch=" << (autoPinTitleWatch ? 1 : 0) << "\n";
         file << "; 自动图钉规则数量\n";
         file << "RuleCount=" << autoPinRules.size() << "\n";
         file << "\n";
@@ -585,6 +661,8 @@ bool Options::saveFormattedSettingsToIni() const
             file << "Class=" << toUtf8(rule.cls) << "\n";
             file << "; 规则启用状态 (0=禁用, 1=启用)\n";
             file << "Enabled=" << (rule.enabled ? 1 : 0) << "\n";
+            file << "; 匹配方式 (0=通配符, 1=正则表达式)\n";
+            file << "Regex=" << (rule.regex ? 1 : 0) << "\n";
             
             // 在规则之间添加空行（除了最后一个）
             if (i < autoPinRules.size() - 1) {
@@ -3,6 +3,7 @@
 #include "core/application.h"
 #include "options/options.h"
 #include "pin/pin_window.h"
+#include "pin/pin_registry.h"
 #include "ui/main_window.h"
 #include "system/language_manager.h"
 #include "foundation/string_utils.h"
@@ -69,22 +70,18 @@ bool OptPins::validate(HWND wnd)
 
 void OptPins::updatePinWnds()
 {
-    // 枚举所有图钉窗口并刷新显示
-    EnumWindows([](HWND wnd, LPARAM) -> BOOL {
-        Window::WndHelper helper(wnd);
-        if (Foundation::StringUtils::strimatch(PinWnd::className, helper.getClassName().c_str()))
-            InvalidateRect(wnd, nullptr, false);
-        return TRUE;    // continue
-    }, 0);
+    // 刷新所有图钉窗口的显示
+    for (HWND pin : Pin::PinRegistry::pins()) {
+        InvalidateRect(pin, nullptr, false);
+    }
 }
 
 
-BOOL CALLBACK OptPins::resetPinTimersEnumProc(HWND wnd, LPARAM param)
+void OptPins::resetPinTimers(int rate)
 {
-    Window::WndHelper helper(wnd);
-    if (Foundation::StringUtils::strimatch(PinWnd::className, helper.getClassName().c_str()))
-        SendMessage(wnd, App::WM_PIN_RESETTIMER, param, 0);
-    return true;    // continue
+    for (HWND pin : Pin::PinRegistry::pins()) {
+        SendMessage(pin, App::WM_PIN_RESETTIMER, rate, 0);
+    }
 }
 
 
@@ -95,7 +92,7 @@ void OptPins::apply(HWND wnd)
     // 处理跟踪频率变更
     int rate = opt.trackRate.getUI(wnd, IDC_POLL_RATE);
     if (opt.trackRate.value != rate)
-        EnumWindows(resetPinTimersEnumProc, opt.trackRate.value = rate);
+        resetPinTimers(opt.trackRate.value = rate);
 
     // 处理托盘双击设置
     opt.dblClkTray = IsDlgButtonChecked(wnd, IDC_TRAY_DOUBLE_CLICK) == BST_CHECKED;
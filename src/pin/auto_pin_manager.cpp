@@ -3,68 +3,210 @@
 #include "core/application.h"
 #include "options/options.h"
 #include "pin/pin_manager.h"
+#include "window/win_event_hook_manager.h"
+#include "system/logger.h"
+
+namespace {
+    // 同时监视标题的窗口数上限
+    constexpr size_t MAX_WATCHED = 32;
+}
 
 void PendingWindows::add(HWND wnd) {
 	if (!IsWindow(wnd)) return;
 
 	// 获取窗口标题和类名
 	Window::WndHelper helper(wnd);
-	std::wstring title = helper.getText();
-	std::wstring className = helper.getClassName();
+	Window::WindowText title = helper.getText();
+	Window::ClassId classId = Window::ClassRegistry::getInstance().classOf(wnd);
 
 	// 添加到队列
-	m_wnds.push_back({ wnd, title, className, GetTickCount64() });
+	m_wnds.push_back({ wnd, title, classId, GetTickCount64() });
 }
 
 void PendingWindows::check(HWND wnd, const Options& opt)
 {
+    checkWatched(wnd, opt);
+
     if (m_wnds.empty()) return;
 
-    // 批量处理窗口，减少频繁的Sleep调用
-    const int BATCH_SIZE = 5;
-    int processedCount = 0;
-    
+    // 收集本次到期且匹配规则的窗口，之后一次批量创建图钉
+    std::vector<HWND> targets;
     for (int n = static_cast<int>(m_wnds.size())-1; n >= 0; --n) {
         if (timeToChkWnd(m_wnds[n].time, opt)) {
             HWND targetWnd = m_wnds[n].wnd;
             
             if (checkWnd(targetWnd, opt)) {
-                // 检查窗口是否仍然有效
-                if (IsWindow(targetWnd)) {
-                    // 检查窗口是否在黑名单中
-                    if (!isInBlacklist(targetWnd)) {
-                        // 检查是否为错误对话框
-                        if (isErrorDialog(targetWnd)) {
-                            addToBlacklist(targetWnd);
-                        } else {
-                            // 尝试图钉正常窗口
-                            Pin::PinManager::pinWindow(wnd, targetWnd, opt.trackRate.value, true);
-                            
-                            // 给系统一点时间来创建图钉
-                            Sleep(Constants::DEFAULT_BLINK_DELAY);
-                            
-                            // 检查图钉是否成功创建
-                            if (!Pin::PinManager::hasPin(targetWnd)) {
-                                addToBlacklist(targetWnd);
-                            }
-                        }
-                    }
-                }
+                targets.push_back(targetWnd);
+            } else if (opt.autoPinTitleWatch && IsWindow(targetWnd) &&
+                       opt.autoPinMatcher.matchClass(targetWnd)) {
+                // 类名符合但标题不符合，标题之后可能变为符合
+                watch(targetWnd);
             }
             m_wnds.erase(m_wnds.begin() + n);
-            
-            // 批量处理后再Sleep，减少频繁的Sleep调用
-            if (++processedCount >= BATCH_SIZE) {
-                Sleep(1); // 减少Sleep时间
-                processedCount = 0;
-            }
         }
     }
     
+    pinTargets(wnd, targets, opt);
+    
     // 清理过期的黑名单条目
     cleanupBlacklist();
 }
 
+void PendingWindows::pinTargets(HWND wnd, std::vector<HWND>& targets, const Options& opt)
+{
+    targets.erase(
+        std::remove_if(targets.begin(), targets.end(), [this](HWND targetWnd) {
+            // 检查窗口是否仍然有效，以及是否在黑名单中
+            if (!IsWindow(targetWnd) || isInBlacklist(targetWnd)) {
+                return true;
+            }
+            // 检查是否为错误对话框
+            if (isErrorDialog(targetWnd)) {
+                addToBlacklist(targetWnd);
+                return true;
+            }
+            return false;
+        }),
+        targets.end()
+    );
+    
+    if (!targets.empty()) {
+        // 图钉在SendMessage中同步创建完成，无需等待
+        Pin::PinManager::pinWindows(wnd, targets, opt.trackRate.value);
+        
+        // 创建失败的窗口加入黑名单，避免反复尝试
+        for (HWND targetWnd : targets) {
+            if (!Pin::PinManager::hasPin(targetWnd)) {
+                addToBlacklist(targetWnd);
+            }
+        }
+    }
+}
+
+void PendingWindows::watch(HWND target)
+{
+    for (const WatchEntry& entry : m_watched) {
+        if (entry.wnd == target) return;
+    }
+
+    // 只监听窗口所属进程的标题变化，同一进程的多个窗口共用钩子
+    DWORD processId = 0;
+    GetWindowThreadProcessId(target, &processId);
+    if (!processId) return;
+
+    // 监视的窗口过多时放弃最早的
+    if (m_watched.size() >= MAX_WATCHED) {
+        unwatch(0);
+    }
+
+    Window::WinEventHookManager::getInstance().acquire(
+        EVENT_OBJECT_NAMECHANGE, EVENT_OBJECT_NAMECHANGE, titleEventProc, processId);
+
+    ULONGLONG now = GetTickCount64();
+    m_watched.push_back({ target, processId, now, now, false });
+    ++m_stats.watched;
+}
+
+void PendingWindows::unwatch(size_t index)
+{
+    Window::WinEventHookManager::getInstance().release(
+        EVENT_OBJECT_NAMECHANGE, EVENT_OBJECT_NAMECHANGE, titleEventProc, m_watched[index].processId);
+    m_watched.erase(m_watched.begin() + index);
+}
+
+void PendingWindows::unwatchAll()
+{
+    while (!m_watched.empty()) {
+        unwatch(m_watched.size() - 1);
+    }
+}
+
+void PendingWindows::titleChanged(HWND target, HWND wnd, const Options& opt)
+{
+    for (size_t n = 0; n < m_watched.size(); ++n) {
+        WatchEntry& entry = m_watched[n];
+        if (entry.wnd != target) continue;
+
+        ++m_stats.events;
+        // 标题频繁变化时限制检查频率，间隔内的变化留给定时器检查
+        if (GetTickCount64() - entry.lastCheck < ULONGLONG(Constants::AUTOPIN_RECHECK_INTERVAL)) {
+            entry.dirty = true;
+        } else {
+            recheck(n, wnd, opt);
+        }
+        return;
+    }
+}
+
+void PendingWindows::recheck(size_t index, HWND wnd, const Options& opt)
+{
+    WatchEntry& entry = m_watched[index];
+    entry.lastCheck = GetTickCount64();
+    entry.dirty = false;
+    ++m_stats.rechecks;
+
+    HWND target = entry.wnd;
+    if (!IsWindow(target)) {
+        unwatch(index);
+        return;
+    }
+    if (!checkWnd(target, opt)) {
+        return;
+    }
+
+    unwatch(index);
+    std::vector<HWND> targets(1, target);
+    pinTargets(wnd, targets, opt);
+    if (Pin::PinManager::hasPin(target)) {
+        ++m_stats.pinned;
+    }
+}
+
+void PendingWindows::checkWatched(HWND wnd, const Options& opt)
+{
+    if (!opt.autoPinTitleWatch) {
+        unwatchAll();
+        return;
+    }
+
+    ULONGLONG now = GetTickCount64();
+    for (int n = static_cast<int>(m_watched.size())-1; n >= 0; --n) {
+        const WatchEntry& entry = m_watched[n];
+        if (now - entry.since >= ULONGLONG(Constants::AUTOPIN_TITLE_WATCH) || !IsWindow(entry.wnd)) {
+            unwatch(n);
+        } else if (entry.dirty && now - entry.lastCheck >= ULONGLONG(Constants::AUTOPIN_RECHECK_INTERVAL)) {
+            recheck(n, wnd, opt);
+        }
+    }
+
+    reportStats();
+}
+
+void PendingWindows::reportStats()
+{
+    m_statsReporter.update(GetTickCount64(), m_stats, [this](const Stats& stats, const Stats& reported, ULONGLONG) {
+        if (stats.watched == reported.watched) {
+            return false;
+        }
+        LOG_DEBUG(L"自动图钉标题监视: 新监视 " + std::to_wstring(stats.watched - reported.watched) +
+                  L" 个窗口, 标题变化 " + std::to_wstring(stats.events - reported.events) +
+                  L" 次, 重新检查 " + std::to_wstring(stats.rechecks - reported.rechecks) +
+                  L" 次, 创建图钉 " + std::to_wstring(stats.pinned - reported.pinned) +
+                  L" 个, 监视中 " + std::to_wstring(m_watched.size()) + L" 个");
+        return true;
+    });
+}
+
+void CALLBACK PendingWindows::titleEventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd,
+                                             LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime)
+{
+    // 钩子按进程安装，同一进程中未被监视的窗口由titleChanged忽略
+    if (event == EVENT_OBJECT_NAMECHANGE && idObject == OBJID_WINDOW && idChild == CHILDID_SELF &&
+        hwnd && app.mainWnd) {
+        PostMessage(app.mainWnd, App::WM_AUTOPINTITLE, reinterpret_cast<WPARAM>(hwnd), 0);
+    }
+}
+
 bool PendingWindows::timeToChkWnd(ULONGLONG t, const Options& opt)
 {
     // 使用GetTickCount64避免32位溢出问题
@@ -73,10 +215,7 @@ bool PendingWindows::timeToChkWnd(ULONGLONG t, const Options& opt)
 
 bool PendingWindows::checkWnd(HWND target, const Options& opt)
 {
-    for (int n = 0; n < int(opt.autoPinRules.size()); ++n)
-        if (opt.autoPinRules[n].match(target))
-            return true;
-    return false;
+    return opt.autoPinMatcher.match(target);
 }
 
 bool PendingWindows::isErrorDialog(HWND wnd)
@@ -84,10 +223,7 @@ bool PendingWindows::isErrorDialog(HWND wnd)
     if (!wnd || !IsWindow(wnd)) return false;
     
     // 获取窗口标题
-    WCHAR windowTitle[Constants::MAX_WINDOWTEXT_LEN] = {0};
-                GetWindowText(wnd, windowTitle, Constants::MAX_WINDOWTEXT_LEN);
-    
-    std::wstring title(windowTitle);
+    Window::WindowText title = Window::getWindowText(wnd);
     
     // 主要检查是否为TinyPin自己的错误对话框
     // 只过滤明确的TinyPin错误对话框，让其他窗口都有机会被图钉
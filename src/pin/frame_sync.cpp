@@ -0,0 +1,209 @@
+#include "core/stdafx.h"
+#include "pin/frame_sync.h"
+#include "pin/z_order_manager.h"
+#include "window/tick_snapshot.h"
+#include "core/application.h"
+#include "system/logger.h"
+
+namespace Pin {
+
+    namespace {
+        // DwmFlush失败（如合成被禁用）时的帧间隔（毫秒）
+        constexpr DWORD FALLBACK_FRAME_INTERVAL = 16;
+        // 图钉连续多少帧未移动后不再逐帧更新
+        constexpr int IDLE_FRAMES = 3;
+
+        LONGLONG queryCounter() {
+            LARGE_INTEGER li;
+            QueryPerformanceCounter(&li);
+            return li.QuadPart;
+        }
+    }
+
+    FrameSync& FrameSync::getInstance() {
+        static FrameSync instance;
+        return instance;
+    }
+
+    FrameSync::~FrameSync() {
+        stop();
+    }
+
+    bool FrameSync::start(HWND notifyWnd, UINT notifyMsg) {
+        if (isRunning()) {
+            return true;
+        }
+        if (!app.dwm.hasFlush()) {
+            return false;
+        }
+
+        m_activeEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+        if (!m_activeEvent) {
+            return false;
+        }
+
+        m_notifyWnd = notifyWnd;
+        m_notifyMsg = notifyMsg;
+        m_stop = false;
+        m_framePosted = false;
+
+        LARGE_INTEGER freq;
+        QueryPerformanceFrequency(&freq);
+        m_qpcFrequency = freq.QuadPart;
+
+        m_thread = std::thread([this]() { threadProc(); });
+        return true;
+    }
+
+    void FrameSync::stop() {
+        if (!m_thread.joinable()) {
+            return;
+        }
+        m_stop = true;
+        SetEvent(m_activeEvent);
+        m_thread.join();
+
+        CloseHandle(m_activeEvent);
+        m_activeEvent = nullptr;
+        m_dirty.clear();
+    }
+
+    void FrameSync::threadProc() {
+        while (!m_stop) {
+            // 没有待更新的图钉时在此挂起
+            WaitForSingleObject(m_activeEvent, INFINITE);
+            if (m_stop) {
+                break;
+            }
+
+            if (FAILED(app.dwm.flush())) {
+                Sleep(FALLBACK_FRAME_INTERVAL);
+            }
+            ++m_frame;
+
+            // UI线程尚未处理上一帧时不重复发送，由onFrame统计错过的帧
+            if (!m_framePosted.exchange(true)) {
+                PostMessage(m_notifyWnd, m_notifyMsg, 0, 0);
+            }
+        }
+    }
+
+    void FrameSync::markDirty(HWND wnd, FrameHandler handler) {
+        if (!isRunning() || !wnd || !handler) {
+            return;
+        }
+
+        size_t frame = m_frame.load();
+        for (Item& item : m_dirty) {
+            if (item.wnd == wnd) {
+                // 已在逐帧更新中：之前的延迟已统计时开始新一次统计
+                if (item.measured) {
+                    item.markedFrame = frame;
+                    item.measured = false;
+                }
+                item.idleFrames = 0;
+                return;
+            }
+        }
+
+        if (m_dirty.empty()) {
+            m_lastFrame = frame;
+            SetEvent(m_activeEvent);
+        }
+        m_dirty.push_back(Item{ wnd, handler, frame, false, 0 });
+    }
+
+    void FrameSync::remove(HWND wnd) {
+        for (size_t n = 0; n < m_dirty.size(); ++n) {
+            if (m_dirty[n].wnd == wnd) {
+                m_dirty.erase(m_dirty.begin() + n);
+                break;
+            }
+        }
+        if (m_dirty.empty() && m_activeEvent) {
+            ResetEvent(m_activeEvent);
+        }
+    }
+
+    void FrameSync::onFrame() {
+        m_framePosted = false;
+        if (m_dirty.empty()) {
+            return;
+        }
+
+        LONGLONG start = queryCounter();
+        size_t frame = m_frame.load();
+        if (frame > m_lastFrame + 1) {
+            m_stats.dropped += frame - m_lastFrame - 1;
+        }
+        m_lastFrame = frame;
+        ++m_stats.frames;
+
+        // 本帧内所有图钉共用一份窗口状态快照
+        Window::TickSnapshot::Scope snapshot;
+
+        // 处理函数可能销毁图钉并调用remove，因此按快照处理
+        std::vector<Item> items = m_dirty;
+        size_t moves = 0;
+        for (const Item& item : items) {
+            if (!item.handler(item.wnd)) {
+                continue;
+            }
+            ++moves;
+            for (Item& dirty : m_dirty) {
+                if (dirty.wnd == item.wnd) {
+                    dirty.idleFrames = -1;  // 下面统一加一
+                    if (!dirty.measured) {
+                        m_stats.lagFrames += frame - dirty.markedFrame;
+                        ++m_stats.lagSamples;
+                        dirty.measured = true;
+                    }
+                    break;
+                }
+            }
+        }
+
+        // 连续若干帧未移动的图钉不再逐帧更新
+        for (size_t n = 0; n < m_dirty.size(); ) {
+            if (++m_dirty[n].idleFrames >= IDLE_FRAMES) {
+                m_dirty.erase(m_dirty.begin() + n);
+            } else {
+                ++n;
+            }
+        }
+        if (m_dirty.empty()) {
+            ResetEvent(m_activeEvent);
+        }
+
+        if (moves) {
+            m_stats.moves += moves;
+            ZOrderManager::getInstance().commit();
+        } else {
+            ++m_stats.skipped;
+        }
+
+        if (m_qpcFrequency > 0) {
+            m_stats.cpuMicros += (queryCounter() - start) * 1000000 / m_qpcFrequency;
+        }
+        reportStats();
+    }
+
+    void FrameSync::reportStats() {
+        m_statsReporter.update(GetTickCount(), m_stats, [](const Stats& stats, const Stats& reported, DWORD) {
+            size_t frames = stats.frames - reported.frames;
+            size_t lagSamples = stats.lagSamples - reported.lagSamples;
+            size_t lagFrames = stats.lagFrames - reported.lagFrames;
+            LONGLONG cpuMicros = stats.cpuMicros - reported.cpuMicros;
+
+            if (frames) {
+                LOG_DEBUG(L"帧同步: 帧 " + std::to_wstring(frames) +
+                          L", 无移动 " + std::to_wstring(stats.skipped - reported.skipped) +
+                          L", 错过 " + std::to_wstring(stats.dropped - reported.dropped) +
+                          L", 平均延迟 " + std::to_wstring(lagSamples ? double(lagFrames) / lagSamples : 0.0) +
+                          L" 帧, 每帧耗时 " + std::to_wstring(cpuMicros / LONGLONG(frames)) + L"us");
+            }
+            return true;
+        });
+    }
+
+} // namespace Pin
@@ -1,12 +1,45 @@
 #include "core/stdafx.h"
 #include "pin/pin_manager.h"
 #include "pin/pin_window.h"
+#include "pin/pin_registry.h"
+#include "pin/z_order_manager.h"
+#include "pin/window_binding_manager.h"
 #include "core/application.h"
 #include "system/language_manager.h"
 #include "foundation/error_handler.h"
 
 namespace Pin {
 
+int PinManager::s_batchDepth = 0;
+std::vector<HWND> PinManager::s_deferredPins;
+
+PinManager::BatchScope::BatchScope()
+{
+    if (s_batchDepth++ == 0) {
+        WindowBindingManager::beginDeferUpdate();
+    }
+}
+
+PinManager::BatchScope::~BatchScope()
+{
+    if (--s_batchDepth > 0) {
+        return;
+    }
+
+    // 所有图钉的位置和层级一次提交，之后再显示，避免在错误位置闪现
+    ZOrderManager::getInstance().commit();
+
+    std::vector<HWND> pins;
+    pins.swap(s_deferredPins);
+    for (HWND pin : pins) {
+        if (IsWindow(pin)) {
+            ShowWindow(pin, SW_SHOWNA);
+        }
+    }
+
+    WindowBindingManager::endDeferUpdate();
+}
+
 bool PinManager::pinWindow(HWND wnd, HWND hitWnd, int trackRate, bool autoPin)
 {
     int err = 0, wrn = 0;
@@ -70,15 +103,7 @@ bool PinManager::pinWindow(HWND wnd, HWND hitWnd, int trackRate, bool autoPin)
 
 bool PinManager::hasPin(HWND wnd)
 {
-    // 枚举所有图钉窗口
-    HWND pin = nullptr;
-    while ((pin = FindWindowEx(nullptr, pin, PinWnd::className, nullptr)) != nullptr) {
-        if (HWND(SendMessage(pin, ::App::WM_PIN_GETPINNEDWND, 0, 0)) == wnd) {
-            return true;
-        }
-    }
-
-    return false;
+    return PinRegistry::findPin(wnd) != nullptr;
 }
 
 bool PinManager::togglePin(HWND wnd, HWND target, int trackRate)
@@ -86,28 +111,49 @@ bool PinManager::togglePin(HWND wnd, HWND target, int trackRate)
     target = Window::getTopParent(target);
     
     // 检查是否已经有图钉
-    HWND pin = nullptr;
-    while ((pin = FindWindowEx(nullptr, pin, PinWnd::className, nullptr)) != nullptr) {
-        if (HWND(SendMessage(pin, ::App::WM_PIN_GETPINNEDWND, 0, 0)) == target) {
-            DestroyWindow(pin);
-            return true;
-        }
+    if (HWND pin = PinRegistry::findPin(target)) {
+        DestroyWindow(pin);
+        return true;
     }
     
     // 没有图钉，创建新的
     return pinWindow(wnd, target, trackRate);
 }
 
+int PinManager::pinWindows(HWND wnd, const std::vector<HWND>& targets, int trackRate)
+{
+    BatchScope batch;
+
+    int pinned = 0;
+    for (HWND target : targets) {
+        if (hasPin(target)) {
+            continue;
+        }
+        // 批量操作不逐个弹出错误提示，由调用者根据结果处理
+        if (pinWindow(wnd, target, trackRate, true)) {
+            ++pinned;
+        }
+    }
+    return pinned;
+}
+
+int PinManager::unpinAll()
+{
+    BatchScope batch;
+
+    std::vector<HWND> pins = PinRegistry::pins();
+    for (HWND pin : pins) {
+        DestroyWindow(pin);
+    }
+    return static_cast<int>(pins.size());
+}
+
 int PinManager::restoreAllPinnedWindows()
 {
     int restoredCount = 0;
     
-    // 枚举所有图钉窗口，获取它们对应的目标窗口
-    HWND pin = nullptr;
-    while ((pin = FindWindowEx(nullptr, pin, PinWnd::className, nullptr)) != nullptr) {
-        // 获取图钉对应的目标窗口
-        HWND targetWnd = HWND(SendMessage(pin, ::App::WM_PIN_GETPINNEDWND, 0, 0));
-        
+    // 遍历所有图钉对应的目标窗口
+    for (HWND targetWnd : PinRegistry::targets()) {
         if (targetWnd && IsWindow(targetWnd)) {
             // 检查目标窗口是否是置顶状态
             LONG exStyle = GetWindowLong(targetWnd, GWL_EXSTYLE);
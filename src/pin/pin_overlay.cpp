@@ -0,0 +1,512 @@
+#include "core/stdafx.h"
+#include "pin/pin_overlay.h"
+#include "pin/z_order_manager.h"
+#include "core/application.h"
+#include "graphics/monitor_topology.h"
+#include "resource.h"
+#include "system/logger.h"
+
+namespace Pin {
+
+    LPCWSTR PinOverlay::className = L"EFPinOverlay";
+
+    namespace {
+        // 网格索引的单元格大小（像素），略大于图钉，每个图钉最多占四个单元格
+        constexpr int GRID_CELL = 64;
+        // 覆盖层位图在图钉外接矩形四周预留的余量：显示器宽高的1/8，至少两个单元格，
+        // 拖动图钉时不必频繁重新分配；位图面积超过所需面积的4倍时缩小
+        constexpr Foundation::SpriteBoundsRule SURFACE_RULE = { 2 * GRID_CELL, 8, 4 };
+
+        // 把屏幕矩形转换为覆盖层坐标
+        RECT toLocal(const RECT& rc, const RECT& bounds) {
+            RECT local = rc;
+            OffsetRect(&local, -bounds.left, -bounds.top);
+            return local;
+        }
+    }
+
+    PinOverlay& PinOverlay::getInstance() {
+        static PinOverlay instance;
+        return instance;
+    }
+
+    PinOverlay::~PinOverlay() {
+        for (auto& surface : m_surfaces) {
+            destroySurface(*surface);
+        }
+    }
+
+    ATOM PinOverlay::registerClass() {
+        Window::WindowClassConfig config = {};
+        config.style = 0;
+        config.className = className;
+        config.wndProc = proc;
+        config.cursor = LoadCursor(app.inst, MAKEINTRESOURCE(IDC_REMOVEPIN));
+        config.background = nullptr;
+        return Window::WindowRegistrar::registerWindowClass(config);
+    }
+
+    LRESULT CALLBACK PinOverlay::proc(HWND wnd, UINT msg, WPARAM wparam, LPARAM lparam) {
+        switch (msg) {
+            case WM_MOUSEACTIVATE:
+                return MA_NOACTIVATE;
+            case WM_LBUTTONDOWN: {
+                // 与图钉窗口相同：点击图钉即移除
+                POINT pt = { GET_X_LPARAM(lparam), GET_Y_LPARAM(lparam) };
+                ClientToScreen(wnd, &pt);
+                if (HWND pin = getInstance().hitTest(pt)) {
+                    DestroyWindow(pin);
+                }
+                return 0;
+            }
+        }
+        return DefWindowProc(wnd, msg, wparam, lparam);
+    }
+
+    void PinOverlay::setEnabled(bool enabled) {
+        if (m_enabled == enabled) return;
+        m_enabled = enabled;
+        if (!enabled) {
+            for (auto& surface : m_surfaces) {
+                destroySurface(*surface);
+            }
+            m_surfaces.clear();
+            m_items.clear();
+            m_dirtyItems.clear();
+            m_pending = false;
+            m_stats.surfaces = 0;
+            m_stats.surfaceBytes = 0;
+        }
+    }
+
+    void PinOverlay::requestCommit() {
+        if (!m_pending) {
+            m_pending = true;
+            ZOrderManager::getInstance().requestCommit();
+        }
+    }
+
+    void PinOverlay::markDirty(HWND pin, Item& item) {
+        if (!item.dirty) {
+            item.dirty = true;
+            m_dirtyItems.push_back(pin);
+        }
+        requestCommit();
+    }
+
+    void PinOverlay::setPosition(HWND pin, int x, int y) {
+        if (!m_enabled || !pin) return;
+        auto result = m_items.emplace(pin, Item());
+        Item& item = result.first->second;
+        if (!result.second && item.pos.x == x && item.pos.y == y) return;
+        item.pos = POINT{ x, y };
+        markDirty(pin, item);
+    }
+
+    void PinOverlay::setVisible(HWND pin, bool visible) {
+        if (!m_enabled || !pin) return;
+        Item& item = m_items[pin];
+        if (item.visible == visible) return;
+        item.visible = visible;
+        markDirty(pin, item);
+    }
+
+    bool PinOverlay::isVisible(HWND pin) const {
+        auto it = m_items.find(pin);
+        return it != m_items.end() && it->second.visible;
+    }
+
+    void PinOverlay::remove(HWND pin) {
+        auto it = m_items.find(pin);
+        if (it == m_items.end()) return;
+
+        Item& item = it->second;
+        if (item.surface) {
+            addDirty(*item.surface, item.drawn);
+            item.surface->grid.remove(pin, item.drawn);
+            --item.surface->items;
+            requestCommit();
+        }
+        m_items.erase(it);
+        // m_dirtyItems中残留的句柄在提交时因找不到而被忽略
+    }
+
+    void PinOverlay::invalidateImage() {
+        m_imageValid = false;
+        if (m_items.empty()) return;
+
+        // 图像大小可能改变：所有图钉重新放置，所有覆盖层整体重绘
+        for (auto& surface : m_surfaces) {
+            addDirty(*surface, surface->bounds);
+        }
+        for (auto& entry : m_items) {
+            markDirty(entry.first, entry.second);
+        }
+    }
+
+    void PinOverlay::resetSurfaces() {
+        for (auto& entry : m_items) {
+            entry.second.surface = nullptr;
+            entry.second.drawn = RECT{};
+            markDirty(entry.first, entry.second);
+        }
+        for (auto& surface : m_surfaces) {
+            destroySurface(*surface);
+        }
+        m_surfaces.clear();
+        m_stats.surfaces = 0;
+        m_stats.surfaceBytes = 0;
+    }
+
+    void PinOverlay::raise() {
+        if (m_surfaces.empty()) return;
+        m_raise = true;
+        requestCommit();
+    }
+
+    PinOverlay::Surface* PinOverlay::surfaceFor(HMONITOR monitor) {
+        if (!monitor) return nullptr;
+        for (auto& surface : m_surfaces) {
+            if (surface->monitor == monitor) {
+                return surface.get();
+            }
+        }
+
+        MONITORINFO mi = { sizeof(mi) };
+        if (!GetMonitorInfo(monitor, &mi)) {
+            return nullptr;
+        }
+
+        // 位图在fitSurface中按图钉范围分配
+        auto surface = std::make_unique<Surface>();
+        surface->monitor = monitor;
+        surface->area = mi.rcMonitor;
+        surface->grid.reset(mi.rcMonitor, GRID_CELL);
+        surface->dc = CreateCompatibleDC(nullptr);
+        surface->wnd = CreateWindowEx(WS_EX_LAYERED | WS_EX_TOPMOST | WS_EX_TOOLWINDOW | WS_EX_NOACTIVATE,
+            className, L"", WS_POPUP,
+            mi.rcMonitor.left, mi.rcMonitor.top, 0, 0,
+            nullptr, nullptr, app.inst, nullptr);
+
+        if (!surface->dc || !surface->wnd) {
+            LOG_ERROR(L"创建图钉覆盖层失败");
+            destroySurface(*surface);
+            return nullptr;
+        }
+
+        ++m_stats.surfaces;
+        m_surfaces.push_back(std::move(surface));
+        return m_surfaces.back().get();
+    }
+
+    bool PinOverlay::fitSurface(Surface& surface) {
+        // 该覆盖层上所有图钉的外接矩形
+        RECT needed = {};
+        for (const auto& entry : m_items) {
+            const RECT& drawn = entry.second.drawn;
+            if (entry.second.surface != &surface) continue;
+            if (IsRectEmpty(&needed)) {
+                needed = drawn;
+            } else {
+                UnionRect(&needed, &needed, &drawn);
+            }
+        }
+        if (!IntersectRect(&needed, &needed, &surface.area)) {
+            return surface.bmp != nullptr;
+        }
+
+        // 现有位图仍包含所有图钉且没有大出太多时保留
+        RECT target;
+        if (!SURFACE_RULE.fit(needed, surface.area, surface.bmp ? &surface.bounds : nullptr, target)) {
+            return true;
+        }
+
+        int width = target.right - target.left;
+        int height = target.bottom - target.top;
+
+        BITMAPINFO bi = {};
+        bi.bmiHeader.biSize = sizeof(bi.bmiHeader);
+        bi.bmiHeader.biWidth = width;
+        bi.bmiHeader.biHeight = -height;   // 自上而下
+        bi.bmiHeader.biPlanes = 1;
+        bi.bmiHeader.biBitCount = 32;
+        bi.bmiHeader.biCompression = BI_RGB;
+
+        void* bits = nullptr;
+        HBITMAP bmp = CreateDIBSection(nullptr, &bi, DIB_RGB_COLORS, &bits, nullptr, 0);
+        if (!bmp) {
+            LOG_ERROR(L"创建图钉覆盖层位图失败");
+            return surface.bmp != nullptr;
+        }
+
+        HGDIOBJ old = SelectObject(surface.dc, bmp);
+        if (surface.bmp) {
+            m_stats.surfaceBytes -= size_t(Foundation::rectArea(surface.bounds)) * sizeof(UINT32);
+            DeleteObject(surface.bmp);
+        } else {
+            surface.oldBmp = old;
+        }
+        m_stats.surfaceBytes += size_t(width) * height * sizeof(UINT32);
+
+        // 新位图整体重绘，提交时同时移动和缩放覆盖层窗口
+        surface.bmp = bmp;
+        surface.bits = static_cast<UINT32*>(bits);
+        surface.bounds = target;
+        surface.dirty.clear();
+        surface.dirty.add(target);
+        surface.resized = true;
+        return true;
+    }
+
+    void PinOverlay::destroySurface(Surface& surface) {
+        if (surface.wnd) {
+            DestroyWindow(surface.wnd);
+            surface.wnd = nullptr;
+        }
+        if (surface.dc) {
+            if (surface.oldBmp) {
+                SelectObject(surface.dc, surface.oldBmp);
+            }
+            DeleteDC(surface.dc);
+            surface.dc = nullptr;
+        }
+        if (surface.bmp) {
+            DeleteObject(surface.bmp);
+            surface.bmp = nullptr;
+        }
+        surface.bits = nullptr;
+        surface.grid.clear();
+    }
+
+    void PinOverlay::addDirty(Surface& surface, const RECT& rc) {
+        surface.dirty.add(rc);
+    }
+
+    bool PinOverlay::buildImage() {
+        m_imageValid = false;
+        m_image.clear();
+
+        HBITMAP bmp = app.pinShape.getBmp();
+        int width = app.pinShape.getW();
+        int height = app.pinShape.getH();
+        if (!bmp || width <= 0 || height <= 0) {
+            return false;
+        }
+
+        BITMAPINFO bi = {};
+        bi.bmiHeader.biSize = sizeof(bi.bmiHeader);
+        bi.bmiHeader.biWidth = width;
+        bi.bmiHeader.biHeight = -height;
+        bi.bmiHeader.biPlanes = 1;
+        bi.bmiHeader.biBitCount = 32;
+        bi.bmiHeader.biCompression = BI_RGB;
+
+        void* bits = nullptr;
+        auto dibGuard = Util::RAII::makeBitmapGuard(CreateDIBSection(nullptr, &bi, DIB_RGB_COLORS, &bits, nullptr, 0));
+        auto dstGuard = Util::RAII::makeDCGuard(CreateCompatibleDC(nullptr));
+        auto srcGuard = Util::RAII::makeDCGuard(CreateCompatibleDC(nullptr));
+        if (!dibGuard.get() || !bits || !dstGuard.get() || !srcGuard.get()) {
+            return false;
+        }
+
+        // 与图钉窗口的绘制相同：缩放到图钉大小，黑色为透明色
+        HGDIOBJ oldDst = SelectObject(dstGuard.get(), dibGuard.get());
+        HGDIOBJ oldSrc = SelectObject(srcGuard.get(), bmp);
+        BITMAP bm;
+        GetObject(bmp, sizeof(bm), &bm);
+        SetStretchBltMode(dstGuard.get(), COLORONCOLOR);
+        StretchBlt(dstGuard.get(), 0, 0, width, height,
+                   srcGuard.get(), 0, 0, bm.bmWidth, bm.bmHeight, SRCCOPY);
+        SelectObject(srcGuard.get(), oldSrc);
+        SelectObject(dstGuard.get(), oldDst);
+        GdiFlush();
+
+        const UINT32* pixels = static_cast<const UINT32*>(bits);
+        m_image.resize(size_t(width) * height);
+        for (size_t n = 0; n < m_image.size(); ++n) {
+            UINT32 rgb = pixels[n] & 0x00FFFFFF;
+            m_image[n] = rgb ? (rgb | 0xFF000000) : 0;
+        }
+
+        m_imageW = width;
+        m_imageH = height;
+        m_imageValid = true;
+        return true;
+    }
+
+    void PinOverlay::commit() {
+        if (!m_enabled || !m_pending) return;
+        m_pending = false;
+
+        if (!m_imageValid && !buildImage()) {
+            return;
+        }
+
+        // 把位置或可见性改变的图钉移动到对应显示器的覆盖层
+        std::vector<HWND> dirtyItems;
+        dirtyItems.swap(m_dirtyItems);
+        for (HWND pin : dirtyItems) {
+            auto it = m_items.find(pin);
+            if (it == m_items.end()) continue;
+            Item& item = it->second;
+            item.dirty = false;
+
+            RECT rc = { item.pos.x, item.pos.y, item.pos.x + m_imageW, item.pos.y + m_imageH };
+            Surface* target = nullptr;
+            if (item.visible) {
+                target = surfaceFor(Graphics::MonitorTopology::getInstance().monitorFromRect(rc));
+            }
+            if (target == item.surface && (!target || EqualRect(&rc, &item.drawn))) {
+                continue;
+            }
+
+            if (item.surface) {
+                addDirty(*item.surface, item.drawn);
+                item.surface->grid.remove(pin, item.drawn);
+                --item.surface->items;
+            }
+            item.surface = target;
+            item.drawn = target ? rc : RECT{};
+            if (target) {
+                addDirty(*target, rc);
+                target->grid.insert(pin, rc);
+                ++target->items;
+            }
+        }
+
+        // 没有图钉的覆盖层直接销毁，其余按图钉范围调整位图后只重绘变化的区域
+        for (size_t n = 0; n < m_surfaces.size(); ) {
+            Surface& surface = *m_surfaces[n];
+            if (!surface.items) {
+                --m_stats.surfaces;
+                if (surface.bmp) {
+                    m_stats.surfaceBytes -= size_t(Foundation::rectArea(surface.bounds)) * sizeof(UINT32);
+                }
+                destroySurface(surface);
+                m_surfaces.erase(m_surfaces.begin() + n);
+                continue;
+            }
+            if (!surface.dirty.empty() && fitSurface(surface)) {
+                redraw(surface);
+            }
+            ++n;
+        }
+
+        if (m_raise) {
+            m_raise = false;
+            for (auto& surface : m_surfaces) {
+                SetWindowPos(surface->wnd, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
+            }
+        }
+
+        ++m_stats.commits;
+        reportStats();
+    }
+
+    void PinOverlay::redraw(Surface& surface) {
+        int width = surface.bounds.right - surface.bounds.left;
+        int height = surface.bounds.bottom - surface.bounds.top;
+
+        // 只处理位于位图内的部分
+        std::vector<RECT> pieces;
+        for (const RECT& rc : surface.dirty.rects()) {
+            RECT piece;
+            if (IntersectRect(&piece, &rc, &surface.bounds)) {
+                pieces.push_back(piece);
+            }
+        }
+        surface.dirty.clear();
+        if (pieces.empty()) return;
+
+        GdiFlush();
+        std::vector<HWND> pins;
+        for (const RECT& piece : pieces) {
+            // 清除变化的区域，通过网格找出与之相交的图钉，只在该区域内合成图钉图像
+            Foundation::clearPixels(surface.bits, surface.bounds, piece);
+            surface.grid.query(piece, pins);
+            for (HWND pin : pins) {
+                auto it = m_items.find(pin);
+                if (it == m_items.end()) continue;
+                const RECT& drawn = it->second.drawn;
+                RECT clip;
+                if (!IntersectRect(&clip, &drawn, &piece)) continue;
+                Foundation::blendPixels(surface.bits, surface.bounds, m_image.data(), drawn, clip);
+            }
+            m_stats.dirtyPixels += ULONGLONG(Foundation::rectArea(piece));
+        }
+
+        // 首次显示或位图重新分配时提交整个位图（同时移动和缩放窗口），之后逐个提交变化的区域
+        POINT dstPos = { surface.bounds.left, surface.bounds.top };
+        SIZE size = { width, height };
+        POINT srcPos = { 0, 0 };
+        BLENDFUNCTION blend = { AC_SRC_OVER, 0, 255, AC_SRC_ALPHA };
+
+        UPDATELAYEREDWINDOWINFO info = {};
+        info.cbSize = sizeof(info);
+        info.pptDst = &dstPos;
+        info.psize = &size;
+        info.hdcSrc = surface.dc;
+        info.pptSrc = &srcPos;
+        info.pblend = &blend;
+        info.dwFlags = ULW_ALPHA;
+
+        bool whole = !surface.shown || surface.resized;
+        surface.resized = false;
+        for (size_t n = 0; n < (whole ? 1 : pieces.size()); ++n) {
+            RECT local = toLocal(pieces[n], surface.bounds);
+            info.prcDirty = whole ? nullptr : &local;
+            ++m_stats.updates;
+            if (!UpdateLayeredWindowIndirect(surface.wnd, &info)) {
+                // 整体提交已包含其余区域
+                UpdateLayeredWindow(surface.wnd, nullptr, &dstPos, &size, surface.dc, &srcPos, 0, &blend, ULW_ALPHA);
+                break;
+            }
+        }
+
+        if (!surface.shown) {
+            ShowWindow(surface.wnd, SW_SHOWNA);
+            surface.shown = true;
+        }
+    }
+
+    HWND PinOverlay::hitTest(POINT pt) const {
+        for (const auto& surface : m_surfaces) {
+            if (!PtInRect(&surface->bounds, pt)) continue;
+
+            const std::vector<HWND>* cell = surface->grid.at(pt.x, pt.y);
+            if (!cell) return nullptr;
+
+            // 只有图钉图像不透明的像素算作命中，与图钉窗口的窗口区域一致
+            for (HWND pin : *cell) {
+                auto it = m_items.find(pin);
+                if (it == m_items.end() || !PtInRect(&it->second.drawn, pt)) continue;
+                int x = pt.x - it->second.drawn.left;
+                int y = pt.y - it->second.drawn.top;
+                if (x < m_imageW && y < m_imageH && (m_image[size_t(y) * m_imageW + x] >> 24)) {
+                    return pin;
+                }
+            }
+            return nullptr;
+        }
+        return nullptr;
+    }
+
+    PinOverlay::Stats PinOverlay::getStats() const {
+        return m_stats;
+    }
+
+    void PinOverlay::reportStats() {
+        m_statsReporter.update(GetTickCount(), m_stats, [this](const Stats& stats, const Stats& reported, DWORD) {
+            size_t updates = stats.updates - reported.updates;
+            if (updates) {
+                LOG_DEBUG(L"图钉覆盖层: 图钉 " + std::to_wstring(m_items.size()) +
+                          L", 覆盖层 " + std::to_wstring(stats.surfaces) +
+                          L" (" + std::to_wstring(stats.surfaceBytes / 1024) +
+                          L"KB), 提交 " + std::to_wstring(updates) +
+                          L" 次, 重绘像素 " + std::to_wstring(stats.dirtyPixels - reported.dirtyPixels));
+            }
+            return true;
+        });
+    }
+
+} // namespace Pin
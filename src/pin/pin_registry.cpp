@@ -0,0 +1,96 @@
+#include "core/stdafx.h"
+#include "pin/pin_registry.h"
+#include "pin/pin_window.h"
+#include "core/application.h"
+#include "system/logger.h"
+
+namespace Pin {
+
+// 静态成员变量定义
+std::unordered_map<HWND, HWND> PinRegistry::s_pinToTarget;
+std::unordered_map<HWND, HWND> PinRegistry::s_targetToPin;
+
+void PinRegistry::add(HWND pin, HWND target) {
+    if (!pin || !target) return;
+
+    remove(pin);
+    s_pinToTarget[pin] = target;
+    s_targetToPin[target] = pin;
+}
+
+void PinRegistry::remove(HWND pin) {
+    auto it = s_pinToTarget.find(pin);
+    if (it == s_pinToTarget.end()) return;
+
+    // 只移除仍指向此图钉的反向映射
+    auto rev = s_targetToPin.find(it->second);
+    if (rev != s_targetToPin.end() && rev->second == pin) {
+        s_targetToPin.erase(rev);
+    }
+    s_pinToTarget.erase(it);
+}
+
+HWND PinRegistry::findPin(HWND target) {
+    auto it = s_targetToPin.find(target);
+    return it != s_targetToPin.end() ? it->second : nullptr;
+}
+
+HWND PinRegistry::getTarget(HWND pin) {
+    auto it = s_pinToTarget.find(pin);
+    return it != s_pinToTarget.end() ? it->second : nullptr;
+}
+
+std::vector<HWND> PinRegistry::pins() {
+    std::vector<HWND> result;
+    result.reserve(s_pinToTarget.size());
+    for (const auto& item : s_pinToTarget) {
+        result.push_back(item.first);
+    }
+    return result;
+}
+
+std::vector<HWND> PinRegistry::targets() {
+    std::vector<HWND> result;
+    result.reserve(s_pinToTarget.size());
+    for (const auto& item : s_pinToTarget) {
+        result.push_back(item.second);
+    }
+    return result;
+}
+
+bool PinRegistry::verify() {
+    bool consistent = true;
+
+    // 通过原有的枚举方式收集图钉，与注册表逐项比对
+    size_t enumerated = 0;
+    HWND pin = nullptr;
+    while ((pin = FindWindowEx(nullptr, pin, PinWnd::className, nullptr)) != nullptr) {
+        HWND target = HWND(SendMessage(pin, ::App::WM_PIN_GETPINNEDWND, 0, 0));
+        if (!target) {
+            continue;   // 尚未绑定目标的图钉
+        }
+        ++enumerated;
+        if (getTarget(pin) != target) {
+            LOG_WARNING(L"图钉注册表不一致：图钉 " + Foundation::StringUtils::handleToHex(pin) +
+                        L" 的目标窗口与注册表记录不符");
+            consistent = false;
+        }
+    }
+
+    if (enumerated != s_pinToTarget.size()) {
+        LOG_WARNING(L"图钉注册表不一致：枚举到 " + std::to_wstring(enumerated) +
+                    L" 个图钉，注册表中有 " + std::to_wstring(s_pinToTarget.size()) + L" 个");
+        consistent = false;
+    }
+
+    for (const auto& item : s_targetToPin) {
+        if (getTarget(item.second) != item.first) {
+            LOG_WARNING(L"图钉注册表不一致：反向映射与正向映射不符");
+            consistent = false;
+        }
+    }
+
+    return consistent;
+}
+
+} // namespace Pin
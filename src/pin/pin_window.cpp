@@ -2,16 +2,47 @@
 #include "core/application.h"
 #include "pin/pin_shape.h"
 #include "pin/pin_window.h"
+#include "pin/z_order_manager.h"
+#include "pin/pin_registry.h"
+#include "pin/pin_manager.h"
+#include "pin/track_scheduler.h"
+#include "pin/frame_sync.h"
+#include "pin/pin_overlay.h"
+#include "pin/window_binding_manager.h"
+#include "graphics/monitor_topology.h"
 #include "window/window_cache.h"  // 添加窗口缓存支持
+#include "window/win_event_hook_manager.h"
+#include "window/ownership_graph.h"
+#include "window/tick_snapshot.h"
+#include "window/class_registry.h"
+#include "options/options.h"
 #include "resource.h"
 #include "system/logger.h"
 #include "system/language_manager.h"
-#include <map>
 
 
+// 引用全局选项对象
+extern Options opt;
+
 LPCWSTR PinWnd::className = L"EFPinWnd";
 
 
+namespace {
+    // 高精度时间（毫秒），用于运动预测的采样时间戳
+    double preciseTimeMs()
+    {
+        static LARGE_INTEGER freq = [] {
+            LARGE_INTEGER f;
+            QueryPerformanceFrequency(&f);
+            return f;
+        }();
+        LARGE_INTEGER now;
+        QueryPerformanceCounter(&now);
+        return double(now.QuadPart) * 1000.0 / double(freq.QuadPart);
+    }
+}
+
+
 ATOM PinWnd::registerClass()
 {
     HCURSOR cursor = LoadCursor(app.inst, MAKEINTRESOURCE(IDC_REMOVEPIN));
@@ -47,13 +78,13 @@ LRESULT CALLBACK PinWnd::proc(HWND wnd, UINT msg, WPARAM wparam, LPARAM lparam)
         switch (msg) {
             case WM_CREATE:         return evCreate(wnd, *pd);
             case WM_DESTROY:        return evDestroy(wnd, *pd), 0;
-            case WM_TIMER:          return evTimer(wnd, *pd, static_cast<UINT>(wparam)), 0;
             case WM_PAINT:          return evPaint(wnd, *pd), 0;
             case WM_LBUTTONDOWN:    return evLClick(wnd, *pd), 0;
             case WM_DPICHANGED:     return evDpiChanged(wnd, *pd, wparam, lparam), 0;
             case App::WM_PIN_RESETTIMER:   return evPinResetTimer(wnd, *pd, int(wparam)), 0;
             case App::WM_PIN_ASSIGNWND:    return evPinAssignWnd(wnd, *pd, HWND(wparam), int(lparam));
             case App::WM_PIN_GETPINNEDWND: return LRESULT(evGetPinnedWnd(wnd, *pd));
+            case App::WM_PIN_WAKE:         return evPinWake(wnd, *pd), 0;
         }
     }
     return DefWindowProc(wnd, msg, wparam, lparam);
@@ -82,46 +113,54 @@ LRESULT PinWnd::evCreate(HWND wnd, Data& pd)
 
 void PinWnd::evDestroy(HWND wnd, Data& pd)
 {
+    // 从注册表和绑定列表中移除，之后的查找不会再返回此图钉
+    // （目标窗口已销毁时pd.topMostWnd已被清空，因此以注册表记录为准）
+    if (HWND target = Pin::PinRegistry::getTarget(wnd)) {
+        Pin::WindowBindingManager::removeBoundWindow(target);
+    }
+    Pin::PinRegistry::remove(wnd);
+
+    // 取消目标进程的事件订阅
+    unsubscribeTarget(pd);
+    if (pd.track.graphThreadId) {
+        Window::OwnershipGraph::getInstance().untrack(pd.track.graphThreadId);
+        pd.track.graphThreadId = 0;
+    }
+
     if (pd.topMostWnd) {
-        SetWindowPos(pd.topMostWnd, HWND_NOTOPMOST, 0, 0, 0, 0, 
-            SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
+        if (Pin::PinManager::inBatch()) {
+            // 批量移除时与其他目标的层级调整一起提交
+            Pin::ZOrderManager::getInstance().requestZOrder(pd.topMostWnd, HWND_NOTOPMOST);
+        } else {
+            SetWindowPos(pd.topMostWnd, HWND_NOTOPMOST, 0, 0, 0, 0, 
+                SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
+        }
         pd.topMostWnd = nullptr;
         pd.proxyWnd = nullptr;
         pd.proxyMode = false;
     }
 
-    // 发送'图钉已销毁'通知
-    PostMessage(pd.callbackWnd, App::WM_PINSTATUS, WPARAM(wnd), false);
-}
-
-
-// 用于收集线程的所有非子窗口的辅助类。
-//
-class ThreadWnds {
-public:
-    ThreadWnds(HWND wnd) : appWnd(wnd) {}
-    int count() const { return static_cast<int>(wndList.size()); }
-    HWND operator[](int n) const { return wndList[n]; }
-
-    bool collect()
-    {
-        DWORD threadId = GetWindowThreadProcessId(appWnd, nullptr);
-        return !!EnumThreadWindows(threadId, (WNDENUMPROC)enumProc, LPARAM(this));
+    if (pd.track.proxyStats.searches) {
+        LOG_DEBUG(L"图钉代理查找: 查找 " + std::to_wstring(pd.track.proxyStats.searches) +
+                  L" 次, 失败 " + std::to_wstring(pd.track.proxyStats.failures) +
+                  L" 次, 退避跳过 " + std::to_wstring(pd.track.proxyStats.skipped) +
+                  L" 次, 子窗口枚举 " + std::to_wstring(pd.track.proxyStats.childEnumerations) + L" 次");
     }
 
-protected:
-    HWND appWnd;
-    std::vector<HWND> wndList;
-
-    static BOOL CALLBACK enumProc(HWND wnd, LPARAM param)
-    {
-        ThreadWnds& obj = *reinterpret_cast<ThreadWnds*>(param);
-        if (wnd == obj.appWnd || GetWindow(wnd, GW_OWNER) == obj.appWnd)
-            obj.wndList.push_back(wnd);
-        return true;  // 继续枚举
+    if (pd.track.predictor.errorSamples()) {
+        LOG_DEBUG(L"图钉运动预测: 平均误差 " + std::to_wstring(pd.track.predictor.averageError()) +
+                  L" 像素, 样本 " + std::to_wstring(pd.track.predictor.errorSamples()));
     }
 
-};
+    // 停止跟踪，丢弃尚未提交的位置/层级请求
+    Pin::TrackScheduler::getInstance().cancel(wnd);
+    Pin::FrameSync::getInstance().remove(wnd);
+    Pin::PinOverlay::getInstance().remove(wnd);
+    Pin::ZOrderManager::getInstance().forget(wnd);
+
+    // 发送'图钉已销毁'通知
+    PostMessage(pd.callbackWnd, App::WM_PINSTATUS, WPARAM(wnd), false);
+}
 
 
 // - 获取可见的顶级窗口
@@ -136,19 +175,19 @@ void PinWnd::fixPopupZOrder(HWND appWnd)
     // - 找到所有非禁用的顶级窗口并将它们
     //   放置在窗口X之上
 
-    // 获取所有非子窗口
-    ThreadWnds threadWnds(appWnd);
-    if (!threadWnds.collect())
-        return;
+    // 获取appWnd及其拥有的顶级窗口（由所有关系图缓存，按z-order）
+    std::vector<HWND> threadWnds = Window::OwnershipGraph::getInstance().ownedWindows(appWnd);
+    int count = static_cast<int>(threadWnds.size());
 
     // 黑客方法：这里我假设EnumThreadWindows按照
     // z-order返回HWND（这在任何地方有文档记录吗？）
 
     // 如果任何禁用的窗口在任何启用的窗口之上，
     // 则需要重新排序。
+    Window::TickSnapshot& snapshot = Window::TickSnapshot::getInstance();
     bool needReordering = false;
-    for (int n = 1; n < threadWnds.count(); ++n) {
-        if (!IsWindowEnabled(threadWnds[n-1]) && IsWindowEnabled(threadWnds[n])) {
+    for (int n = 1; n < count; ++n) {
+        if (!snapshot.isEnabled(threadWnds[n-1]) && snapshot.isEnabled(threadWnds[n])) {
             needReordering = true;
             break;
         }
@@ -159,8 +198,8 @@ void PinWnd::fixPopupZOrder(HWND appWnd)
 
     // 找到最后一个启用的
     HWND lastEnabled = nullptr;
-    for (int n = threadWnds.count()-1; n >= 0; --n) {
-        if (IsWindowEnabled(threadWnds[n])) {
+    for (int n = count-1; n >= 0; --n) {
+        if (snapshot.isEnabled(threadWnds[n])) {
             lastEnabled = threadWnds[n];
             break;
         }
@@ -171,13 +210,16 @@ void PinWnd::fixPopupZOrder(HWND appWnd)
         return;
 
     // 将所有禁用的（从最后一个开始）移动到最后一个启用的之后
-    for (int n = threadWnds.count()-1; n >= 0; --n) {
-        if (!IsWindowEnabled(threadWnds[n])) {
+    for (int n = count-1; n >= 0; --n) {
+        if (!snapshot.isEnabled(threadWnds[n])) {
             SetWindowPos(threadWnds[n], lastEnabled, 0,0,0,0, 
                 SWP_NOACTIVATE | SWP_NOMOVE | SWP_NOSIZE | SWP_NOOWNERZORDER);
         }
     }
 
+    // 层级已改变，缓存的顺序不再可信
+    Window::OwnershipGraph::getInstance().invalidateThread(GetWindowThreadProcessId(appWnd, nullptr));
+
 }
 
 
@@ -185,8 +227,11 @@ void PinWnd::evTimer(HWND wnd, Data& pd, UINT id)
 {
     if (id != 1) return;
 
+    // 本周期内的窗口状态统一从快照读取，同一窗口的每项查询只调用一次系统
+    Window::TickSnapshot& snapshot = Window::TickSnapshot::getInstance();
+
     // 应用窗口是否仍然存在？
-    if (!IsWindow(pd.topMostWnd)) {
+    if (!snapshot.isWindow(pd.topMostWnd)) {
         pd.topMostWnd = nullptr;
         pd.proxyWnd = nullptr;
         pd.proxyMode = false;
@@ -194,49 +239,46 @@ void PinWnd::evTimer(HWND wnd, Data& pd, UINT id)
         return;
     }
 
-    // 静态变量用于减少频繁的层级调整
-    static std::map<HWND, DWORD> lastTopStyleCheck;
-    static std::map<HWND, bool> lastMinimizedState;
-    
     DWORD currentTick = GetTickCount();
     HWND targetWnd = pd.getPinOwner();
     if (!targetWnd) {
         targetWnd = pd.topMostWnd;
     }
 
+    // 根据目标窗口的活动情况调整定时器间隔
+    updateTrackRate(wnd, pd, targetWnd, currentTick);
+
     // 对于现代Windows应用，添加额外的状态检测
-    if (Window::isModernWindowsApp(pd.topMostWnd)) {
+    if (pd.track.modernApp) {
         // 检查主窗口是否发生了状态变化（如最小化、恢复等）
-        bool currentMinimized = IsIconic(pd.topMostWnd);
-        bool lastMinimized = lastMinimizedState[pd.topMostWnd];
+        bool currentMinimized = snapshot.isIconic(pd.topMostWnd);
         
-        if (currentMinimized != lastMinimized) {
-            lastMinimizedState[pd.topMostWnd] = currentMinimized;
+        if (currentMinimized != pd.track.lastMinimized) {
+            pd.track.lastMinimized = currentMinimized;
             if (currentMinimized) {
                 // 现代应用窗口最小化，图钉将隐藏
             } else {
                 // 现代应用窗口恢复，图钉将重新显示并重新定位
                 // 窗口恢复时，可能需要重新查找代理窗口
                 if (pd.proxyMode) {
-                    Data* pdMutable = &pd;
-                    pdMutable->proxyWnd = nullptr; // 清除旧的代理窗口
+                    pd.proxyWnd = nullptr; // 清除旧的代理窗口
+                    pd.track.proxyBackoff = 0;
                 }
             }
         }
         
         // 检查代理窗口是否仍然有效
         if (pd.proxyMode && pd.proxyWnd) {
-            if (!IsWindow(pd.proxyWnd) || !IsWindowVisible(pd.proxyWnd)) {
-                Data* pdMutable = &pd;
-                pdMutable->proxyWnd = nullptr;
+            if (!snapshot.isWindow(pd.proxyWnd) || !snapshot.isVisible(pd.proxyWnd)) {
+                pd.proxyWnd = nullptr;
             }
         }
     }
 
     // 处理代理模式
     if (pd.proxyMode
-        && (!pd.proxyWnd || !IsWindowVisible(pd.proxyWnd))
-        && !selectProxy(wnd, pd)) {
+        && (!pd.proxyWnd || !snapshot.isVisible(pd.proxyWnd))
+        && !trySelectProxy(wnd, pd, currentTick)) {
         return;
     }
 
@@ -245,17 +287,17 @@ void PinWnd::evTimer(HWND wnd, Data& pd, UINT id)
         return;
     }
 
-    if (pd.proxyMode && !IsWindowEnabled(pd.topMostWnd)) {
+    if (pd.proxyMode && !snapshot.isEnabled(pd.topMostWnd)) {
         fixPopupZOrder(pd.topMostWnd);
     }
 
     // 减少频繁的层级检查 - 每500ms检查一次即可
-    bool needTopStyleCheck = (currentTick - lastTopStyleCheck[targetWnd]) > Constants::TOP_STYLE_CHECK_INTERVAL;
+    bool needTopStyleCheck = (currentTick - pd.track.lastTopStyleCheck) > Constants::TOP_STYLE_CHECK_INTERVAL;
     if (needTopStyleCheck) {
-        lastTopStyleCheck[targetWnd] = currentTick;
+        pd.track.lastTopStyleCheck = currentTick;
         
         // 只在必要时调用fixTopStyle，避免频繁的层级切换
-        LONG targetExStyle = GetWindowLong(targetWnd, GWL_EXSTYLE);
+        LONG targetExStyle = snapshot.getExStyle(targetWnd);
         if (!(targetExStyle & WS_EX_TOPMOST)) {
             fixTopStyle(targetWnd, pd);
         }
@@ -264,16 +306,21 @@ void PinWnd::evTimer(HWND wnd, Data& pd, UINT id)
     // 更新图钉位置
     placeOnCaption(wnd, pd);
     
+    // 覆盖层模式下图钉窗口保持隐藏，层级由覆盖层负责
+    if (Pin::PinOverlay::getInstance().isEnabled()) {
+        return;
+    }
+
     // 优化的层级管理策略 - 减少不必要的SetWindowPos调用
-    LONG pinExStyle = GetWindowLong(wnd, GWL_EXSTYLE);
+    LONG pinExStyle = snapshot.getExStyle(wnd);
     bool pinNeedsTopmost = !(pinExStyle & WS_EX_TOPMOST);
     
     if (pinNeedsTopmost) {
         SetWindowLong(wnd, GWL_EXSTYLE, pinExStyle | WS_EX_TOPMOST);
+        snapshot.invalidate(wnd);
         
-        // 只在图钉样式改变时才调整层级
-        SetWindowPos(wnd, HWND_TOP, 0, 0, 0, 0, 
-            SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
+        // 只在图钉样式改变时才调整层级，由层级管理器在本帧统一提交
+        Pin::ZOrderManager::getInstance().requestZOrder(wnd, HWND_TOP);
     }
 }
 
@@ -348,6 +395,11 @@ void PinWnd::evDpiChanged(HWND wnd, Data& pd, WPARAM wparam, LPARAM lparam)
     // 根据新DPI更新图钉大小
     SetWindowPos(wnd, 0, 0, 0, app.pinShape.getW(), app.pinShape.getH(), 
         SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE);
+
+    // 图钉已被直接移动，记录的位置不再可信
+    Pin::ZOrderManager::getInstance().forget(wnd);
+    pd.track.hasPlacedPos = false;
+    pd.track.predictor.reset();
     
     // 为新DPI更新窗口区域
     if (app.pinShape.getRgn()) {
@@ -378,11 +430,18 @@ bool PinWnd::evPinAssignWnd(HWND wnd, Data& pd, HWND target, int pollRate)
     }
 
     pd.topMostWnd = target;
+    pd.track = Data::TrackState();
+
+    // 目标的应用类型在绑定期间不会改变，只在此处判断一次
+    pd.track.modernApp = Window::isModernWindowsApp(target);
+    pd.track.lastMinimized = !!IsIconic(target);
 
     // 决定代理模式 - 使用改进的检测逻辑
     if (Window::needsProxyMode(target)) {
         // 设置代理模式标志；我们稍后会找到代理窗口
         pd.proxyMode = true;
+        // 代理查找和弹出窗口层级修正都需要目标线程的窗口，由所有关系图缓存
+        pd.track.graphThreadId = Window::OwnershipGraph::getInstance().track(target);
     }
 
     // 只有在非代理模式或已找到有效代理窗口时才设置父窗口关系
@@ -394,8 +453,8 @@ bool PinWnd::evPinAssignWnd(HWND wnd, Data& pd, HWND target, int pollRate)
         if (!SetWindowLongPtr(wnd, GWLP_HWNDPARENT, reinterpret_cast<LONG_PTR>(pinOwner)) && GetLastError()) {
             // 对于某些现代Windows应用（如设置、计算器等），SetWindowLongPtr可能会失败
             // 但这不影响图钉的基本功能（置顶），所以只记录警告而不显示错误弹窗
-            LOG_WARNING(std::wstring(L"无法设置图钉的父窗口关系，但图钉功能仍然正常。目标窗口句柄: 0x") + 
-                       std::to_wstring(reinterpret_cast<uintptr_t>(pinOwner)));
+            LOG_WARNING(std::wstring(L"无法设置图钉的父窗口关系，但图钉功能仍然正常。目标窗口句柄: ") + 
+                       Foundation::StringUtils::handleToHex(pinOwner));
         }
     } else if (pd.proxyMode) {
         // 在代理模式下，代理窗口会在后续的定时器中通过selectProxy函数查找
@@ -411,6 +470,10 @@ bool PinWnd::evPinAssignWnd(HWND wnd, Data& pd, HWND target, int pollRate)
         return false;
     }
 
+    // 绑定成功，立即登记，使调用者随后的查找能找到此图钉
+    Pin::PinRegistry::add(wnd, target);
+    Pin::WindowBindingManager::addBoundWindow(target);
+
     // 设置窗口区域
     if (app.pinShape.getRgn()) {
         auto rgnGuard = Util::RAII::makeRegionGuard(CreateRectRgn(0,0,0,0));
@@ -428,28 +491,44 @@ bool PinWnd::evPinAssignWnd(HWND wnd, Data& pd, HWND target, int pollRate)
     SetWindowPos(wnd, 0, 0, 0, app.pinShape.getW(), app.pinShape.getH(), 
         SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE);
     
-    // 计算并设置图钉位置
+    // 计算并设置图钉位置；立即提交，确保显示前已位于标题栏上
+    // （批量操作时由批量结束时的一次提交完成，之后统一显示）
+    bool batch = Pin::PinManager::inBatch();
     placeOnCaption(wnd, pd);
-    
-    // 显示图钉窗口
-    ShowWindow(wnd, SW_SHOW);
+    if (Pin::PinOverlay::getInstance().isEnabled()) {
+        // 覆盖层模式：图钉窗口保持隐藏，由覆盖层在提交时绘制
+        Pin::PinOverlay::getInstance().setVisible(wnd, true);
+        if (!batch) {
+            Pin::ZOrderManager::getInstance().commit();
+        }
+    } else if (batch) {
+        Pin::PinManager::deferShow(wnd);
+    } else {
+        Pin::ZOrderManager::getInstance().commit();
+        ShowWindow(wnd, SW_SHOW);
+    }
     
     // 统一的层级设置策略 - 修复多图钉显示问题
-    // 确保图钉具有TOPMOST属性
-    LONG exStyle = GetWindowLong(wnd, GWL_EXSTYLE);
-    if (!(exStyle & WS_EX_TOPMOST)) {
-        SetWindowLong(wnd, GWL_EXSTYLE, exStyle | WS_EX_TOPMOST);
+    if (!Pin::PinOverlay::getInstance().isEnabled()) {
+        // 确保图钉具有TOPMOST属性
+        LONG exStyle = GetWindowLong(wnd, GWL_EXSTYLE);
+        if (!(exStyle & WS_EX_TOPMOST)) {
+            SetWindowLong(wnd, GWL_EXSTYLE, exStyle | WS_EX_TOPMOST);
+        }
+        
+        // 使用HWND_TOP确保图钉在所有TOPMOST窗口的最前面
+        // 交给层级管理器与其他图钉的调整一起提交，避免多个图钉之间的层级冲突
+        Pin::ZOrderManager::getInstance().requestZOrder(wnd, HWND_TOP);
     }
-    
-    // 使用HWND_TOP确保图钉在所有TOPMOST窗口的最前面
-    // 这样可以避免多个图钉之间的层级冲突
-    SetWindowPos(wnd, HWND_TOP, 0, 0, 0, 0, 
-        SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
 
-    SetForegroundWindow(pd.topMostWnd);
+    // 批量操作不逐个切换前台窗口
+    if (!batch) {
+        SetForegroundWindow(pd.topMostWnd);
+    }
 
-    // 启动轮询定时器
-    SetTimer(wnd, 1, pollRate, 0);
+    // 启动轮询定时器，以用户设置的频率开始跟踪
+    pd.track.rate.reset(pollRate, GetTickCount());
+    setTrackRate(wnd, pollRate);
 
     return true;
 }
@@ -465,11 +544,167 @@ void PinWnd::evPinResetTimer(HWND wnd, Data& pd, int pollRate)
 {
     // 只有在有被钉住的窗口时才设置它
     if (pd.topMostWnd) {
-        SetTimer(wnd, 1, pollRate, 0);
+        pd.track.rate.reset(pollRate, GetTickCount());
+        setTrackRate(wnd, pollRate);
+    }
+}
+
+
+// 目标窗口发生了变化（由事件钩子通知），恢复快速跟踪。
+void PinWnd::evPinWake(HWND wnd, Data& pd)
+{
+    if (!pd.topMostWnd) {
+        return;
+    }
+
+    if (pd.track.rate.wake(GetTickCount())) {
+        setTrackRate(wnd, pd.track.rate.fast());
+        // 定时器处于慢速状态，立即跟踪一次，不等待下一个周期
+        evTimer(wnd, pd, 1);
+    }
+}
+
+
+// 跟踪定时由主窗口上的调度器统一驱动，图钉自身不再持有定时器。
+void PinWnd::setTrackRate(HWND wnd, int rate)
+{
+    Pin::TrackScheduler::getInstance().schedule(wnd, rate, trackTick);
+}
+
+
+void PinWnd::trackTick(HWND wnd)
+{
+    if (Data* pd = Data::get(wnd)) {
+        evTimer(wnd, *pd, 1);
     }
 }
 
 
+// 自适应跟踪。
+// 目标窗口的位置、可见性或前台状态发生变化时立即恢复为用户设置的频率；
+// 静止超过IDLE_TRACK_DELAY后每个周期把间隔加倍，直到达到静止间隔。
+// 逐步放慢而不是直接切换，避免窗口间歇移动时频率来回跳动。
+void PinWnd::updateTrackRate(HWND wnd, Data& pd, HWND targetWnd, DWORD now)
+{
+    // 需要时订阅目标进程的事件：静止期间由事件唤醒图钉，帧同步模式下由事件标记图钉。
+    // 三者都关闭后（如在设置中关闭）取消订阅，不再让目标进程的事件唤醒图钉
+    bool needEvents = opt.adaptiveTracking || Pin::FrameSync::getInstance().isRunning()
+        || Pin::PinOverlay::getInstance().isEnabled();
+    if (needEvents && !pd.track.hookProcessId) {
+        subscribeTarget(pd);
+    } else if (!needEvents && pd.track.hookProcessId) {
+        unsubscribeTarget(pd);
+    }
+
+    if (!opt.adaptiveTracking) {
+        if (pd.track.rate.wake(now)) {
+            setTrackRate(wnd, pd.track.rate.fast());
+        }
+        return;
+    }
+
+    Window::TickSnapshot& snapshot = Window::TickSnapshot::getInstance();
+    RECT rc = {};
+    snapshot.getRect(targetWnd, rc);
+    bool visible = snapshot.isVisible(pd.topMostWnd) && !snapshot.isIconic(pd.topMostWnd);
+    bool foreground = GetForegroundWindow() == pd.topMostWnd;
+
+    bool changed = !EqualRect(&rc, &pd.track.lastTargetRect)
+        || visible != pd.track.lastVisible
+        || foreground != pd.track.lastForeground;
+    if (changed) {
+        pd.track.lastTargetRect = rc;
+        pd.track.lastVisible = visible;
+        pd.track.lastForeground = foreground;
+    }
+
+    int previous = pd.track.rate.current();
+    int rate = pd.track.rate.update(changed, now, opt.idleTrackRate.value, Constants::IDLE_TRACK_DELAY);
+    if (rate != previous) {
+        setTrackRate(wnd, rate);
+    }
+}
+
+
+void PinWnd::subscribeTarget(Data& pd)
+{
+    DWORD processId = 0;
+    GetWindowThreadProcessId(pd.topMostWnd, &processId);
+    if (!processId) {
+        return;
+    }
+    Window::WinEventHookManager& hooks = Window::WinEventHookManager::getInstance();
+    hooks.acquire(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_MINIMIZEEND, targetEventProc, processId);
+    hooks.acquire(EVENT_OBJECT_SHOW, EVENT_OBJECT_HIDE, targetEventProc, processId);
+    hooks.acquire(EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_LOCATIONCHANGE, targetEventProc, processId);
+    pd.track.hookProcessId = processId;
+}
+
+
+void PinWnd::unsubscribeTarget(Data& pd)
+{
+    if (!pd.track.hookProcessId) {
+        return;
+    }
+    Window::WinEventHookManager& hooks = Window::WinEventHookManager::getInstance();
+    hooks.release(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_MINIMIZEEND, targetEventProc, pd.track.hookProcessId);
+    hooks.release(EVENT_OBJECT_SHOW, EVENT_OBJECT_HIDE, targetEventProc, pd.track.hookProcessId);
+    hooks.release(EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_LOCATIONCHANGE, targetEventProc, pd.track.hookProcessId);
+    pd.track.hookProcessId = 0;
+}
+
+
+// 目标进程的窗口事件：唤醒对应的图钉。
+void CALLBACK PinWnd::targetEventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd,
+                                      LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime)
+{
+    if (idObject != OBJID_WINDOW || idChild != CHILDID_SELF) {
+        return;
+    }
+    if (HWND pin = Pin::PinRegistry::findPin(hwnd)) {
+        // 帧同步模式下目标移动时由帧线程驱动定位
+        if (event == EVENT_OBJECT_LOCATIONCHANGE) {
+            Pin::FrameSync::getInstance().markDirty(pin, syncToFrame);
+        }
+        // 被钉住的窗口激活后会盖住覆盖层，需要把覆盖层重新提到最前
+        if (event == EVENT_SYSTEM_FOREGROUND) {
+            Pin::PinOverlay::getInstance().raise();
+        }
+        SendMessage(pin, App::WM_PIN_WAKE, 0, 0);
+    }
+}
+
+
+// 帧同步模式下每帧调用：按目标当前位置重新定位图钉，返回图钉是否需要移动。
+bool PinWnd::syncToFrame(HWND wnd)
+{
+    Data* pd = Data::get(wnd);
+    if (!pd || !pd->topMostWnd || !isPinShown(wnd)) {
+        return false;
+    }
+
+    // 每帧都需要目标的实时位置，不使用跨帧的缓存
+    HWND pinOwner = pd->getPinOwner();
+    Window::WindowCache::getInstance().invalidateWindow(pinOwner ? pinOwner : pd->topMostWnd);
+
+    POINT last = pd->track.lastPlacedPos;
+    bool hadPos = pd->track.hasPlacedPos;
+    placeOnCaption(wnd, *pd);
+    return pd->track.hasPlacedPos
+        && (!hadPos || last.x != pd->track.lastPlacedPos.x || last.y != pd->track.lastPlacedPos.y);
+}
+
+
+// 图钉当前是否显示（覆盖层模式下以覆盖层中的状态为准）
+bool PinWnd::isPinShown(HWND wnd)
+{
+    if (Pin::PinOverlay::getInstance().isEnabled()) {
+        return Pin::PinOverlay::getInstance().isVisible(wnd);
+    }
+    return !!Window::Cached::isWindowVisible(wnd);
+}
+
+
 // VCL应用程序的补丁（所有者的所有者问题）。
 // 如果被钉住的窗口和图钉窗口的可见性状态不同
 // 将图钉状态更改为被钉住窗口状态。
@@ -478,14 +713,15 @@ void PinWnd::evPinResetTimer(HWND wnd, Data& pd, int pollRate)
 bool PinWnd::fixVisible(HWND wnd, const Data& pd)
 {
     // 合理性检查
-    if (!IsWindow(pd.topMostWnd)) return false;
+    Window::TickSnapshot& snapshot = Window::TickSnapshot::getInstance();
+    if (!snapshot.isWindow(pd.topMostWnd)) return false;
 
     HWND pinOwner = pd.getPinOwner();
     if (!pinOwner) return false;
 
     // 对于现代Windows应用，需要特殊的最小化检测逻辑
     bool ownerVisible;
-    if (Window::isModernWindowsApp(pd.topMostWnd)) {
+    if (pd.track.modernApp) {
         // 对于现代Windows应用，检查主窗口和代理窗口的状态
         // 使用缓存的API减少系统调用
         bool mainWndVisible = Window::Cached::isWindowVisible(pd.topMostWnd) && 
@@ -502,7 +738,7 @@ bool PinWnd::fixVisible(HWND wnd, const Data& pd)
             ownerVisible = false;
         }
         // 如果代理窗口存在且状态正常，使用代理窗口状态
-        else if (pd.proxyWnd && IsWindow(pd.proxyWnd)) {
+        else if (pd.proxyWnd && snapshot.isWindow(pd.proxyWnd)) {
             ownerVisible = proxyWndVisible;
         }
         // 否则使用主窗口状态
@@ -511,7 +747,7 @@ bool PinWnd::fixVisible(HWND wnd, const Data& pd)
         }
         
         // 如果代理窗口失效，尝试重新查找
-        if (pd.proxyMode && pd.proxyWnd && !IsWindow(pd.proxyWnd)) {
+        if (pd.proxyMode && pd.proxyWnd && !snapshot.isWindow(pd.proxyWnd)) {
             Data* pdMutable = const_cast<Data*>(&pd);
             pdMutable->proxyWnd = nullptr;
             // 重新查找代理窗口的逻辑会在evTimer中的selectProxy调用中处理
@@ -524,11 +760,15 @@ bool PinWnd::fixVisible(HWND wnd, const Data& pd)
                       !Window::Cached::isWindowIconic(pinOwner);
     }
     
-    bool pinVisible = !!Window::Cached::isWindowVisible(wnd);
+    bool pinVisible = isPinShown(wnd);
     if (ownerVisible != pinVisible) {
-        ShowWindow(wnd, ownerVisible ? SW_SHOWNOACTIVATE : SW_HIDE);
-        // 窗口状态改变后，使缓存失效
-        Window::WindowCache::getInstance().invalidateWindow(wnd);
+        if (Pin::PinOverlay::getInstance().isEnabled()) {
+            Pin::PinOverlay::getInstance().setVisible(wnd, ownerVisible);
+        } else {
+            ShowWindow(wnd, ownerVisible ? SW_SHOWNOACTIVATE : SW_HIDE);
+            // 窗口状态改变后，使缓存失效
+            Window::WindowCache::getInstance().invalidateWindow(wnd);
+        }
     }
 
     // 返回图钉现在是否可见
@@ -540,7 +780,7 @@ bool PinWnd::fixVisible(HWND wnd, const Data& pd)
 void PinWnd::fixTopStyle(HWND wnd, const Data& pd)
 {
     // 合理性检查
-    if (!IsWindow(pd.topMostWnd)) return;
+    if (!Window::TickSnapshot::getInstance().isWindow(pd.topMostWnd)) return;
 
     HWND pinOwner = pd.getPinOwner();
     if (!pinOwner) return;
@@ -553,15 +793,13 @@ void PinWnd::fixTopStyle(HWND wnd, const Data& pd)
     bool pinTopMost = !!(pinStyle & WS_EX_TOPMOST);
 
     if (ownerTopMost != pinTopMost) {
-        SetWindowPos(wnd, ownerTopMost ? HWND_TOPMOST : HWND_NOTOPMOST, 
-                     0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
-        // 窗口样式改变后，使缓存失效
-        Window::WindowCache::getInstance().invalidateWindow(wnd);
+        // 由层级管理器批量提交，提交时使缓存失效
+        Pin::ZOrderManager::getInstance().requestZOrder(wnd, ownerTopMost ? HWND_TOPMOST : HWND_NOTOPMOST);
     }
 }
 
 
-void PinWnd::placeOnCaption(HWND wnd, const Data& pd)
+void PinWnd::placeOnCaption(HWND wnd, Data& pd)
 {
     HWND pinOwner = pd.getPinOwner();
     
@@ -575,7 +813,7 @@ void PinWnd::placeOnCaption(HWND wnd, const Data& pd)
     }
 
     // 对于现代Windows应用，检查窗口状态
-    if (Window::isModernWindowsApp(pd.topMostWnd)) {
+    if (pd.track.modernApp) {
         // 如果主窗口最小化，不更新图钉位置（图钉应该已经隐藏）
         // 使用缓存的API减少系统调用
         if (Window::Cached::isWindowIconic(pd.topMostWnd)) {
@@ -595,7 +833,11 @@ void PinWnd::placeOnCaption(HWND wnd, const Data& pd)
 
     // 获取窗口矩形 - 对于现代Windows应用使用可视边框
     RECT pinned;
-    if (Window::isModernWindowsApp(pd.topMostWnd)) {
+    int x, y;
+    int pinWidth = app.pinShape.getW();
+    RECT screenRect;
+    bool clampToWorkArea = false;
+    if (pd.track.modernApp) {
         // 对于现代Windows应用，使用特殊的矩形获取方法
         if (!Window::getVisibleWindowRect(pinOwner, pinned)) {
             if (!Window::Cached::getWindowRect(pinOwner, pinned)) {
@@ -613,24 +855,13 @@ void PinWnd::placeOnCaption(HWND wnd, const Data& pd)
         // 对于现代Windows应用，可能需要调整位置计算
         // 因为它们的标题栏可能有不同的布局
         int windowWidth = pinned.right - pinned.left;
-        int pinWidth = app.pinShape.getW();
-        int x = pinned.left + (windowWidth - pinWidth) / 2;
+        x = pinned.left + (windowWidth - pinWidth) / 2;
         
         // 对于现代应用，图钉位置可能需要更靠近窗口顶部
-        int y = pinned.top + 15;  // 减少偏移量，更靠近顶部
+        y = pinned.top + 15;  // 减少偏移量，更靠近顶部
         
-        // 确保图钉不会超出屏幕边界
-        RECT screenRect;
-        SystemParametersInfo(SPI_GETWORKAREA, 0, &screenRect, 0);
-        
-        if (x < screenRect.left) x = screenRect.left;
-        if (x + pinWidth > screenRect.right) x = screenRect.right - pinWidth;
-        if (y < screenRect.top) y = screenRect.top;
-        
-        SetWindowPos(wnd, NULL, x, y, 0, 0, 
-            SWP_NOSIZE | SWP_NOACTIVATE | SWP_NOZORDER);
-        // 窗口位置改变后，使缓存失效
-        Window::WindowCache::getInstance().invalidateWindow(wnd);
+        // 图钉不应超出目标窗口所在显示器的工作区，在预测之后限制
+        clampToWorkArea = Graphics::MonitorTopology::getInstance().workAreaFromRect(pinned, screenRect);
     } else {
         // 传统应用的位置计算
         if (!Window::Cached::getWindowRect(pinOwner, pinned)) {
@@ -638,86 +869,122 @@ void PinWnd::placeOnCaption(HWND wnd, const Data& pd)
         }
         
         int windowWidth = pinned.right - pinned.left;
-        int pinWidth = app.pinShape.getW();
-        int x = pinned.left + (windowWidth - pinWidth) / 2;
-        int y = pinned.top + 20;
-        
-        SetWindowPos(wnd, NULL, x, y, 0, 0, 
-            SWP_NOSIZE | SWP_NOACTIVATE | SWP_NOZORDER);
-        // 窗口位置改变后，使缓存失效
-        Window::WindowCache::getInstance().invalidateWindow(wnd);
+        x = pinned.left + (windowWidth - pinWidth) / 2;
+        y = pinned.top + 20;
+    }
+
+    // 拖动时把图钉放在目标下一帧将到达的位置；停止时预测器立即回到实际位置。
+    // 预测器使用未限制的位置，否则贴近工作区边缘拖动时速度估计会被截断
+    if (opt.predictMotion) {
+        double now = preciseTimeMs();
+        pd.track.predictor.addSample(now, Foundation::MotionPredictor::Point{ x, y });
+        Foundation::MotionPredictor::Point predicted = pd.track.predictor.predict(now + Constants::PREDICTION_HORIZON);
+        x = predicted.x;
+        y = predicted.y;
+    }
+
+    // 限制预测后的位置，外推不会把图钉带出工作区
+    if (clampToWorkArea) {
+        if (x < screenRect.left) x = screenRect.left;
+        if (x + pinWidth > screenRect.right) x = screenRect.right - pinWidth;
+        if (y < screenRect.top) y = screenRect.top;
+    }
+
+    // 位置未变化时不产生任何请求
+    if (pd.track.hasPlacedPos && pd.track.lastPlacedPos.x == x && pd.track.lastPlacedPos.y == y) {
+        return;
+    }
+    pd.track.lastPlacedPos = POINT{ x, y };
+    pd.track.hasPlacedPos = true;
+    if (Pin::PinOverlay::getInstance().isEnabled()) {
+        Pin::PinOverlay::getInstance().setPosition(wnd, x, y);
+    } else {
+        Pin::ZOrderManager::getInstance().requestMove(wnd, x, y);
     }
 }
 
 
-bool PinWnd::selectProxy(HWND wnd, const Data& pd)
+// 查找代理窗口；连续失败时按指数退避，避免对没有可用代理的目标每个周期都枚举窗口
+bool PinWnd::trySelectProxy(HWND wnd, Data& pd, DWORD now)
 {
-    HWND appWnd = pd.topMostWnd;
-    if (!IsWindow(appWnd)) return false;
+    size_t generation = Window::OwnershipGraph::getInstance().generation(pd.track.graphThreadId);
+    if (pd.track.proxyBackoff
+        && generation == pd.track.proxyGeneration
+        && static_cast<int>(now - pd.track.proxyRetryTick) < 0) {
+        ++pd.track.proxyStats.skipped;
+        return false;
+    }
 
-    DWORD thread = GetWindowThreadProcessId(appWnd, 0);
-    
-    // 对于现代Windows应用，使用增强的代理窗口查找策略
-    if (Window::isModernWindowsApp(appWnd)) {
-        // 首先尝试标准的枚举方式
-        bool found = EnumThreadWindows(thread, (WNDENUMPROC)enumThreadWndProc, 
-            LPARAM(wnd)) && pd.getPinOwner();
-        
-        if (!found) {
-            // 如果标准方式失败，尝试查找子窗口
-            Data* pdMutable = const_cast<Data*>(&pd);
-            EnumChildWindows(appWnd, (WNDENUMPROC)enumChildWndProc, LPARAM(wnd));
-            found = pd.getPinOwner() != nullptr;
-        }
-        
-        return found;
-    } else {
-        // 对于传统应用，使用原有的查找方式
-        return EnumThreadWindows(thread, (WNDENUMPROC)enumThreadWndProc, 
-            LPARAM(wnd)) && pd.getPinOwner();
+    ++pd.track.proxyStats.searches;
+    if (selectProxy(wnd, pd)) {
+        pd.track.proxyBackoff = 0;
+        return true;
     }
+
+    ++pd.track.proxyStats.failures;
+    pd.track.proxyBackoff = pd.track.proxyBackoff
+        ? (std::min)(pd.track.proxyBackoff * 2, DWORD(Constants::MAX_PROXY_RETRY))
+        : DWORD(Constants::MIN_PROXY_RETRY);
+    pd.track.proxyRetryTick = now + pd.track.proxyBackoff;
+    pd.track.proxyGeneration = generation;
+    return false;
 }
 
 
-BOOL CALLBACK PinWnd::enumThreadWndProc(HWND wnd, LPARAM param)
+bool PinWnd::getProxyStats(HWND pin, ProxyStats& stats)
 {
-    HWND pin = HWND(param);
     Data* pd = Data::get(pin);
-    if (!pd)
-        return false;
+    if (!pd) return false;
+    stats = pd->track.proxyStats;
+    return true;
+}
 
-    if (GetWindow(wnd, GW_OWNER) == pd->topMostWnd) {
-        // 使用缓存的API减少系统调用
-        if (Window::Cached::isWindowVisible(wnd) && 
-            !Window::Cached::isWindowIconic(wnd) && 
-            !Window::isWndRectEmpty(wnd)) {
-            pd->proxyWnd = wnd;
-            
-            // 设置代理窗口为图钉的父窗口
-            SetLastError(0);
-            if (!SetWindowLongPtr(pin, GWLP_HWNDPARENT, reinterpret_cast<LONG_PTR>(wnd)) && GetLastError()) {
-                // 对于某些现代Windows应用，设置父窗口关系可能失败，但不影响基本功能
-                LOG_WARNING(std::wstring(L"无法设置代理窗口的父子关系，但图钉功能仍然正常。代理窗口句柄: 0x") + 
-                           std::to_wstring(reinterpret_cast<uintptr_t>(wnd)));
-            }
-            
-            // 重新计算图钉位置，因为现在有了有效的代理窗口
-            placeOnCaption(pin, *pd);
-            
-            // 层级管理由evTimer统一处理，这里不做层级调整
-            // 只确保图钉具有TOPMOST属性
-            LONG exStyle = Window::Cached::getWindowLong(pin, GWL_EXSTYLE);
-            if (!(exStyle & WS_EX_TOPMOST)) {
-                SetWindowLong(pin, GWL_EXSTYLE, exStyle | WS_EX_TOPMOST);
-                // 窗口样式改变后，使缓存失效
-                Window::WindowCache::getInstance().invalidateWindow(pin);
-            }
-            
-            return false;   // 停止枚举
-        }
+
+bool PinWnd::selectProxy(HWND wnd, Data& pd)
+{
+    HWND appWnd = pd.topMostWnd;
+    if (!IsWindow(appWnd)) return false;
+
+    // 目标拥有的窗口由所有关系图缓存，不必每次枚举线程窗口
+    if (HWND proxy = Window::OwnershipGraph::getInstance().findProxy(appWnd)) {
+        assignProxy(wnd, pd, proxy);
+        return pd.getPinOwner() != nullptr;
     }
+    
+    // 对于现代Windows应用，使用增强的代理窗口查找策略：尝试查找子窗口
+    if (pd.track.modernApp) {
+        ++pd.track.proxyStats.childEnumerations;
+        EnumChildWindows(appWnd, (WNDENUMPROC)enumChildWndProc, LPARAM(wnd));
+        return pd.getPinOwner() != nullptr;
+    }
+    return false;
+}
 
-    return true;  // 继续枚举
+
+// 把找到的代理窗口设为图钉的所有者
+void PinWnd::assignProxy(HWND pin, Data& pd, HWND proxy)
+{
+    pd.proxyWnd = proxy;
+    
+    // 设置代理窗口为图钉的父窗口
+    SetLastError(0);
+    if (!SetWindowLongPtr(pin, GWLP_HWNDPARENT, reinterpret_cast<LONG_PTR>(proxy)) && GetLastError()) {
+        // 对于某些现代Windows应用，设置父窗口关系可能失败，但不影响基本功能
+        LOG_WARNING(std::wstring(L"无法设置代理窗口的父子关系，但图钉功能仍然正常。代理窗口句柄: ") + 
+                   Foundation::StringUtils::handleToHex(proxy));
+    }
+    
+    // 重新计算图钉位置，因为现在有了有效的代理窗口
+    placeOnCaption(pin, pd);
+    
+    // 层级管理由evTimer统一处理，这里不做层级调整
+    // 只确保图钉具有TOPMOST属性
+    LONG exStyle = Window::Cached::getWindowLong(pin, GWL_EXSTYLE);
+    if (!(exStyle & WS_EX_TOPMOST)) {
+        SetWindowLong(pin, GWL_EXSTYLE, exStyle | WS_EX_TOPMOST);
+        // 窗口样式改变后，使缓存失效
+        Window::WindowCache::getInstance().invalidateWindow(pin);
+    }
 }
 
 
@@ -734,22 +1001,18 @@ BOOL CALLBACK PinWnd::enumChildWndProc(HWND wnd, LPARAM param)
     if (Window::Cached::isWindowVisible(wnd) && 
         !Window::Cached::isWindowIconic(wnd) && 
         !Window::isWndRectEmpty(wnd)) {
-        // 获取窗口类名进行进一步筛选
-        std::wstring className = Window::Cached::getWindowClassName(wnd);
-        
-        // 优先选择这些类型的窗口作为代理
-        if (className == L"Windows.UI.Core.CoreWindow" ||
-            className == L"DirectUIHWND" ||
-            className.find(L"Chrome") != std::wstring::npos ||
-            className.find(L"Content") != std::wstring::npos) {
+        // 优先选择内容窗口（CoreWindow、DirectUIHWND及类名含Chrome/Content的窗口）作为代理，
+        // 类名的判断在驻留时完成
+        Window::ClassRegistry& classes = Window::ClassRegistry::getInstance();
+        if (classes.hasTrait(classes.classOf(wnd), Window::ClassRegistry::TRAIT_PROXY_CONTENT)) {
             
             pd->proxyWnd = wnd;
             
             // 设置代理窗口为图钉的父窗口
             SetLastError(0);
             if (!SetWindowLongPtr(pin, GWLP_HWNDPARENT, reinterpret_cast<LONG_PTR>(wnd)) && GetLastError()) {
-                LOG_WARNING(std::wstring(L"无法设置子窗口代理的父子关系，但图钉功能仍然正常。代理窗口句柄: 0x") + 
-                           std::to_wstring(reinterpret_cast<uintptr_t>(wnd)));
+                LOG_WARNING(std::wstring(L"无法设置子窗口代理的父子关系，但图钉功能仍然正常。代理窗口句柄: ") + 
+                           Foundation::StringUtils::handleToHex(wnd));
             }
             
             // 重新计算图钉位置
@@ -0,0 +1,133 @@
+#include "core/stdafx.h"
+#include "pin/track_scheduler.h"
+#include "pin/z_order_manager.h"
+#include "window/tick_snapshot.h"
+#include "core/application.h"
+#include "system/logger.h"
+
+namespace Pin {
+
+    TrackScheduler& TrackScheduler::getInstance() {
+        static TrackScheduler instance;
+        return instance;
+    }
+
+    ULONGLONG TrackScheduler::nowTicks() {
+        return GetTickCount64() / GRANULARITY;
+    }
+
+    void TrackScheduler::setNotifyWindow(HWND wnd) {
+        if (m_notifyWnd && m_armed) {
+            KillTimer(m_notifyWnd, App::TIMERID_TRACK);
+        }
+        m_notifyWnd = wnd;
+        m_armed = false;
+        rearm();
+    }
+
+    void TrackScheduler::schedule(HWND wnd, int interval, TickHandler handler) {
+        if (!wnd || !handler || interval <= 0) {
+            return;
+        }
+
+        ULONGLONG now = nowTicks();
+        ULONGLONG ticks = (static_cast<ULONGLONG>(interval) + GRANULARITY - 1) / GRANULARITY;
+
+        unsigned id;
+        auto it = m_index.find(wnd);
+        if (it != m_index.end()) {
+            id = it->second;
+            m_wheel.reschedule(id, ticks, now);
+        } else {
+            id = m_wheel.add(ticks, now);
+            m_index[wnd] = id;
+            if (id >= m_targets.size()) {
+                m_targets.resize(id + 1);
+            }
+        }
+        m_targets[id] = Target{ wnd, handler };
+
+        if (!m_dispatching) {
+            rearm();
+        }
+    }
+
+    void TrackScheduler::cancel(HWND wnd) {
+        auto it = m_index.find(wnd);
+        if (it == m_index.end()) {
+            return;
+        }
+
+        m_wheel.remove(it->second);
+        m_targets[it->second] = Target{};
+        m_index.erase(it);
+
+        if (!m_dispatching && m_index.empty()) {
+            rearm();
+        }
+    }
+
+    void TrackScheduler::onTimer() {
+        ++m_stats.wakeups;
+
+        // 同一刻度内所有图钉共用一份窗口状态快照，提交之后再丢弃
+        Window::TickSnapshot::Scope snapshot;
+
+        // 处理函数可以在其中重新调度或取消任意图钉（包括自身）
+        m_dispatching = true;
+        size_t dispatched = m_wheel.dispatch(nowTicks(), [this](unsigned id) {
+            Target target = m_targets[id];
+            target.handler(target.wnd);
+        });
+        m_dispatching = false;
+
+        m_stats.dispatched += dispatched;
+        if (dispatched > 1) {
+            ++m_stats.batches;
+        }
+
+        // 同一刻度到期的图钉的位置/层级调整一次提交
+        if (dispatched) {
+            ZOrderManager::getInstance().commit();
+        }
+
+        rearm();
+        reportStats();
+    }
+
+    void TrackScheduler::rearm() {
+        if (!m_notifyWnd) {
+            return;
+        }
+        if (m_wheel.empty()) {
+            if (m_armed) {
+                KillTimer(m_notifyWnd, App::TIMERID_TRACK);
+                m_armed = false;
+            }
+            return;
+        }
+
+        // 普通的窗口定时器：精度受系统时钟间隔限制（通常约15.6ms），
+        // 不提高系统计时精度，跟踪间隔本身不小于MIN_TRACK_RATE
+        ULONGLONG nowMs = GetTickCount64();
+        ULONGLONG dueMs = m_wheel.nextDeadline() * GRANULARITY;
+        UINT delay = dueMs > nowMs ? static_cast<UINT>(dueMs - nowMs) : USER_TIMER_MINIMUM;
+        m_armed = !!SetTimer(m_notifyWnd, App::TIMERID_TRACK, delay, nullptr);
+    }
+
+    void TrackScheduler::reportStats() {
+        m_statsReporter.update(GetTickCount(), m_stats, [this](const Stats& stats, const Stats& reported, DWORD elapsed) {
+            size_t wakeups = stats.wakeups - reported.wakeups;
+            size_t dispatched = stats.dispatched - reported.dispatched;
+            size_t batches = stats.batches - reported.batches;
+            double seconds = elapsed / 1000.0;
+
+            LOG_DEBUG(L"图钉跟踪: 图钉 " + std::to_wstring(m_index.size()) +
+                      L" 个, 唤醒 " + std::to_wstring(static_cast<int>(wakeups / seconds)) +
+                      L"/秒, 跟踪 " + std::to_wstring(static_cast<int>(dispatched / seconds)) +
+                      L"/秒, 合并唤醒 " + std::to_wstring(static_cast<int>(batches / seconds)) + L"/秒");
+            return true;
+        });
+    }
+
+} // namespace Pin
@@ -2,9 +2,12 @@
 #include "pin/window_binding_manager.h"
 #include "pin/pin_window.h"
 #include "pin/pin_manager.h"
+#include "pin/pin_registry.h"
+#include "pin/z_order_manager.h"
 #include "core/application.h"
 #include "system/logger.h"
 #include "window/window_helper.h"
+#include "window/win_event_hook_manager.h"
 #include <vector>
 #include <algorithm>
 
@@ -12,69 +15,33 @@ namespace Pin {
 
 // 静态成员变量定义
 bool WindowBindingManager::s_bindingEnabled = false;
-std::unordered_set<HWND> WindowBindingManager::s_boundWindows;
-HWINEVENTHOOK WindowBindingManager::s_minimizeEventHook = nullptr;
-HWINEVENTHOOK WindowBindingManager::s_moveEventHook = nullptr;
-std::unordered_map<HWND, POINT> WindowBindingManager::s_windowPositions;
+Foundation::BoundWindowSet<HWND, POINT> WindowBindingManager::s_bound;
+bool WindowBindingManager::s_initialized = false;
+std::unordered_map<HWND, DWORD> WindowBindingManager::s_windowProcesses;
+int WindowBindingManager::s_deferDepth = 0;
+std::unordered_map<HWND, bool> WindowBindingManager::s_deferred;
 
 bool WindowBindingManager::initialize() {
-    if (s_minimizeEventHook && s_moveEventHook) {
+    if (s_initialized) {
         return true; // 已经初始化
     }
+    s_initialized = true;
     
-    // 设置窗口事件钩子，监听窗口最小化和恢复事件
-    s_minimizeEventHook = SetWinEventHook(
-        EVENT_SYSTEM_MINIMIZESTART,     // 最小化开始
-        EVENT_SYSTEM_MINIMIZEEND,       // 最小化结束
-        nullptr,                        // 不指定模块
-        MinimizeEventProc,              // 回调函数
-        0,                              // 所有进程
-        0,                              // 所有线程
-        WINEVENT_OUTOFCONTEXT          // 异步调用
-    );
-    
-    // 设置窗口事件钩子，监听窗口位置变化事件
-    s_moveEventHook = SetWinEventHook(
-        EVENT_OBJECT_LOCATIONCHANGE,    // 位置变化事件
-        EVENT_OBJECT_LOCATIONCHANGE,    // 位置变化事件
-        nullptr,                        // 不指定模块
-        MoveEventProc,                  // 回调函数
-        0,                              // 所有进程
-        0,                              // 所有线程
-        WINEVENT_OUTOFCONTEXT          // 异步调用
-    );
-    
-    if (!s_minimizeEventHook || !s_moveEventHook) {
-        LOG_ERROR(L"无法设置窗口事件钩子");
-        cleanup(); // 清理已创建的钩子
-        return false;
-    }
+    // 最小化和位置变化事件钩子不再全局安装，而是在窗口加入绑定列表时
+    // 按其所属进程安装（见acquireHooks），避免接收整个桌面的事件
     
     // 初始化绑定窗口列表
     updateBoundWindows();
     
-    // 初始化窗口位置缓存
-    if (s_bindingEnabled) {
-        updateWindowPositions();
-    }
-    
     return true;
 }
 
 void WindowBindingManager::cleanup() {
-    if (s_minimizeEventHook) {
-        UnhookWinEvent(s_minimizeEventHook);
-        s_minimizeEventHook = nullptr;
-    }
+    releaseAllHooks();
     
-    if (s_moveEventHook) {
-        UnhookWinEvent(s_moveEventHook);
-        s_moveEventHook = nullptr;
-    }
-    
-    s_boundWindows.clear();
-    s_windowPositions.clear();
+    s_bound.clear();
     s_bindingEnabled = false;
+    s_initialized = false;
 }
 
 void WindowBindingManager::setBindingEnabled(bool enabled) {
@@ -85,8 +52,8 @@ void WindowBindingManager::setBindingEnabled(bool enabled) {
         updateBoundWindows();
     } else {
         // 禁用绑定时，清空绑定窗口列表
-        s_boundWindows.clear();
-        s_windowPositions.clear();
+        releaseAllHooks();
+        s_bound.clear();
     }
 }
 
@@ -95,29 +62,23 @@ void WindowBindingManager::updateBoundWindows() {
         return;
     }
     
-    // 清空当前绑定列表
-    s_boundWindows.clear();
-    
-    // 获取所有已置顶的窗口
-    std::vector<HWND> pinnedWindows = getAllPinnedWindows();
-    
-    // 将所有已置顶的窗口添加到绑定列表
-    for (HWND hwnd : pinnedWindows) {
-        s_boundWindows.insert(hwnd);
+    // 清空当前进程钩子，用所有已置顶的窗口重建绑定列表和位置缓存
+    releaseAllHooks();
+    s_bound.assign(getAllPinnedWindows(), [](HWND hwnd, POINT& position) {
+        // 与updateWindowPositions相同，不记录位置为原点的窗口
+        return locateWindow(hwnd, position) && (position.x != 0 || position.y != 0);
+    });
+    for (HWND hwnd : s_bound.windows()) {
+        acquireHooks(hwnd);
     }
-    
-    // 更新窗口位置缓存
-    updateWindowPositions();
 }
 
 std::vector<HWND> WindowBindingManager::getAllPinnedWindows() {
     std::vector<HWND> pinnedWindows;
     
-    // 枚举所有图钉窗口，获取被置顶的窗口
-    HWND pin = nullptr;
-    while ((pin = FindWindowEx(nullptr, pin, PinWnd::className, nullptr)) != nullptr) {
-        HWND pinnedWnd = reinterpret_cast<HWND>(SendMessage(pin, ::App::WM_PIN_GETPINNEDWND, 0, 0));
-        if (pinnedWnd && IsWindow(pinnedWnd)) {
+    // 从图钉注册表获取被置顶的窗口
+    for (HWND pinnedWnd : PinRegistry::targets()) {
+        if (IsWindow(pinnedWnd)) {
             pinnedWindows.push_back(pinnedWnd);
         }
     }
@@ -125,8 +86,100 @@ std::vector<HWND> WindowBindingManager::getAllPinnedWindows() {
     return pinnedWindows;
 }
 
+bool WindowBindingManager::locateWindow(HWND hwnd, POINT& position) {
+    if (!IsWindow(hwnd) || IsIconic(hwnd)) {
+        return false;
+    }
+    RECT rect;
+    if (!GetWindowRect(hwnd, &rect)) {
+        return false;
+    }
+    position = {rect.left, rect.top};
+    return true;
+}
+
+void WindowBindingManager::addBoundWindow(HWND hwnd) {
+    if (!s_bindingEnabled || !hwnd) {
+        return;
+    }
+    if (s_deferDepth) {
+        s_deferred[hwnd] = true;
+        return;
+    }
+    
+    // 只记录这一个窗口的位置；最小化的窗口等恢复后由位置变化事件补充
+    if (s_bound.add(hwnd, locateWindow)) {
+        acquireHooks(hwnd);
+    }
+}
+
+void WindowBindingManager::removeBoundWindow(HWND hwnd) {
+    if (s_deferDepth) {
+        s_deferred[hwnd] = false;
+        return;
+    }
+    if (s_bound.remove(hwnd)) {
+        releaseHooks(hwnd);
+    }
+}
+
+void WindowBindingManager::beginDeferUpdate() {
+    ++s_deferDepth;
+}
+
+void WindowBindingManager::endDeferUpdate() {
+    if (s_deferDepth <= 0 || --s_deferDepth > 0) {
+        return;
+    }
+    
+    // 同一窗口在推迟期间的多次变更只应用最终结果
+    std::unordered_map<HWND, bool> deferred;
+    deferred.swap(s_deferred);
+    for (const auto& item : deferred) {
+        if (item.second) {
+            addBoundWindow(item.first);
+        } else {
+            removeBoundWindow(item.first);
+        }
+    }
+}
+
+void WindowBindingManager::acquireHooks(HWND hwnd) {
+    DWORD processId = 0;
+    GetWindowThreadProcessId(hwnd, &processId);
+    if (!processId) {
+        return;
+    }
+    s_windowProcesses[hwnd] = processId;
+    
+    // 只监听绑定窗口所属进程的事件，同一进程的多个窗口共用钩子
+    Window::WinEventHookManager& hooks = Window::WinEventHookManager::getInstance();
+    hooks.acquire(EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND, MinimizeEventProc, processId);
+    hooks.acquire(EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_LOCATIONCHANGE, MoveEventProc, processId);
+}
+
+void WindowBindingManager::releaseHooks(HWND hwnd) {
+    auto it = s_windowProcesses.find(hwnd);
+    if (it == s_windowProcesses.end()) {
+        return;
+    }
+    DWORD processId = it->second;
+    s_windowProcesses.erase(it);
+    
+    Window::WinEventHookManager& hooks = Window::WinEventHookManager::getInstance();
+    hooks.release(EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND, MinimizeEventProc, processId);
+    hooks.release(EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_LOCATIONCHANGE, MoveEventProc, processId);
+}
+
+void WindowBindingManager::releaseAllHooks() {
+    Window::WinEventHookManager& hooks = Window::WinEventHookManager::getInstance();
+    hooks.releaseAll(MinimizeEventProc);
+    hooks.releaseAll(MoveEventProc);
+    s_windowProcesses.clear();
+}
+
 bool WindowBindingManager::isWindowBound(HWND hwnd) {
-    return s_boundWindows.find(hwnd) != s_boundWindows.end();
+    return s_bound.contains(hwnd);
 }
 
 void CALLBACK WindowBindingManager::MinimizeEventProc(HWINEVENTHOOK hWinEventHook, DWORD event, 
@@ -150,7 +203,8 @@ void CALLBACK WindowBindingManager::MinimizeEventProc(HWINEVENTHOOK hWinEventHoo
     switch (event) {
         case EVENT_SYSTEM_MINIMIZESTART:
             // 在最小化前，从位置缓存中移除该窗口，防止位置变化事件触发
-            s_windowPositions.erase(hwnd);
+            s_bound.committed().erase(hwnd);
+            s_bound.targets().erase(hwnd);
             
             // 窗口开始最小化，最小化所有其他绑定窗口
             minimizeAllBoundWindows(hwnd);
@@ -213,16 +267,33 @@ void CALLBACK WindowBindingManager::MoveEventProc(HWINEVENTHOOK hWinEventHook, D
             return;
         }
         
+        // 还有尚未提交的移动请求：这是之前某次提交的回显，
+        // 窗口随后会被移到请求的位置，不能当作外部移动
+        ZOrderManager& zorder = ZOrderManager::getInstance();
+        if (zorder.hasPendingMove(hwnd)) {
+            return;
+        }
+        
+        // 请求的移动已全部提交，目标位置成为已提交的位置
+        auto& committed = s_bound.committed();
+        auto& targets = s_bound.targets();
+        auto target = targets.find(hwnd);
+        if (target != targets.end()) {
+            committed[hwnd] = target->second;
+            targets.erase(target);
+        }
+        
         // 检查窗口位置是否在缓存中
-        auto it = s_windowPositions.find(hwnd);
-        if (it == s_windowPositions.end()) {
+        auto it = committed.find(hwnd);
+        if (it == committed.end()) {
             // 如果窗口位置不在缓存中，添加到缓存
             POINT currentPos = {currentRect.left, currentRect.top};
-            s_windowPositions[hwnd] = currentPos;
+            committed[hwnd] = currentPos;
             return;
         }
         
-        // 计算位置变化量
+        // 计算相对已提交位置的变化量
+        // 由我们移动的窗口到达已提交位置后变化量为0，从而不会再次带动其他窗口（避免连锁移动）
         int deltaX = currentRect.left - it->second.x;
         int deltaY = currentRect.top - it->second.y;
         
@@ -232,6 +303,9 @@ void CALLBACK WindowBindingManager::MoveEventProc(HWINEVENTHOOK hWinEventHook, D
             it->second.x = currentRect.left;
             it->second.y = currentRect.top;
             
+            // 窗口被外部移动，层级管理器记录的位置已不可信
+            zorder.forget(hwnd);
+            
             // 移动其他绑定窗口
             moveAllBoundWindows(hwnd, deltaX, deltaY);
         }
@@ -239,7 +313,7 @@ void CALLBACK WindowBindingManager::MoveEventProc(HWINEVENTHOOK hWinEventHook, D
 }
 
 void WindowBindingManager::minimizeAllBoundWindows(HWND excludeWindow) {
-    for (HWND hwnd : s_boundWindows) {
+    for (HWND hwnd : s_bound.windows()) {
         if (hwnd != excludeWindow && IsWindow(hwnd) && !IsIconic(hwnd)) {
             // 最小化窗口
             ShowWindow(hwnd, SW_MINIMIZE);
@@ -250,7 +324,7 @@ void WindowBindingManager::minimizeAllBoundWindows(HWND excludeWindow) {
 void WindowBindingManager::restoreAllBoundWindows(HWND excludeWindow) {
     // 首先收集所有需要恢复的窗口
     std::vector<HWND> windowsToRestore;
-    for (HWND hwnd : s_boundWindows) {
+    for (HWND hwnd : s_bound.windows()) {
         if (hwnd != excludeWindow && IsWindow(hwnd) && IsIconic(hwnd)) {
             windowsToRestore.push_back(hwnd);
         }
@@ -294,60 +368,50 @@ void WindowBindingManager::restoreAllBoundWindows(HWND excludeWindow) {
 }
 
 void WindowBindingManager::moveAllBoundWindows(HWND movedWindow, int deltaX, int deltaY) {
-    // 遍历所有绑定窗口
-    for (HWND hwnd : s_boundWindows) {
+    // 移动请求交给层级管理器：同一帧内的多次拖动事件对同一窗口只保留最新位置，
+    // 并在提交时通过一次DeferWindowPos批量应用到所有窗口
+    ZOrderManager& zorder = ZOrderManager::getInstance();
+    auto& committedPositions = s_bound.committed();
+    auto& targets = s_bound.targets();
+    
+    for (HWND hwnd : s_bound.windows()) {
         // 跳过触发移动的窗口和已最小化的窗口
         if (hwnd == movedWindow || !IsWindow(hwnd) || IsIconic(hwnd)) {
             continue;
         }
         
-        // 获取窗口当前位置
-        RECT currentRect;
-        if (!GetWindowRect(hwnd, &currentRect)) {
-            continue;
+        // 以尚未提交的目标位置或已提交的位置为基准，无需逐个查询窗口矩形
+        auto it = targets.find(hwnd);
+        if (it == targets.end()) {
+            POINT base;
+            auto committed = committedPositions.find(hwnd);
+            if (committed != committedPositions.end()) {
+                base = committed->second;
+            } else {
+                RECT currentRect;
+                if (!GetWindowRect(hwnd, &currentRect)) {
+                    continue;
+                }
+                base = {currentRect.left, currentRect.top};
+                committedPositions[hwnd] = base;
+            }
+            it = targets.emplace(hwnd, base).first;
         }
         
-        // 计算新位置
-        int newX = currentRect.left + deltaX;
-        int newY = currentRect.top + deltaY;
+        // 计算新的目标位置，提交后的回显事件据此确认
+        it->second.x += deltaX;
+        it->second.y += deltaY;
         
-        // 移动窗口，使用MoveWindow而不是SetWindowPos，避免改变Z顺序
-        RECT newRect = {
-            newX,
-            newY,
-            newX + (currentRect.right - currentRect.left),
-            newY + (currentRect.bottom - currentRect.top)
-        };
-        
-        Window::moveWindow(hwnd, newRect, TRUE);
-        
-        // 更新缓存中的位置
-        if (s_windowPositions.find(hwnd) != s_windowPositions.end()) {
-            s_windowPositions[hwnd].x = newX;
-            s_windowPositions[hwnd].y = newY;
-        } else {
-            s_windowPositions[hwnd] = {newX, newY};
-        }
+        zorder.requestMove(hwnd, it->second.x, it->second.y);
     }
 }
 
 void WindowBindingManager::updateWindowPositions() {
-    // 清空当前位置缓存
-    s_windowPositions.clear();
-    
-    // 遍历所有绑定窗口，更新位置缓存
-    for (HWND hwnd : s_boundWindows) {
-        // 只处理有效的、非最小化的窗口
-        if (IsWindow(hwnd) && !IsIconic(hwnd)) {
-            RECT rect;
-            if (GetWindowRect(hwnd, &rect)) {
-                // 确保窗口位置有效（非零）
-                if (rect.left != 0 || rect.top != 0) {
-                    s_windowPositions[hwnd] = {rect.left, rect.top};
-                }
-            }
-        }
-    }
+    // 清空当前位置缓存，重新查询所有有效的、非最小化的绑定窗口
+    s_bound.relocate([](HWND hwnd, POINT& position) {
+        // 确保窗口位置有效（非零）
+        return locateWindow(hwnd, position) && (position.x != 0 || position.y != 0);
+    });
     
     // 如果位置缓存为空，可能是所有窗口都最小化了
     // 这种情况下不需要特殊处理，等窗口恢复后会重新填充缓存
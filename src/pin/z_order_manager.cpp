@@ -0,0 +1,150 @@
+#include "core/stdafx.h"
+#include "pin/z_order_manager.h"
+#include "pin/pin_overlay.h"
+#include "core/application.h"
+#include "window/window_cache.h"
+#include "system/logger.h"
+
+namespace Pin {
+
+    namespace {
+        UINT placementFlags(const ZOrderRequest& req) {
+            return SWP_NOSIZE | SWP_NOACTIVATE
+                | (req.move ? 0 : SWP_NOMOVE)
+                | (req.zorder ? 0 : SWP_NOZORDER);
+        }
+
+        bool apply(const ZOrderRequest& req) {
+            return !!SetWindowPos(req.wnd, req.insertAfter, req.x, req.y, 0, 0, placementFlags(req));
+        }
+    }
+
+    ZOrderManager& ZOrderManager::getInstance() {
+        static ZOrderManager instance;
+        return instance;
+    }
+
+    void ZOrderManager::countRequest(bool merged) {
+        ++m_stats.requests;
+        if (merged) {
+            ++m_stats.merged;
+        } else {
+            // 本帧的第一个请求：通知主窗口在消息循环空闲时统一提交
+            requestCommit();
+        }
+    }
+
+    void ZOrderManager::requestCommit() {
+        if (!m_commitPosted && m_notifyWnd) {
+            m_commitPosted = !!PostMessage(m_notifyWnd, App::WM_COMMITZORDER, 0, 0);
+        }
+    }
+
+    void ZOrderManager::requestMove(HWND wnd, int x, int y) {
+        if (!wnd) return;
+        bool merged;
+        m_batch.requestMove(wnd, x, y, merged);
+        countRequest(merged);
+    }
+
+    void ZOrderManager::requestZOrder(HWND wnd, HWND insertAfter) {
+        if (!wnd) return;
+        bool merged;
+        m_batch.requestZOrder(wnd, insertAfter, merged);
+        countRequest(merged);
+    }
+
+    void ZOrderManager::forget(HWND wnd) {
+        m_batch.forget(wnd);
+    }
+
+    bool ZOrderManager::applyBatch(const std::vector<ZOrderRequest>& plan, std::vector<bool>& applied) {
+        applied.assign(plan.size(), true);
+        if (plan.empty()) return true;
+
+        // 单项时直接调用，省去DeferWindowPos结构的开销
+        if (plan.size() == 1) {
+            applied[0] = apply(plan.front());
+            return applied[0];
+        }
+
+        HDWP dwp = BeginDeferWindowPos(static_cast<int>(plan.size()));
+        for (const ZOrderRequest& req : plan) {
+            if (!dwp) break;
+            // DeferWindowPos失败时会自行释放整个结构
+            dwp = DeferWindowPos(dwp, req.wnd, req.insertAfter, req.x, req.y, 0, 0, placementFlags(req));
+        }
+        if (dwp && EndDeferWindowPos(dwp)) {
+            return true;
+        }
+
+        // 批量失败（例如某个窗口已被销毁）：逐个应用剩余有效窗口
+        for (size_t i = 0; i < plan.size(); ++i) {
+            applied[i] = IsWindow(plan[i].wnd) && apply(plan[i]);
+        }
+        return false;
+    }
+
+    void ZOrderManager::commit() {
+        m_commitPosted = false;
+
+        // 一次跟踪周期到此结束，下一周期重新查询窗口边框
+        app.dwm.endFrame();
+
+        // 覆盖层模式下图钉位置在此一并重绘
+        PinOverlay::getInstance().commit();
+
+        if (m_batch.empty()) return;
+
+        std::vector<ZOrderRequest> pending = m_batch.take();
+
+        // 剔除已销毁的窗口
+        pending.erase(std::remove_if(pending.begin(), pending.end(),
+            [this](const ZOrderRequest& req) {
+                if (IsWindow(req.wnd)) return false;
+                m_batch.forget(req.wnd);
+                return true;
+            }), pending.end());
+
+        size_t requested = pending.size();
+        std::vector<ZOrderRequest> plan = m_batch.buildPlan(pending);
+        m_stats.skipped += requested - plan.size();
+
+        if (!plan.empty()) {
+            ++m_stats.batches;
+            std::vector<bool> applied;
+            if (!applyBatch(plan, applied)) {
+                ++m_stats.fallbacks;
+            }
+
+            for (size_t i = 0; i < plan.size(); ++i) {
+                // 只记录成功应用的位置，失败的移动在下次请求时不会被当作无变化而剔除
+                if (applied[i]) {
+                    m_batch.markApplied(plan[i]);
+                    ++m_stats.applied;
+                }
+                // 窗口位置或层级改变后，使缓存失效
+                Window::WindowCache::getInstance().invalidateWindow(plan[i].wnd);
+            }
+        }
+
+        reportStats();
+    }
+
+    void ZOrderManager::reportStats() {
+        m_statsReporter.update(GetTickCount(), m_stats, [](const Stats& stats, const Stats& reported, DWORD elapsed) {
+            size_t requests = stats.requests - reported.requests;
+            size_t batches = stats.batches - reported.batches;
+            size_t applied = stats.applied - reported.applied;
+            double seconds = elapsed / 1000.0;
+
+            LOG_DEBUG(L"层级管理: 请求 " + std::to_wstring(static_cast<int>(requests / seconds)) +
+                      L"/秒, 批量提交 " + std::to_wstring(static_cast<int>(batches / seconds)) +
+                      L"/秒, 应用窗口项 " + std::to_wstring(static_cast<int>(applied / seconds)) +
+                      L"/秒, 累计剔除 " + std::to_wstring(stats.skipped) +
+                      L", 累计回退 " + std::to_wstring(stats.fallbacks));
+            return true;
+        });
+    }
+
+} // namespace Pin
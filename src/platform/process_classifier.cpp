@@ -0,0 +1,155 @@
+#include "core/stdafx.h"
+#include "platform/process_classifier.h"
+#include "system/logger.h"
+#include <appmodel.h>  // 用于GetPackageFullName
+
+namespace Platform {
+
+    namespace {
+        // 无法打开的进程（如权限更高的进程）重新尝试的间隔（毫秒）
+        constexpr DWORD INACCESSIBLE_RETRY_INTERVAL = 5000;
+        // 检查所有缓存项、关闭已退出进程句柄的间隔（毫秒）
+        constexpr DWORD PRUNE_INTERVAL = 1000;
+    }
+
+    ProcessClassifier& ProcessClassifier::getInstance() {
+        static ProcessClassifier instance;
+        return instance;
+    }
+
+    ProcessClassifier::~ProcessClassifier() {
+        clear();
+    }
+
+    unsigned ProcessClassifier::classifyWindow(HWND wnd) {
+        DWORD pid = 0;
+        GetWindowThreadProcessId(wnd, &pid);
+        return pid ? classifyProcess(pid) : 0;
+    }
+
+    unsigned ProcessClassifier::classifyProcess(DWORD pid) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        DWORD now = GetTickCount();
+        ++m_stats.lookups;
+
+        // 已退出进程的句柄会让系统保留进程对象，定期检查并尽早关闭
+        if (now - m_lastPruneTick >= PRUNE_INTERVAL) {
+            pruneLocked(now);
+        }
+
+        auto it = m_entries.find(pid);
+        if (it != m_entries.end()) {
+            if (isEntryAlive(it->second, now)) {
+                ++m_stats.hits;
+                reportStats(now);
+                return it->second.flags;
+            }
+            // 进程已退出（PID可能被重用），重新分类
+            closeEntry(it->second);
+            m_entries.erase(it);
+            ++m_stats.evictions;
+        }
+
+        Entry entry = classify(pid);
+        unsigned flags = entry.flags;
+        m_entries[pid] = entry;
+        reportStats(now);
+        return flags;
+    }
+
+    bool ProcessClassifier::isEntryAlive(const Entry& entry, DWORD now) {
+        if (!entry.process) {
+            return now - entry.classifiedTick < INACCESSIBLE_RETRY_INTERVAL;
+        }
+        // 持有句柄期间PID不会被重用，只需确认进程仍在运行。
+        // 不使用GetExitCodeProcess：进程可能以STILL_ACTIVE(259)作为退出码
+        return WaitForSingleObject(entry.process, 0) == WAIT_TIMEOUT;
+    }
+
+    ProcessClassifier::Entry ProcessClassifier::classify(DWORD pid) {
+        Entry entry;
+        entry.classifiedTick = GetTickCount();
+
+        ++m_stats.openProcess;
+        HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | SYNCHRONIZE, FALSE, pid);
+        bool waitable = process != nullptr;
+        if (!process) {
+            // 部分受保护的进程不允许SYNCHRONIZE，仍可查询分类，按无法打开的进程定期重新分类
+            ++m_stats.openProcess;
+            process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+            if (!process) {
+                return entry;
+            }
+        }
+        entry.flags |= ACCESSIBLE;
+
+        // 如果GetPackageFullName返回ERROR_INSUFFICIENT_BUFFER，说明这是一个打包应用
+        UINT32 length = 0;
+        if (GetPackageFullName(process, &length, nullptr) == ERROR_INSUFFICIENT_BUFFER) {
+            entry.flags |= PACKAGED;
+        }
+
+        if (waitable) {
+            entry.process = process;
+        } else {
+            CloseHandle(process);
+        }
+        return entry;
+    }
+
+    void ProcessClassifier::closeEntry(Entry& entry) {
+        if (entry.process) {
+            CloseHandle(entry.process);
+            entry.process = nullptr;
+        }
+    }
+
+    void ProcessClassifier::pruneExited() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pruneLocked(GetTickCount());
+    }
+
+    void ProcessClassifier::pruneLocked(DWORD now) {
+        m_lastPruneTick = now;
+        for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+            if (!isEntryAlive(it->second, now)) {
+                closeEntry(it->second);
+                it = m_entries.erase(it);
+                ++m_stats.evictions;
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    ProcessClassifier::Stats ProcessClassifier::getStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Stats stats = m_stats;
+        stats.entries = m_entries.size();
+        return stats;
+    }
+
+    void ProcessClassifier::clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& item : m_entries) {
+            closeEntry(item.second);
+        }
+        m_entries.clear();
+    }
+
+    void ProcessClassifier::reportStats(DWORD now) {
+        m_statsReporter.update(now, m_stats, [this](const Stats& stats, const Stats& reported, DWORD elapsed) {
+            double seconds = elapsed / 1000.0;
+            size_t lookups = stats.lookups - reported.lookups;
+            size_t hits = stats.hits - reported.hits;
+            size_t opens = stats.openProcess - reported.openProcess;
+
+            LOG_DEBUG(L"进程分类缓存: 查询 " + std::to_wstring(static_cast<int>(lookups / seconds)) +
+                      L"/秒, 命中 " + std::to_wstring(hits) + L"/" + std::to_wstring(lookups) +
+                      L", OpenProcess " + std::to_wstring(static_cast<int>(opens / seconds)) +
+                      L"/秒, 缓存项 " + std::to_wstring(m_entries.size()));
+            return true;
+        });
+    }
+
+} // namespace Platform
@@ -8,7 +8,6 @@
 #include <fstream>
 #include <sstream>
 #include <locale>
-#include <codecvt>
 #include <algorithm>
 
 // 移除硬编码的语言列表，改为动态扫描
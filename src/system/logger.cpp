@@ -1,6 +1,7 @@
 #include "core/stdafx.h"
 #include "system/logger.h"
 #include "core/application.h"
+#include "foundation/utf_transcoder.h"
 
 // 获取单例实例
 Logger& Logger::getInstance() {
@@ -225,13 +226,8 @@ std::wstring Logger::getCurrentTimeString() const {
 
 // 将宽字符串转换为UTF-8
 std::string Logger::wstringToUtf8(const std::wstring& wstr) const {
-    if (wstr.empty()) {
-        return std::string();
-    }
-    
-    int size_needed = WideCharToMultiByte(CP_UTF8, 0, &wstr[0], (int)wstr.size(), NULL, 0, NULL, NULL);
-    std::string strTo(size_needed, 0);
-    WideCharToMultiByte(CP_UTF8, 0, &wstr[0], (int)wstr.size(), &strTo[0], size_needed, NULL, NULL);
+    std::string strTo;
+    Foundation::Utf::appendUtf8(strTo, wstr.data(), wstr.size());
     return strTo;
 }
 
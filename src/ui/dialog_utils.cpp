@@ -41,7 +41,7 @@ void modernizeDialog(HWND dlg, int dpi)
         
         // 获取控件类名
         // 使用缓存的API减少系统调用
-        std::wstring className = Window::Cached::getWindowClassName(child);
+        Window::WindowClassName className = Window::Cached::getWindowClassName(child);
         if (className.empty()) {
             return TRUE; // 继续枚举
         }
@@ -6,13 +6,22 @@
 #include "pin/pin_layer_window.h"
 #include "pin/auto_pin_manager.h"
 #include "pin/window_binding_manager.h"
+#include "pin/z_order_manager.h"
+#include "pin/track_scheduler.h"
+#include "pin/frame_sync.h"
+#include "pin/pin_overlay.h"
+#include "pin/pin_registry.h"
 #include "window/window_monitor.h"
+#include "window/win_event_hook_manager.h"
+#include "window/win_event_thread.h"
+#include "window/text_fetcher.h"
 #include "options/options.h"
 #include "options/options_dialog.h"
 #include "options/pin_options.h"
 #include "options/auto_pin_options.h"
 #include "options/hotkey_options.h"
 #include "options/language_options.h"
+#include "graphics/monitor_topology.h"
 #include "ui/tray_icon.h"
 #include "system/language_manager.h"
 #include "system/logger.h"
@@ -252,6 +261,8 @@ LRESULT CALLBACK MainWnd::proc(HWND wnd, UINT msg, WPARAM wparam, LPARAM lparam)
         case WM_CREATE:
             return handleCreate(wnd, lparam, winCreMon, opt);
         case WM_DESTROY:
+            // 标题监视的钩子在卸载所有钩子之前释放
+            pendWnds.unwatchAll();
             return handleDestroy(wnd, winCreMon, opt);
         case App::WM_TRAYICON:
             evTrayIcon(wnd, wparam, lparam, opt);
@@ -265,14 +276,33 @@ LRESULT CALLBACK MainWnd::proc(HWND wnd, UINT msg, WPARAM wparam, LPARAM lparam)
         case WM_TIMER:
             if (wparam == App::TIMERID_AUTOPIN) {
                 pendWnds.check(wnd, *opt);
+            } else if (wparam == App::TIMERID_TRACK) {
+                Pin::TrackScheduler::getInstance().onTimer();
             }
             break;
         case App::WM_QUEUEWINDOW:
             pendWnds.add(reinterpret_cast<HWND>(wparam));
             break;
+        case App::WM_AUTOPINTITLE:
+            if (opt && opt->autoPinOn) {
+                pendWnds.titleChanged(reinterpret_cast<HWND>(wparam), wnd, *opt);
+            } else {
+                // 自动图钉已关闭，定时器不再运行，在这里释放剩余的钩子
+                pendWnds.unwatchAll();
+            }
+            break;
         case App::WM_PINSTATUS:
             handlePinStatus(lparam);
             break;
+        case App::WM_COMMITZORDER:
+            Pin::ZOrderManager::getInstance().commit();
+            break;
+        case App::WM_HOOKEVENTS:
+            Window::WinEventThread::getInstance().drain();
+            break;
+        case App::WM_PINFRAME:
+            Pin::FrameSync::getInstance().onFrame();
+            break;
         case WM_COMMAND:
             return handleCommand(wnd, wparam, *winCreMon, opt);
         case WM_ENDSESSION:
@@ -285,6 +315,17 @@ LRESULT CALLBACK MainWnd::proc(HWND wnd, UINT msg, WPARAM wparam, LPARAM lparam)
             return 0;
         case WM_DPICHANGED:
             return handleDpiChanged(wnd, wparam, lparam, opt);
+        case WM_DISPLAYCHANGE:
+            // 显示器配置改变：按新的显示器重建图钉覆盖层
+            Graphics::MonitorTopology::getInstance().invalidate();
+            Pin::PinOverlay::getInstance().resetSurfaces();
+            return 0;
+        case WM_SETTINGCHANGE:
+            // 任务栏等改变了工作区
+            if (wparam == SPI_SETWORKAREA) {
+                Graphics::MonitorTopology::getInstance().invalidate();
+            }
+            return DefWindowProc(wnd, msg, wparam, lparam);
         default:
             if (msg == taskbarMsg) {
                 app.trayIcon.create(app.smIcon, app.trayIconTip().c_str());
@@ -305,6 +346,25 @@ LRESULT MainWnd::handleCreate(HWND wnd, LPARAM lparam, std::unique_ptr<WindowCre
     opt = static_cast<Options*>(cs->lpCreateParams);
     app.mainWnd = wnd;
     
+    // 图钉的位置和层级调整统一由主窗口批量提交
+    Pin::ZOrderManager::getInstance().setNotifyWindow(wnd);
+    
+    // 所有图钉的跟踪由主窗口的一个定时器驱动
+    Pin::TrackScheduler::getInstance().setNotifyWindow(wnd);
+    
+    // 可选：每个显示器用一个覆盖层绘制所有图钉
+    Pin::PinOverlay::getInstance().setEnabled(opt->overlayPins);
+    
+    // 可选：按DWM合成帧定位图钉
+    if (opt->frameSync && !Pin::FrameSync::getInstance().start(wnd, App::WM_PINFRAME)) {
+        LOG_WARNING(L"DwmFlush不可用，帧同步定位已禁用");
+    }
+    
+    // 启动窗口事件线程，之后安装的钩子都由该线程接收
+    if (!Window::WinEventThread::getInstance().start(wnd, App::WM_HOOKEVENTS)) {
+        LOG_WARNING(L"无法启动窗口事件线程，窗口事件将在主线程处理");
+    }
+    
     // 初始化窗口创建监控器
     winCreMon = std::make_unique<EventHookWindowCreationMonitor>();
     if (opt->autoPinOn && !winCreMon->init(wnd, App::WM_QUEUEWINDOW)) {
@@ -346,13 +406,8 @@ LRESULT MainWnd::handleCreate(HWND wnd, LPARAM lparam, std::unique_ptr<WindowCre
     // 从配置文件加载绑定窗口状态
     Pin::WindowBindingManager::setBindingEnabled(opt->bindWindows);
     
-    // 初始化图钉计数 - 计算已存在的图钉窗口数量
-    int pinCount = 0;
-    HWND pin = nullptr;
-    while ((pin = FindWindowEx(nullptr, pin, PinWnd::className, nullptr)) != nullptr) {
-        pinCount++;
-    }
-    app.pinsUsed = pinCount;
+    // 初始化图钉计数 - 使用注册表中已存在的图钉数量
+    app.pinsUsed = static_cast<int>(Pin::PinRegistry::count());
     
     // 更新托盘图标提示
     app.trayIcon.setTip(app.trayIconTip().c_str());
@@ -362,6 +417,9 @@ LRESULT MainWnd::handleCreate(HWND wnd, LPARAM lparam, std::unique_ptr<WindowCre
 
 LRESULT MainWnd::handleDestroy(HWND wnd, std::unique_ptr<WindowCreationMonitor>& winCreMon, Options* opt) {
     app.mainWnd = nullptr;
+    Pin::ZOrderManager::getInstance().setNotifyWindow(nullptr);
+    Pin::TrackScheduler::getInstance().setNotifyWindow(nullptr);
+    Pin::FrameSync::getInstance().stop();
 
     // 首先清理托盘图标，确保它被正确移除
     app.trayIcon.destroy();
@@ -409,6 +467,14 @@ LRESULT MainWnd::handleDestroy(HWND wnd, std::unique_ptr<WindowCreationMonitor>&
     // 清理窗口绑定管理器
     Pin::WindowBindingManager::cleanup();
 
+    // 销毁图钉覆盖层
+    Pin::PinOverlay::getInstance().setEnabled(false);
+
+    // 卸载剩余的钩子后停止窗口事件线程
+    Window::WinEventHookManager::getInstance().shutdown();
+    Window::WinEventThread::getInstance().stop();
+    Window::TextFetcher::getInstance().shutdown();
+
     PostQuitMessage(0);
     return 0;
 }
@@ -515,10 +581,19 @@ void MainWnd::initializeDpiSettings(HWND wnd, Options* opt) {
 
 
 void MainWnd::handlePinStatus(LPARAM lparam) {
-    app.pinsUsed += lparam ? 1 : -1;
-    
-    // 更新绑定窗口列表
-    Pin::WindowBindingManager::updateBoundWindows();
+#ifdef _DEBUG
+    // 调试版本中每个通知都校验注册表与窗口枚举结果一致，
+    // 包括图钉数量未变的通知（如同时钉住一个、移除一个）
+    Pin::PinRegistry::verify();
+#endif
+    
+    // 以注册表为准：批量操作产生的多个通知中，只有第一个会带来变化，
+    // 托盘提示和关于对话框只更新一次
+    int pinsUsed = static_cast<int>(Pin::PinRegistry::count());
+    if (pinsUsed == app.pinsUsed) {
+        return;
+    }
+    app.pinsUsed = pinsUsed;
     
     if (app.aboutDlg) {
         SendMessage(app.aboutDlg, App::WM_PINSTATUS, 0, 0);
@@ -547,17 +622,12 @@ void MainWnd::updateTrayIcon() {
     int currentDpi = Graphics::DpiManager::getDpiForWindow(app.mainWnd);
     app.pinShape.initImageForDpi(currentDpi);
     app.pinShape.initShapeForDpi(currentDpi);
+    Pin::PinOverlay::getInstance().invalidateImage();
     
     // 更新所有现有的图钉窗口
-    EnumWindows([](HWND wnd, LPARAM) -> BOOL {
-        WCHAR className[Constants::MAX_CLASSNAME_LEN];
-    if (GetClassName(wnd, className, Constants::MAX_CLASSNAME_LEN) > 0) {
-            if (wcscmp(className, PinWnd::className) == 0) {
-                InvalidateRect(wnd, nullptr, TRUE);
-            }
-        }
-        return TRUE;
-    }, 0);
+    for (HWND pin : Pin::PinRegistry::pins()) {
+        InvalidateRect(pin, nullptr, TRUE);
+    }
 }
 
 LRESULT MainWnd::handleCommand(HWND wnd, WPARAM wparam, WindowCreationMonitor& winCreMon, Options* opt) {
@@ -586,6 +656,8 @@ LRESULT MainWnd::handleCommand(HWND wnd, WPARAM wparam, WindowCreationMonitor& w
 }
 
 LRESULT MainWnd::handleDpiChanged(HWND wnd, WPARAM wparam, LPARAM lparam, Options* opt) {
+    Graphics::MonitorTopology::getInstance().invalidate();
+    
     const int newDpi = HIWORD(wparam);
     RECT* newRect = reinterpret_cast<RECT*>(lparam);
     
@@ -599,20 +671,15 @@ LRESULT MainWnd::handleDpiChanged(HWND wnd, WPARAM wparam, LPARAM lparam, Option
     
     app.pinShape.initShapeForDpi(newDpi);
     app.pinShape.initImageForDpi(newDpi);
+    Pin::PinOverlay::getInstance().invalidateImage();
     
     // 重新创建托盘图标（使用默认图标）
     app.trayIcon.create(app.smIcon, app.trayIconTip().c_str());
     
     // 通知所有图钉窗口更新DPI设置
-    EnumWindows([](HWND hwnd, LPARAM lParam) -> BOOL {
-        // 直接获取窗口信息，无需使用WindowInfo结构体
-        std::wstring className = Window::getWindowClassName(hwnd);
-        std::wstring windowText = Window::getWindowText(hwnd);
-        if (wcscmp(className.c_str(), PinWnd::className) == 0) {
-            SendMessage(hwnd, WM_DPICHANGED, MAKEWPARAM(lParam, lParam), 0);
-        }
-        return TRUE;
-    }, static_cast<LPARAM>(newDpi));
+    for (HWND pin : Pin::PinRegistry::pins()) {
+        SendMessage(pin, WM_DPICHANGED, MAKEWPARAM(newDpi, newDpi), 0);
+    }
     
     return 0;
 }
@@ -730,12 +797,7 @@ void MainWnd::cmNewPin(HWND wnd) {
 }
 
 void MainWnd::cmRemovePins(HWND wnd) {
-    int count = 0;
-    HWND pin;
-    while ((pin = FindWindow(PinWnd::className, nullptr)) != nullptr) {
-        DestroyWindow(pin);
-        count++;
-    }
+    Pin::PinManager::unpinAll();
 }
 
 void MainWnd::cmBindWindows(HWND wnd) {
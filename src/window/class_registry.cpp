@@ -0,0 +1,138 @@
+#include "core/stdafx.h"
+#include "window/class_registry.h"
+#include "system/logger.h"
+
+namespace Window {
+
+    namespace {
+        // 类原子映射的有效期（毫秒），过期后整体清空，防止类注销后原子被重用
+        constexpr DWORD ATOM_CACHE_TTL = 5000;
+
+        // 与WellKnown的顺序一致
+        constexpr const wchar_t* WELL_KNOWN_NAMES[] = {
+            L"ProgMan",
+            L"Shell_TrayWnd",
+            L"TApplication",
+            L"ApplicationFrameWindow",
+            L"Windows.UI.Core.CoreWindow",
+            L"XAML_WindowedPopupClass",
+            L"DirectUIHWND",
+        };
+        static_assert(sizeof(WELL_KNOWN_NAMES) / sizeof(WELL_KNOWN_NAMES[0]) + 1 == ClassRegistry::WELL_KNOWN_COUNT,
+                      "WELL_KNOWN_NAMES与WellKnown不一致");
+
+        uint8_t traitsOf(std::wstring_view folded) {
+            uint8_t traits = 0;
+            if (folded == L"applicationframewindow" ||
+                folded == L"windows.ui.core.corewindow" ||
+                folded == L"xaml_windowedpopupclass") {
+                traits |= ClassRegistry::TRAIT_MODERN_APP;
+            }
+            if (folded == L"windows.ui.core.corewindow" ||
+                folded == L"directuihwnd" ||
+                folded.find(L"chrome") != std::wstring_view::npos ||
+                folded.find(L"content") != std::wstring_view::npos) {
+                traits |= ClassRegistry::TRAIT_PROXY_CONTENT;
+            }
+            return traits;
+        }
+    }
+
+    ClassRegistry& ClassRegistry::getInstance() {
+        static ClassRegistry instance;
+        return instance;
+    }
+
+    ClassRegistry::ClassRegistry() {
+        // ID 0保留给未知的类
+        m_traits.push_back(0);
+
+        for (const wchar_t* name : WELL_KNOWN_NAMES) {
+            internLocked(name);
+        }
+    }
+
+    ClassId ClassRegistry::findLocked(std::wstring_view name) const {
+        return m_classes.find(name);
+    }
+
+    ClassId ClassRegistry::internLocked(std::wstring_view name) {
+        bool added = false;
+        ClassId id = m_classes.intern(name, &added);
+        if (added) {
+            m_traits.push_back(traitsOf(m_classes.folded(id)));
+        }
+        return id;
+    }
+
+    ClassId ClassRegistry::intern(std::wstring_view name) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return internLocked(name);
+    }
+
+    ClassId ClassRegistry::find(std::wstring_view name) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return findLocked(name);
+    }
+
+    ClassId ClassRegistry::classOf(HWND wnd) {
+        if (!wnd) return CLASS_UNKNOWN;
+
+        // 读取类原子不会向目标窗口发送消息
+        ATOM atom = static_cast<ATOM>(GetClassLongPtr(wnd, GCW_ATOM));
+        DWORD now = GetTickCount();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.lookups;
+            if (now - m_atomsClearedTick >= ATOM_CACHE_TTL) {
+                m_atoms.clear();
+                m_atomsClearedTick = now;
+            }
+            if (atom) {
+                auto it = m_atoms.find(atom);
+                if (it != m_atoms.end()) {
+                    ++m_stats.atomHits;
+                    return it->second;
+                }
+            }
+        }
+
+        WindowClassName className;
+        className.setLength(GetClassName(wnd, className.buffer(), static_cast<int>(className.capacity())));
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.nameFetches;
+        ClassId id = internLocked(className.view());
+        if (atom && id != CLASS_UNKNOWN) {
+            m_atoms[atom] = id;
+        }
+
+        // 统计信息只在实际获取类名时输出，原子命中的路径保持最短
+        m_statsReporter.update(now, m_stats, [this](const Stats& stats, const Stats& reported, DWORD) {
+            LOG_DEBUG(L"窗口类: 查询 " + std::to_wstring(stats.lookups - reported.lookups) +
+                      L" 次, 原子命中 " + std::to_wstring(stats.atomHits - reported.atomHits) +
+                      L" 次, 获取类名 " + std::to_wstring(stats.nameFetches - reported.nameFetches) +
+                      L" 次, 已驻留 " + std::to_wstring(m_classes.size()) + L" 个类");
+            return true;
+        });
+        return id;
+    }
+
+    WindowClassName ClassRegistry::name(ClassId id) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return WindowClassName(m_classes.name(id));
+    }
+
+    bool ClassRegistry::hasTrait(ClassId id, Trait trait) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return id < m_traits.size() && (m_traits[id] & trait) != 0;
+    }
+
+    ClassRegistry::Stats ClassRegistry::getStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Stats stats = m_stats;
+        stats.classes = m_classes.size();
+        return stats;
+    }
+
+} // namespace Window
@@ -0,0 +1,218 @@
+#include "core/stdafx.h"
+#include "window/ownership_graph.h"
+#include "window/window_helper.h"
+#include "window/window_cache.h"
+#include "window/win_event_hook_manager.h"
+
+namespace Window {
+
+    namespace {
+        // 即使没有收到事件，缓存超过此时间（毫秒）也重新枚举，防止遗漏事件后长期使用旧数据
+        constexpr DWORD VALIDATION_INTERVAL = 1000;
+
+        struct EnumResult {
+            std::vector<HWND>* windows;
+            std::vector<HWND>* owners;
+        };
+
+        // 影响所有关系、层级或代理窗口可用性的事件
+        struct EventRange {
+            DWORD eventMin;
+            DWORD eventMax;
+        };
+        constexpr EventRange GRAPH_EVENTS[] = {
+            { EVENT_OBJECT_CREATE, EVENT_OBJECT_SHOW },
+            { EVENT_OBJECT_REORDER, EVENT_OBJECT_REORDER },
+            { EVENT_OBJECT_PARENTCHANGE, EVENT_OBJECT_PARENTCHANGE },
+            { EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND },
+        };
+    }
+
+    OwnershipGraph& OwnershipGraph::getInstance() {
+        static OwnershipGraph instance;
+        return instance;
+    }
+
+    DWORD OwnershipGraph::track(HWND wnd) {
+        DWORD processId = 0;
+        DWORD threadId = GetWindowThreadProcessId(wnd, &processId);
+        if (!threadId) return 0;
+
+        ThreadNode& node = m_threads[threadId];
+        if (node.refCount++ == 0) {
+            node.processId = processId;
+            node.valid = false;
+            WinEventHookManager& hooks = WinEventHookManager::getInstance();
+            for (const EventRange& range : GRAPH_EVENTS) {
+                hooks.acquire(range.eventMin, range.eventMax, eventProc, processId);
+            }
+        }
+        return threadId;
+    }
+
+    void OwnershipGraph::untrack(DWORD threadId) {
+        auto it = m_threads.find(threadId);
+        if (it == m_threads.end()) return;
+
+        ThreadNode& node = it->second;
+        if (--node.refCount > 0) return;
+
+        WinEventHookManager& hooks = WinEventHookManager::getInstance();
+        for (const EventRange& range : GRAPH_EVENTS) {
+            hooks.release(range.eventMin, range.eventMax, eventProc, node.processId);
+        }
+        m_index.removeThread(threadId);
+        m_threads.erase(it);
+    }
+
+    void OwnershipGraph::invalidateThread(DWORD threadId) {
+        auto it = m_threads.find(threadId);
+        if (it != m_threads.end() && it->second.valid) {
+            it->second.valid = false;
+            ++m_stats.invalidations;
+        }
+    }
+
+    void CALLBACK OwnershipGraph::eventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd,
+                                            LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime) {
+        if (idObject != OBJID_WINDOW || idChild != CHILDID_SELF) {
+            return;
+        }
+
+        OwnershipGraph& graph = getInstance();
+        auto it = graph.m_threads.find(eventThread);
+        if (it == graph.m_threads.end()) {
+            return;
+        }
+        ++it->second.generation;
+
+        switch (event) {
+        case EVENT_OBJECT_SHOW:
+            // 显示窗口不改变所有关系和层级，只用于通知调用者
+            break;
+        case EVENT_OBJECT_CREATE:
+        case EVENT_OBJECT_DESTROY:
+        case EVENT_OBJECT_PARENTCHANGE:
+            // 缓存已失效时下一次查询会重新枚举，无需更新
+            if (it->second.valid) {
+                graph.applyEvent(event, hwnd, eventThread);
+            }
+            break;
+        default:
+            // 重排和前台切换改变了z-order，需要重新枚举
+            graph.invalidateThread(eventThread);
+            break;
+        }
+    }
+
+    void OwnershipGraph::applyEvent(DWORD event, HWND hwnd, DWORD threadId) {
+        ++m_stats.updates;
+        if (event == EVENT_OBJECT_DESTROY) {
+            m_index.erase(hwnd);
+            return;
+        }
+
+        // 与EnumThreadWindows一致，只保存顶级窗口；变为子窗口的从缓存中移除
+        if (!IsWindow(hwnd) || GetAncestor(hwnd, GA_PARENT) != GetDesktopWindow()) {
+            m_index.erase(hwnd);
+            return;
+        }
+        // 新建的窗口位于z-order顶部；已缓存的窗口只更新所有者
+        m_index.insert(threadId, hwnd, GetWindow(hwnd, GW_OWNER));
+    }
+
+    size_t OwnershipGraph::generation(DWORD threadId) const {
+        auto it = m_threads.find(threadId);
+        return it != m_threads.end() ? it->second.generation : 0;
+    }
+
+    BOOL CALLBACK OwnershipGraph::enumProc(HWND wnd, LPARAM param) {
+        EnumResult& result = *reinterpret_cast<EnumResult*>(param);
+        result.windows->push_back(wnd);
+        result.owners->push_back(GetWindow(wnd, GW_OWNER));
+        return TRUE;
+    }
+
+    void OwnershipGraph::enumerate(DWORD threadId, std::vector<HWND>& windows, std::vector<HWND>& owners) {
+        windows.clear();
+        owners.clear();
+        EnumResult result = { &windows, &owners };
+        // EnumThreadWindows按z-order从上到下返回窗口
+        EnumThreadWindows(threadId, enumProc, reinterpret_cast<LPARAM>(&result));
+        ++m_stats.enumerations;
+    }
+
+    OwnershipGraph::ThreadNode* OwnershipGraph::validNode(DWORD threadId) {
+        auto it = m_threads.find(threadId);
+        if (it == m_threads.end()) return nullptr;
+
+        ThreadNode& node = it->second;
+        DWORD now = GetTickCount();
+        if (node.valid && now - node.refreshedTick < VALIDATION_INTERVAL) {
+            return &node;
+        }
+
+        std::vector<HWND> windows, owners;
+        enumerate(threadId, windows, owners);
+        m_index.assign(threadId, windows, owners);
+        node.valid = true;
+        node.refreshedTick = now;
+        return &node;
+    }
+
+    std::vector<HWND> OwnershipGraph::ownedWindows(HWND owner) {
+        ++m_stats.queries;
+        DWORD threadId = GetWindowThreadProcessId(owner, nullptr);
+
+        if (validNode(threadId)) {
+            return m_index.ownedWindows(threadId, owner);
+        }
+
+        // 未跟踪的线程直接枚举
+        std::vector<HWND> windows, owners, result;
+        enumerate(threadId, windows, owners);
+        for (size_t n = 0; n < windows.size(); ++n) {
+            if (windows[n] == owner || owners[n] == owner) {
+                result.push_back(windows[n]);
+            }
+        }
+        return result;
+    }
+
+    HWND OwnershipGraph::findProxy(HWND owner) {
+        for (HWND wnd : ownedWindows(owner)) {
+            if (wnd == owner) continue;
+            // 可见性和矩形每次实时检查，缓存只保存所有关系和顺序
+            if (Cached::isWindowVisible(wnd) &&
+                !Cached::isWindowIconic(wnd) &&
+                !isWndRectEmpty(wnd)) {
+                return wnd;
+            }
+        }
+        return nullptr;
+    }
+
+    HWND OwnershipGraph::ownerOf(HWND wnd) {
+        DWORD threadId = 0;
+        if (m_index.threadOf(wnd, threadId)) {
+            // 到期时重新校验；重新枚举后窗口可能已不存在
+            HWND owner = nullptr;
+            if (validNode(threadId) && m_index.ownerOf(wnd, owner)) {
+                return owner;
+            }
+        }
+        return GetWindow(wnd, GW_OWNER);
+    }
+
+    HWND OwnershipGraph::topParent(HWND wnd) {
+        ++m_stats.queries;
+        // 子窗口使用GetParent()，其余使用所有者
+        for (;;) {
+            HWND parent = isChild(wnd) ? GetParent(wnd) : ownerOf(wnd);
+            if (!parent || parent == wnd) break;
+            wnd = parent;
+        }
+        return wnd;
+    }
+
+} // namespace Window
@@ -0,0 +1,207 @@
+#include "core/stdafx.h"
+#include "window/text_fetcher.h"
+#include "system/logger.h"
+
+namespace Window {
+
+    namespace {
+        // 文本缓存有效期（毫秒），与窗口缓存的中等变化属性一致
+        constexpr DWORD TEXT_TTL = 100;
+        // WM_GETTEXT的超时时间（毫秒）
+        constexpr UINT SEND_TIMEOUT = 200;
+        // 无响应的窗口多久后再尝试发送消息（毫秒）
+        constexpr DWORD HUNG_RETRY_INTERVAL = 5000;
+        // 缓存项超过此数量时清理已销毁的窗口
+        constexpr size_t PRUNE_THRESHOLD = 256;
+
+        LONGLONG queryCounter() {
+            LARGE_INTEGER li;
+            QueryPerformanceCounter(&li);
+            return li.QuadPart;
+        }
+
+        ULONGLONG elapsedMicros(LONGLONG start) {
+            static const LONGLONG frequency = [] {
+                LARGE_INTEGER f;
+                QueryPerformanceFrequency(&f);
+                return f.QuadPart;
+            }();
+            return frequency > 0 ? ULONGLONG((queryCounter() - start) * 1000000 / frequency) : 0;
+        }
+
+        // 不发送消息，直接读取系统保存的窗口标题
+        void internalText(HWND wnd, WindowText& text) {
+            text.setLength(InternalGetWindowText(wnd, text.buffer(), static_cast<int>(text.capacity())));
+        }
+    }
+
+    TextFetcher& TextFetcher::getInstance() {
+        static TextFetcher instance;
+        return instance;
+    }
+
+    TextFetcher::~TextFetcher() {
+        shutdown();
+    }
+
+    WindowText TextFetcher::getText(HWND wnd) {
+        WindowText text;
+        if (!wnd) return text;
+
+        LONGLONG start = queryCounter();
+
+        // 本进程的窗口不会因其他程序无响应而阻塞，直接获取完整文本
+        DWORD processId = 0;
+        GetWindowThreadProcessId(wnd, &processId);
+        if (processId == GetCurrentProcessId()) {
+            text.setLength(GetWindowText(wnd, text.buffer(), static_cast<int>(text.capacity())));
+            return text;
+        }
+
+        DWORD now = GetTickCount();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.requests;
+
+        auto it = m_entries.find(wnd);
+        if (it == m_entries.end()) {
+            if (m_entries.size() >= PRUNE_THRESHOLD) {
+                pruneLocked();
+            }
+            it = m_entries.emplace(wnd, Entry()).first;
+            internalText(wnd, it->second.text);
+            it->second.fetchedTick = now;
+        } else if (now - it->second.fetchedTick >= TEXT_TTL) {
+            Entry& entry = it->second;
+
+            // 过期时仍返回缓存的文本，只请求后台刷新；缓存只由后台线程的WM_GETTEXT结果更新，
+            // 否则两种来源的文本（例如编辑框的内容与系统保存的标题）会交替出现。
+            // 无响应的窗口在重试间隔内收不到消息，只能读取系统保存的标题
+            if (entry.hung && static_cast<int>(now - entry.retryTick) < 0) {
+                ++m_stats.hungSkips;
+                internalText(wnd, entry.text);
+                entry.fetchedTick = now;
+            } else if (!entry.pending && !m_stop) {
+                entry.pending = true;
+                m_queue.push_back(wnd);
+                if (!m_worker.joinable()) {
+                    m_worker = std::thread(&TextFetcher::workerProc, this);
+                }
+                m_wake.notify_one();
+            }
+        }
+
+        text = it->second.text;
+        m_stats.callerMicros += elapsedMicros(start);
+        reportStats(now);
+        return text;
+    }
+
+    void TextFetcher::shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+            m_queue.clear();
+        }
+        m_wake.notify_all();
+        if (m_worker.joinable()) {
+            m_worker.join();
+        }
+    }
+
+    bool TextFetcher::fetchWithTimeout(HWND wnd, WindowText& text) {
+        DWORD_PTR copied = 0;
+        if (!SendMessageTimeout(wnd, WM_GETTEXT, text.capacity(), reinterpret_cast<LPARAM>(text.buffer()),
+                                SMTO_ABORTIFHUNG | SMTO_BLOCK, SEND_TIMEOUT, &copied)) {
+            text.clear();
+            return false;
+        }
+        text.setLength(static_cast<size_t>(copied));
+        return true;
+    }
+
+    void TextFetcher::workerProc() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            m_wake.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+            if (m_stop) {
+                break;
+            }
+
+            HWND wnd = m_queue.front();
+            m_queue.pop_front();
+
+            // 发送消息期间不持有锁，调用线程仍可取得最后已知的文本
+            lock.unlock();
+            WindowText text;
+            LONGLONG start = queryCounter();
+            bool alive = !!IsWindow(wnd);
+            bool ok = alive && fetchWithTimeout(wnd, text);
+            ULONGLONG blocked = elapsedMicros(start);
+            lock.lock();
+
+            ++m_stats.refreshes;
+            m_stats.blockedMicros += blocked;
+            if (blocked > m_stats.maxBlockedMicros) {
+                m_stats.maxBlockedMicros = blocked;
+            }
+
+            auto it = m_entries.find(wnd);
+            if (it == m_entries.end()) {
+                continue;
+            }
+            if (!alive) {
+                m_entries.erase(it);
+                continue;
+            }
+
+            Entry& entry = it->second;
+            entry.pending = false;
+            DWORD now = GetTickCount();
+            if (ok) {
+                entry.text = text;
+                entry.fetchedTick = now;
+                entry.hung = false;
+            } else {
+                // 超时后改用系统保存的标题，不保留可能已经很旧的文本
+                internalText(wnd, entry.text);
+                entry.fetchedTick = now;
+                entry.hung = true;
+                entry.retryTick = now + HUNG_RETRY_INTERVAL;
+                ++m_stats.timeouts;
+            }
+        }
+    }
+
+    void TextFetcher::pruneLocked() {
+        for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+            if (!it->second.pending && !IsWindow(it->first)) {
+                it = m_entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    TextFetcher::Stats TextFetcher::getStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    void TextFetcher::reportStats(DWORD now) {
+        m_statsReporter.update(now, m_stats, [](const Stats& stats, const Stats& reported, DWORD) {
+            size_t requests = stats.requests - reported.requests;
+            size_t refreshes = stats.refreshes - reported.refreshes;
+            if (refreshes || requests) {
+                LOG_DEBUG(L"窗口文本: 查询 " + std::to_wstring(requests) +
+                          L" 次, 后台刷新 " + std::to_wstring(refreshes) +
+                          L" 次, 超时 " + std::to_wstring(stats.timeouts - reported.timeouts) +
+                          L" 次, 跳过无响应窗口 " + std::to_wstring(stats.hungSkips - reported.hungSkips) +
+                          L" 次, 后台阻塞 " + std::to_wstring((stats.blockedMicros - reported.blockedMicros) / 1000) +
+                          L"ms（最长 " + std::to_wstring(stats.maxBlockedMicros / 1000) +
+                          L"ms）, 调用线程耗时 " + std::to_wstring((stats.callerMicros - reported.callerMicros) / 1000) + L"ms");
+            }
+            return true;
+        });
+    }
+
+} // namespace Window
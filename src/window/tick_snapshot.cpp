@@ -0,0 +1,185 @@
+#include "core/stdafx.h"
+#include "window/tick_snapshot.h"
+#include "system/logger.h"
+
+namespace Window {
+
+    TickSnapshot& TickSnapshot::getInstance() {
+        static TickSnapshot instance;
+        return instance;
+    }
+
+    void TickSnapshot::begin() {
+        if (m_depth++ > 0) return;
+        m_tickCalls = 0;
+    }
+
+    void TickSnapshot::end() {
+        if (--m_depth > 0) return;
+
+        ++m_stats.ticks;
+        m_stats.calls += m_tickCalls;
+        if (m_tickCalls > m_stats.maxCalls) {
+            m_stats.maxCalls = m_tickCalls;
+        }
+        if (m_wnds.size() > m_stats.maxWindows) {
+            m_stats.maxWindows = m_wnds.size();
+        }
+
+        // 保留容量，下一个周期重新填充
+        m_wnds.clear();
+        m_loaded.clear();
+        m_flags.clear();
+        m_rects.clear();
+        m_styles.clear();
+        m_exStyles.clear();
+        m_owners.clear();
+        m_index.clear();
+
+        reportStats();
+    }
+
+    uint32_t TickSnapshot::row(HWND wnd) {
+        auto it = m_index.find(wnd);
+        if (it != m_index.end()) {
+            return it->second;
+        }
+
+        uint32_t index = static_cast<uint32_t>(m_wnds.size());
+        m_wnds.push_back(wnd);
+        m_loaded.push_back(0);
+        m_flags.push_back(0);
+        m_rects.push_back(RECT{});
+        m_styles.push_back(0);
+        m_exStyles.push_back(0);
+        m_owners.push_back(nullptr);
+        m_index.emplace(wnd, index);
+        return index;
+    }
+
+    void TickSnapshot::invalidate(HWND wnd) {
+        auto it = m_index.find(wnd);
+        if (it != m_index.end()) {
+            m_loaded[it->second] = 0;
+        }
+    }
+
+    bool TickSnapshot::flag(HWND wnd, uint8_t loaded, uint8_t bit, BOOL (WINAPI* query)(HWND)) {
+        if (!isActive()) {
+            return query(wnd) != FALSE;
+        }
+
+        ++m_stats.reads;
+        uint32_t index = row(wnd);
+        if (!(m_loaded[index] & loaded)) {
+            ++m_tickCalls;
+            if (query(wnd)) {
+                m_flags[index] |= bit;
+            } else {
+                m_flags[index] &= ~bit;
+            }
+            m_loaded[index] |= loaded;
+        }
+        return (m_flags[index] & bit) != 0;
+    }
+
+    bool TickSnapshot::isWindow(HWND wnd) {
+        return flag(wnd, LOADED_VALID, FLAG_VALID, IsWindow);
+    }
+
+    bool TickSnapshot::isVisible(HWND wnd) {
+        return flag(wnd, LOADED_VISIBLE, FLAG_VISIBLE, IsWindowVisible);
+    }
+
+    bool TickSnapshot::isIconic(HWND wnd) {
+        return flag(wnd, LOADED_ICONIC, FLAG_ICONIC, IsIconic);
+    }
+
+    bool TickSnapshot::isEnabled(HWND wnd) {
+        return flag(wnd, LOADED_ENABLED, FLAG_ENABLED, IsWindowEnabled);
+    }
+
+    bool TickSnapshot::getRect(HWND wnd, RECT& rect) {
+        if (!isActive()) {
+            return GetWindowRect(wnd, &rect) != FALSE;
+        }
+
+        ++m_stats.reads;
+        uint32_t index = row(wnd);
+        if (!(m_loaded[index] & LOADED_RECT)) {
+            ++m_tickCalls;
+            RECT rc = {};
+            if (GetWindowRect(wnd, &rc)) {
+                m_flags[index] |= FLAG_RECT;
+            } else {
+                m_flags[index] &= ~FLAG_RECT;
+            }
+            m_rects[index] = rc;
+            m_loaded[index] |= LOADED_RECT;
+        }
+        rect = m_rects[index];
+        return (m_flags[index] & FLAG_RECT) != 0;
+    }
+
+    LONG TickSnapshot::getStyle(HWND wnd) {
+        if (!isActive()) {
+            return GetWindowLong(wnd, GWL_STYLE);
+        }
+
+        ++m_stats.reads;
+        uint32_t index = row(wnd);
+        if (!(m_loaded[index] & LOADED_STYLE)) {
+            ++m_tickCalls;
+            m_styles[index] = GetWindowLong(wnd, GWL_STYLE);
+            m_loaded[index] |= LOADED_STYLE;
+        }
+        return m_styles[index];
+    }
+
+    LONG TickSnapshot::getExStyle(HWND wnd) {
+        if (!isActive()) {
+            return GetWindowLong(wnd, GWL_EXSTYLE);
+        }
+
+        ++m_stats.reads;
+        uint32_t index = row(wnd);
+        if (!(m_loaded[index] & LOADED_EXSTYLE)) {
+            ++m_tickCalls;
+            m_exStyles[index] = GetWindowLong(wnd, GWL_EXSTYLE);
+            m_loaded[index] |= LOADED_EXSTYLE;
+        }
+        return m_exStyles[index];
+    }
+
+    HWND TickSnapshot::getOwner(HWND wnd) {
+        if (!isActive()) {
+            return GetWindow(wnd, GW_OWNER);
+        }
+
+        ++m_stats.reads;
+        uint32_t index = row(wnd);
+        if (!(m_loaded[index] & LOADED_OWNER)) {
+            ++m_tickCalls;
+            m_owners[index] = GetWindow(wnd, GW_OWNER);
+            m_loaded[index] |= LOADED_OWNER;
+        }
+        return m_owners[index];
+    }
+
+    void TickSnapshot::reportStats() {
+        m_statsReporter.update(GetTickCount(), m_stats, [](const Stats& stats, const Stats& reported, DWORD) {
+            size_t ticks = stats.ticks - reported.ticks;
+            size_t reads = stats.reads - reported.reads;
+            size_t calls = stats.calls - reported.calls;
+            if (ticks) {
+                LOG_DEBUG(L"窗口快照: 周期 " + std::to_wstring(ticks) +
+                          L" 个, 每周期读取 " + std::to_wstring(reads / ticks) +
+                          L" 次, Win32调用 " + std::to_wstring(calls / ticks) +
+                          L" 次 (最多 " + std::to_wstring(stats.maxCalls) +
+                          L" 次, " + std::to_wstring(stats.maxWindows) + L" 个窗口)");
+            }
+            return true;
+        });
+    }
+
+} // namespace Window
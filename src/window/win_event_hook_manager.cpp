@@ -0,0 +1,155 @@
+#include "core/stdafx.h"
+#include "window/win_event_hook_manager.h"
+#include "window/win_event_thread.h"
+#include "system/logger.h"
+
+namespace Window {
+
+    WinEventHookManager& WinEventHookManager::getInstance() {
+        static WinEventHookManager instance;
+        return instance;
+    }
+
+    WinEventHookManager::~WinEventHookManager() {
+        shutdown();
+    }
+
+    void WinEventHookManager::shutdown() {
+        // 钩子必须在安装它的线程上卸载
+        WinEventThread::getInstance().invoke([this]() {
+            for (auto& item : m_entries) {
+                if (item.second.hook) {
+                    UnhookWinEvent(item.second.hook);
+                }
+            }
+            m_handlers.clear();
+        });
+        m_entries.clear();
+        m_hookCount = 0;
+        m_globalHookCount = 0;
+    }
+
+    bool WinEventHookManager::acquire(DWORD eventMin, DWORD eventMax, WINEVENTPROC handler, DWORD processId) {
+        Key key(eventMin, eventMax, reinterpret_cast<uintptr_t>(handler), processId);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            ++it->second.refCount;
+            return it->second.hook != nullptr;
+        }
+
+        // 在事件线程上安装，回调将由事件线程的消息循环接收
+        HWINEVENTHOOK hook = nullptr;
+        WinEventThread::getInstance().invoke([&]() {
+            hook = SetWinEventHook(eventMin, eventMax, nullptr, dispatch,
+                                   processId, 0, WINEVENT_OUTOFCONTEXT);
+            if (hook) {
+                m_handlers[hook] = handler;
+            }
+        });
+        if (!hook) {
+            LOG_WARNING(L"无法设置窗口事件钩子，进程ID: " + std::to_wstring(processId));
+        }
+
+        // 即使安装失败也记录引用，保持acquire/release对称
+        m_entries[key] = Entry{ hook, handler, 1 };
+        countHook(hook, processId, 1);
+        return hook != nullptr;
+    }
+
+    void WinEventHookManager::release(DWORD eventMin, DWORD eventMax, WINEVENTPROC handler, DWORD processId) {
+        Key key(eventMin, eventMax, reinterpret_cast<uintptr_t>(handler), processId);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            return;
+        }
+        if (--it->second.refCount > 0) {
+            return;
+        }
+        unhook(it->second.hook);
+        countHook(it->second.hook, processId, -1);
+        m_entries.erase(it);
+    }
+
+    void WinEventHookManager::unhook(HWINEVENTHOOK hook) {
+        if (!hook) {
+            return;
+        }
+        WinEventThread::getInstance().invoke([this, hook]() {
+            m_handlers.erase(hook);
+            UnhookWinEvent(hook);
+        });
+    }
+
+    void WinEventHookManager::countHook(HWINEVENTHOOK hook, DWORD processId, int delta) {
+        if (!hook) {
+            return;
+        }
+        if (delta > 0) {
+            ++m_hookCount;
+            if (processId == 0) ++m_globalHookCount;
+        } else {
+            --m_hookCount;
+            if (processId == 0) --m_globalHookCount;
+        }
+    }
+
+    void WinEventHookManager::releaseAll(WINEVENTPROC handler) {
+        for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+            if (it->second.handler != handler) {
+                ++it;
+                continue;
+            }
+            unhook(it->second.hook);
+            countHook(it->second.hook, std::get<3>(it->first), -1);
+            it = m_entries.erase(it);
+        }
+    }
+
+    WinEventHookManager::Stats WinEventHookManager::getStats() const {
+        Stats stats = {};
+        for (const auto& item : m_entries) {
+            if (!item.second.hook) continue;
+            ++stats.hooks;
+            if (std::get<3>(item.first) == 0) {
+                ++stats.globalHooks;
+            }
+        }
+        stats.events = m_events.load();
+        return stats;
+    }
+
+    void CALLBACK WinEventHookManager::dispatch(HWINEVENTHOOK hook, DWORD event, HWND hwnd,
+                                                LONG idObject, LONG idChild, DWORD eventThread, DWORD eventTime) {
+        WinEventHookManager& self = getInstance();
+        ++self.m_events;
+
+        auto it = self.m_handlers.find(hook);
+        if (it == self.m_handlers.end()) {
+            return;
+        }
+
+        // 在事件线程上只记录事件，由UI线程批量处理；事件线程未运行时直接处理
+        WinEventThread& thread = WinEventThread::getInstance();
+        if (thread.isCurrentThread()) {
+            LARGE_INTEGER now;
+            QueryPerformanceCounter(&now);
+            thread.enqueue(WinEventRecord{ it->second, hook, event, hwnd, idObject, idChild,
+                                           eventThread, eventTime, now.QuadPart });
+        } else {
+            it->second(hook, event, hwnd, idObject, idChild, eventThread, eventTime);
+        }
+
+        self.reportStats(GetTickCount());
+    }
+
+    void WinEventHookManager::reportStats(DWORD now) {
+        // 本函数可能在事件线程上调用，不访问UI线程维护的钩子表，只读取原子计数
+        m_statsReporter.update(now, m_events.load(), [this](size_t events, size_t reported, DWORD elapsed) {
+            LOG_DEBUG(L"窗口事件钩子: 接收事件 " + std::to_wstring(static_cast<int>((events - reported) * 1000.0 / elapsed)) +
+                      L"/秒, 钩子 " + std::to_wstring(m_hookCount.load()) +
+                      L" 个（全局 " + std::to_wstring(m_globalHookCount.load()) + L" 个）");
+            return true;
+        });
+    }
+
+} // namespace Window
@@ -0,0 +1,240 @@
+#include "core/stdafx.h"
+#include "window/win_event_thread.h"
+#include "system/logger.h"
+
+namespace Window {
+
+    namespace {
+        // 事件线程的线程消息：在线程上执行任务
+        constexpr UINT WM_EVENTTHREAD_INVOKE = WM_APP + 1;
+        // 队列已满时重新提交剩余事件的间隔（毫秒）
+        constexpr UINT RETRY_INTERVAL = 10;
+
+        struct InvokeTask {
+            const std::function<void()>* task;
+            HANDLE done;
+        };
+
+        LONGLONG queryCounter() {
+            LARGE_INTEGER li;
+            QueryPerformanceCounter(&li);
+            return li.QuadPart;
+        }
+    }
+
+    WinEventThread& WinEventThread::getInstance() {
+        static WinEventThread instance;
+        return instance;
+    }
+
+    WinEventThread::~WinEventThread() {
+        stop();
+    }
+
+    bool WinEventThread::start(HWND notifyWnd, UINT notifyMsg) {
+        if (isRunning()) {
+            return true;
+        }
+
+        m_notifyWnd = notifyWnd;
+        m_notifyMsg = notifyMsg;
+
+        LARGE_INTEGER freq;
+        QueryPerformanceFrequency(&freq);
+        m_qpcFrequency = freq.QuadPart;
+
+        auto readyGuard = Util::RAII::makeHandleGuard(CreateEvent(nullptr, TRUE, FALSE, nullptr));
+        if (!readyGuard.isValid()) {
+            return false;
+        }
+        HANDLE ready = readyGuard.get();
+
+        m_thread = std::thread([this, ready]() {
+            // 确保线程消息队列存在后再通知启动完成
+            MSG msg;
+            PeekMessage(&msg, nullptr, WM_USER, WM_USER, PM_NOREMOVE);
+            m_threadId = GetCurrentThreadId();
+            SetEvent(ready);
+            threadProc();
+        });
+
+        WaitForSingleObject(ready, INFINITE);
+        return isRunning();
+    }
+
+    void WinEventThread::stop() {
+        if (!m_thread.joinable()) {
+            return;
+        }
+        PostThreadMessage(m_threadId, WM_QUIT, 0, 0);
+        m_thread.join();
+        m_threadId = 0;
+
+        // 丢弃尚未处理的事件
+        WinEventRecord record;
+        while (m_queue.pop(record)) {}
+        m_wakePending = false;
+    }
+
+    void WinEventThread::invoke(const std::function<void()>& task) {
+        if (!isRunning() || isCurrentThread()) {
+            task();
+            return;
+        }
+
+        auto doneGuard = Util::RAII::makeHandleGuard(CreateEvent(nullptr, TRUE, FALSE, nullptr));
+        if (!doneGuard.isValid()) {
+            return;
+        }
+        InvokeTask invokeTask = { &task, doneGuard.get() };
+        if (PostThreadMessage(m_threadId, WM_EVENTTHREAD_INVOKE, 0, reinterpret_cast<LPARAM>(&invokeTask))) {
+            WaitForSingleObject(doneGuard.get(), INFINITE);
+        }
+    }
+
+    void WinEventThread::threadProc() {
+        MSG msg;
+        while (GetMessage(&msg, nullptr, 0, 0) > 0) {
+            // 处理本轮所有消息；钩子回调在获取消息期间被调用
+            do {
+                if (msg.hwnd == nullptr && msg.message == WM_EVENTTHREAD_INVOKE) {
+                    InvokeTask* invokeTask = reinterpret_cast<InvokeTask*>(msg.lParam);
+                    (*invokeTask->task)();
+                    SetEvent(invokeTask->done);
+                } else {
+                    TranslateMessage(&msg);
+                    DispatchMessage(&msg);
+                }
+            } while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE) && msg.message != WM_QUIT);
+
+            flushBatch();
+
+            if (msg.message == WM_QUIT) {
+                break;
+            }
+        }
+    }
+
+    void WinEventThread::enqueue(const WinEventRecord& record) {
+        // 所有处理函数只关心窗口对象本身的事件，在这里提前过滤
+        if (!record.hwnd || record.idObject != OBJID_WINDOW || record.idChild != CHILDID_SELF) {
+            return;
+        }
+
+        // 同一轮中同一窗口的位置变化只保留最新的一条：旧记录作废，新记录追加在末尾，
+        // 保持与其他事件的先后顺序；但保留最早的接收时间，使延迟统计反映真实等待时间
+        if (record.event == EVENT_OBJECT_LOCATIONCHANGE) {
+            auto it = m_batchLocation.find(record.hwnd);
+            if (it != m_batchLocation.end() && m_batch[it->second].handler == record.handler) {
+                WinEventRecord& previous = m_batch[it->second];
+                LONGLONG received = previous.received;
+                previous.handler = nullptr;
+                m_batch.push_back(record);
+                m_batch.back().received = received;
+                it->second = m_batch.size() - 1;
+                ++m_coalesced;
+                return;
+            }
+            m_batchLocation[record.hwnd] = m_batch.size();
+        }
+        m_batch.push_back(record);
+    }
+
+    void WinEventThread::flushBatch() {
+        if (m_batch.empty()) {
+            return;
+        }
+
+        // 按顺序提交，跳过已合并作废的记录；队列已满时停在第一条未提交的记录
+        bool pushed = false;
+        size_t sent = 0;
+        for (; sent < m_batch.size(); ++sent) {
+            const WinEventRecord& record = m_batch[sent];
+            if (!record.handler) {
+                continue;
+            }
+            if (!m_queue.push(record)) {
+                break;
+            }
+            pushed = true;
+        }
+
+        if (sent == m_batch.size()) {
+            m_batch.clear();
+            m_batchLocation.clear();
+            if (m_retryTimer) {
+                KillTimer(nullptr, m_retryTimer);
+                m_retryTimer = 0;
+            }
+        } else {
+            // 剩余的事件（包括创建、销毁等不能合并的事件）留在本轮中，
+            // 之后的位置变化仍可与它们合并；由定时器保证即使没有新事件也会重新提交
+            m_batch.erase(m_batch.begin(), m_batch.begin() + sent);
+            m_batchLocation.clear();
+            for (size_t n = 0; n < m_batch.size(); ++n) {
+                if (m_batch[n].handler && m_batch[n].event == EVENT_OBJECT_LOCATIONCHANGE) {
+                    m_batchLocation[m_batch[n].hwnd] = n;
+                }
+            }
+            ++m_deferred;
+            if (!m_retryTimer) {
+                m_retryTimer = SetTimer(nullptr, 0, RETRY_INTERVAL, nullptr);
+            }
+        }
+
+        // UI线程尚未处理上一次唤醒时不再重复发送消息
+        if (pushed && !m_wakePending.exchange(true)) {
+            PostMessage(m_notifyWnd, m_notifyMsg, 0, 0);
+        }
+    }
+
+    void WinEventThread::drain() {
+        // 先清除唤醒标志再取事件，之后新入队的事件会触发新的唤醒
+        m_wakePending = false;
+
+        WinEventRecord record;
+        while (m_queue.pop(record)) {
+            record.handler(record.hook, record.event, record.hwnd, record.idObject,
+                           record.idChild, record.eventThread, record.eventTime);
+            recordLatency(record.received, queryCounter());
+        }
+
+        reportStats(GetTickCount());
+    }
+
+    void WinEventThread::recordLatency(LONGLONG received, LONGLONG now) {
+        if (m_qpcFrequency <= 0) {
+            return;
+        }
+        LONGLONG micros = (now - received) * 1000000 / m_qpcFrequency;
+        size_t bucket = 0;
+        while (micros > 1 && bucket < LATENCY_BUCKETS - 1) {
+            micros >>= 1;
+            ++bucket;
+        }
+        ++m_latency.buckets[bucket];
+        ++m_latency.processed;
+    }
+
+    void WinEventThread::reportStats(DWORD now) {
+        m_statsReporter.update(now, m_latency, [this](const LatencyStats& stats, const LatencyStats& reported, DWORD) {
+            if (stats.processed == reported.processed) {
+                return false;
+            }
+
+            // 输出非空的延迟分桶：≤2^n微秒的事件数量
+            std::wstring histogram;
+            for (size_t n = 0; n < LATENCY_BUCKETS; ++n) {
+                if (size_t count = stats.buckets[n] - reported.buckets[n]) {
+                    histogram += L" ≤" + std::to_wstring(1ULL << n) + L"us:" + std::to_wstring(count);
+                }
+            }
+            LOG_DEBUG(L"窗口事件线程: 处理 " + std::to_wstring(stats.processed - reported.processed) +
+                      L" 条, 合并 " + std::to_wstring(m_coalesced.load()) +
+                      L" 条, 队列满延后提交 " + std::to_wstring(m_deferred.load()) + L" 次" +
+                      L", 延迟分布" + histogram);
+            return true;
+        });
+    }
+
+} // namespace Window
@@ -1,6 +1,8 @@
 #include "core/stdafx.h"
 #include "window/window_cache.h"
 #include "window/window_helper.h"
+#include "window/text_fetcher.h"
+#include "window/tick_snapshot.h"
 #include "options/options.h"
 
 // 引用全局选项对象
@@ -73,15 +75,11 @@ void WindowCache::updateWindowInfo(HWND wnd, WindowCacheEntry& entry) {
         return;
     }
     
-    // 更新窗口文本
-    WCHAR windowText[Constants::MAX_WINDOWTEXT_LEN] = {0};
-    GetWindowText(wnd, windowText, Constants::MAX_WINDOWTEXT_LEN);
-    entry.windowText = windowText;
+    // 更新窗口文本（不会被无响应的程序阻塞）
+    entry.windowText = TextFetcher::getInstance().getText(wnd);
     
-    // 更新窗口类名
-    WCHAR className[Constants::MAX_CLASSNAME_LEN] = {0};
-    GetClassName(wnd, className, Constants::MAX_CLASSNAME_LEN);
-    entry.className = className;
+    // 更新窗口类名，直接写入缓存项
+    entry.className.setLength(GetClassName(wnd, entry.className.buffer(), static_cast<int>(entry.className.capacity())));
     
     // 更新窗口矩形
     GetWindowRect(wnd, &entry.windowRect);
@@ -137,8 +135,8 @@ void WindowCache::evictLeastRecentlyUsed() {
     m_lruIterators.erase(lruWindow);
 }
 
-std::wstring WindowCache::getWindowText(HWND wnd, bool forceRefresh) {
-    if (!wnd) return L"";
+WindowText WindowCache::getWindowText(HWND wnd, bool forceRefresh) {
+    if (!wnd) return WindowText();
     
     std::lock_guard<std::mutex> lock(m_mutex);
     
@@ -154,8 +152,8 @@ std::wstring WindowCache::getWindowText(HWND wnd, bool forceRefresh) {
     return entry.windowText;
 }
 
-std::wstring WindowCache::getWindowClassName(HWND wnd, bool forceRefresh) {
-    if (!wnd) return L"";
+WindowClassName WindowCache::getWindowClassName(HWND wnd, bool forceRefresh) {
+    if (!wnd) return WindowClassName();
     
     std::lock_guard<std::mutex> lock(m_mutex);
     
@@ -336,6 +334,9 @@ LONG WindowCache::getWindowLong(HWND wnd, int nIndex, bool forceRefresh) {
 }
 
 void WindowCache::invalidateWindow(HWND wnd) {
+    // 本周期的快照也需要重新读取
+    TickSnapshot::getInstance().invalidate(wnd);
+
     std::lock_guard<std::mutex> lock(m_mutex);
     
     auto it = m_cache.find(wnd);
@@ -402,35 +403,65 @@ void WindowCache::clearCache() {
 // 便利函数实现
 namespace Cached {
 
-std::wstring getWindowText(HWND wnd, bool forceRefresh) {
+// 跟踪周期内改为读取本周期的快照，强制刷新时先丢弃该窗口已读取的状态
+static TickSnapshot* activeSnapshot(HWND wnd, bool forceRefresh) {
+    TickSnapshot& snapshot = TickSnapshot::getInstance();
+    if (!snapshot.isActive()) {
+        return nullptr;
+    }
+    if (forceRefresh) {
+        snapshot.invalidate(wnd);
+    }
+    return &snapshot;
+}
+
+WindowText getWindowText(HWND wnd, bool forceRefresh) {
     return WindowCache::getInstance().getWindowText(wnd, forceRefresh);
 }
 
-std::wstring getWindowClassName(HWND wnd, bool forceRefresh) {
+WindowClassName getWindowClassName(HWND wnd, bool forceRefresh) {
     return WindowCache::getInstance().getWindowClassName(wnd, forceRefresh);
 }
 
 bool getWindowRect(HWND wnd, RECT& rect, bool forceRefresh) {
+    if (TickSnapshot* snapshot = activeSnapshot(wnd, forceRefresh)) {
+        return snapshot->getRect(wnd, rect);
+    }
     return WindowCache::getInstance().getWindowRect(wnd, rect, forceRefresh);
 }
 
 bool isWindowVisible(HWND wnd, bool forceRefresh) {
+    if (TickSnapshot* snapshot = activeSnapshot(wnd, forceRefresh)) {
+        return snapshot->isVisible(wnd);
+    }
     return WindowCache::getInstance().isWindowVisible(wnd, forceRefresh);
 }
 
 bool isWindowIconic(HWND wnd, bool forceRefresh) {
+    if (TickSnapshot* snapshot = activeSnapshot(wnd, forceRefresh)) {
+        return snapshot->isIconic(wnd);
+    }
     return WindowCache::getInstance().isWindowIconic(wnd, forceRefresh);
 }
 
 bool isWindowEnabled(HWND wnd, bool forceRefresh) {
+    if (TickSnapshot* snapshot = activeSnapshot(wnd, forceRefresh)) {
+        return snapshot->isEnabled(wnd);
+    }
     return WindowCache::getInstance().isWindowEnabled(wnd, forceRefresh);
 }
 
 bool isWindowTopMost(HWND wnd, bool forceRefresh) {
+    if (TickSnapshot* snapshot = activeSnapshot(wnd, forceRefresh)) {
+        return (snapshot->getExStyle(wnd) & WS_EX_TOPMOST) != 0;
+    }
     return WindowCache::getInstance().isWindowTopMost(wnd, forceRefresh);
 }
 
 bool isWindowChild(HWND wnd, bool forceRefresh) {
+    if (TickSnapshot* snapshot = activeSnapshot(wnd, forceRefresh)) {
+        return (snapshot->getStyle(wnd) & WS_CHILD) != 0;
+    }
     return WindowCache::getInstance().isWindowChild(wnd, forceRefresh);
 }
 
@@ -439,10 +470,18 @@ HWND getParentWindow(HWND wnd, bool forceRefresh) {
 }
 
 HWND getOwnerWindow(HWND wnd, bool forceRefresh) {
+    if (TickSnapshot* snapshot = activeSnapshot(wnd, forceRefresh)) {
+        return snapshot->getOwner(wnd);
+    }
     return WindowCache::getInstance().getOwnerWindow(wnd, forceRefresh);
 }
 
 LONG getWindowLong(HWND wnd, int nIndex, bool forceRefresh) {
+    if (nIndex == GWL_STYLE || nIndex == GWL_EXSTYLE) {
+        if (TickSnapshot* snapshot = activeSnapshot(wnd, forceRefresh)) {
+            return nIndex == GWL_STYLE ? snapshot->getStyle(wnd) : snapshot->getExStyle(wnd);
+        }
+    }
     return WindowCache::getInstance().getWindowLong(wnd, nIndex, forceRefresh);
 }
 
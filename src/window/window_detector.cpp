@@ -2,62 +2,44 @@
 #include "window/window_detector.h"
 #include "window/window_helper.h"
 #include "window/window_cache.h"  // 添加窗口缓存支持
+#include "window/class_registry.h"
 #include "foundation/string_utils.h"
-#include <appmodel.h>  // 用于GetPackageFullName
+#include "platform/process_classifier.h"
 
 bool Window::isProgManWnd(HWND wnd)
 { 
-    // 使用缓存的API减少系统调用
-    std::wstring className = Window::Cached::getWindowClassName(wnd);
-    std::wstring windowText = Window::Cached::getWindowText(wnd);
-    
-    return Foundation::StringUtils::strimatch(className.c_str(), L"ProgMan")
-        && Foundation::StringUtils::strimatch(windowText.c_str(), L"Program Manager");
+    // 先比较类ID，类不符时不必获取标题
+    if (ClassRegistry::getInstance().classOf(wnd) != ClassRegistry::CLASS_PROGMAN) {
+        return false;
+    }
+    Window::WindowText windowText = Window::Cached::getWindowText(wnd);
+    return Foundation::StringUtils::strimatch(windowText.c_str(), L"Program Manager");
 }
 
 bool Window::isTaskBar(HWND wnd)
 {
-    // 使用缓存的API减少系统调用
-    std::wstring className = Window::Cached::getWindowClassName(wnd);
-    return Foundation::StringUtils::strimatch(className.c_str(), L"Shell_TrayWnd");
+    return ClassRegistry::getInstance().classOf(wnd) == ClassRegistry::CLASS_SHELL_TRAY;
 }
 
 bool Window::isVCLAppWnd(HWND wnd)
 {
-    // 使用缓存的API减少系统调用
-    std::wstring className = Window::Cached::getWindowClassName(wnd);
-    return Foundation::StringUtils::strimatch(L"TApplication", className.c_str()) 
+    return ClassRegistry::getInstance().classOf(wnd) == ClassRegistry::CLASS_VCL_APPLICATION
         && Window::isWndRectEmpty(wnd);
 }
 
 // 检测现代Windows应用程序（UWP、Win32包装等）
 bool Window::isModernWindowsApp(HWND wnd)
 {
-    // 使用缓存的API减少系统调用
-    std::wstring className = Window::Cached::getWindowClassName(wnd);
-    
-    // 检查常见的现代Windows应用类名
-    if (Foundation::StringUtils::strimatch(L"ApplicationFrameWindow", className.c_str()) ||
-        Foundation::StringUtils::strimatch(L"Windows.UI.Core.CoreWindow", className.c_str()) ||
-        Foundation::StringUtils::strimatch(L"XAML_WindowedPopupClass", className.c_str())) {
+    // 检查常见的现代Windows应用类名（驻留时已计算为特性位）
+    ClassRegistry& classes = ClassRegistry::getInstance();
+    if (classes.hasTrait(classes.classOf(wnd), ClassRegistry::TRAIT_MODERN_APP)) {
         return true;
     }
     
     // 检查进程是否为UWP应用
-    DWORD processId;
-    GetWindowThreadProcessId(wnd, &processId);
-    
-    HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, processId);
-    if (hProcess) {
-        // 检查是否为UWP应用包
-        UINT32 length = 0;
-        LONG result = GetPackageFullName(hProcess, &length, nullptr);
-        CloseHandle(hProcess);
-        
-        // 如果GetPackageFullName返回ERROR_INSUFFICIENT_BUFFER，说明这是一个UWP应用
-        if (result == ERROR_INSUFFICIENT_BUFFER) {
-            return true;
-        }
+    // 分类结果按进程缓存，进程退出前不会再次调用OpenProcess
+    if (Platform::ProcessClassifier::getInstance().classifyWindow(wnd) & Platform::ProcessClassifier::PACKAGED) {
+        return true;
     }
     
     return false;
@@ -1,23 +1,23 @@
 #include "core/stdafx.h"
 #include "window/window_helper.h"
 #include "window/window_cache.h"  // 添加窗口缓存支持
+#include "window/text_fetcher.h"
+#include "window/ownership_graph.h"
 #include "core/application.h"
 #include "resource.h"  // 包含资源ID定义
 
-// 安全获取窗口文本（公共函数）
-std::wstring Window::getWindowText(HWND wnd) {
-    if (!wnd) return L"";
-    WCHAR windowText[Constants::MAX_WINDOWTEXT_LEN] = {0};
-    GetWindowText(wnd, windowText, Constants::MAX_WINDOWTEXT_LEN);
-    return std::wstring(windowText);
+// 安全获取窗口文本（公共函数），不会被无响应的程序阻塞
+Window::WindowText Window::getWindowText(HWND wnd) {
+    return TextFetcher::getInstance().getText(wnd);
 }
 
 // 安全获取窗口类名（公共函数）
-std::wstring Window::getWindowClassName(HWND wnd) {
-    if (!wnd) return L"";
-    WCHAR className[Constants::MAX_CLASSNAME_LEN] = {0};
-    GetClassName(wnd, className, Constants::MAX_CLASSNAME_LEN);
-    return std::wstring(className);
+Window::WindowClassName Window::getWindowClassName(HWND wnd) {
+    WindowClassName className;
+    if (wnd) {
+        className.setLength(GetClassName(wnd, className.buffer(), static_cast<int>(className.capacity())));
+    }
+    return className;
 }
 
 bool Window::isWndRectEmpty(HWND wnd)
@@ -62,20 +62,9 @@ HWND Window::getTopParent(HWND wnd /*, bool mustBeVisible*/)
 
     // 沿着窗口链向上查找最终的顶级窗口
     // 对于WS_CHILD窗口使用GetParent()
-    // 对于其余的使用GetWindow(GW_OWNER)
+    // 对于其余的使用所有者（被跟踪线程的所有者由所有关系图缓存）
     //
-    for (;;) {
-        HWND parent = isChild(wnd)
-            ? GetParent(wnd)
-            : GetWindow(wnd, GW_OWNER);
-
-        if (!parent || parent == wnd) break;
-        //if (mustBeVisible && !IsWindowVisible(parent) || IsWndRectEmpty(parent))
-        //  break;
-        wnd = parent;
-    }
-
-    return wnd;
+    return OwnershipGraph::getInstance().topParent(wnd);
 }
 
 bool Window::isTopMost(HWND wnd)
@@ -91,25 +80,9 @@ bool Window::getVisibleWindowRect(HWND wnd, RECT& rect)
     }
     
     // 首先尝试使用DWM API获取实际可视边框
-    // 这需要动态加载dwmapi.dll，因为不是所有系统都支持
-    typedef HRESULT (WINAPI *DwmGetWindowAttributeFunc)(HWND, DWORD, PVOID, DWORD);
-    
-    HMODULE dwmapi = LoadLibrary(L"dwmapi.dll");
-    if (dwmapi) {
-        DwmGetWindowAttributeFunc dwmGetWindowAttribute = 
-            (DwmGetWindowAttributeFunc)GetProcAddress(dwmapi, "DwmGetWindowAttribute");
-        
-        if (dwmGetWindowAttribute) {
-            // DWMWA_EXTENDED_FRAME_BOUNDS = 9
-            HRESULT hr = dwmGetWindowAttribute(wnd, 9, &rect, sizeof(RECT));
-            FreeLibrary(dwmapi);
-            
-            if (SUCCEEDED(hr)) {
-                return true;
-            }
-        } else {
-            FreeLibrary(dwmapi);
-        }
+    // dwmapi由app.dwm统一加载，同一帧内的重复查询直接使用缓存结果
+    if (app.dwm.getExtendedFrameBounds(wnd, rect)) {
+        return true;
     }
     
     // 回退到标准GetWindowRect
@@ -130,15 +103,9 @@ bool Window::psChanged(HWND page)
 // WndHelper实现
 Window::WndHelper::WndHelper(HWND hwnd) : m_hwnd(hwnd) {}
 
-std::wstring Window::WndHelper::getText() const {
-    if (!m_hwnd) return L"";
-    
-    int len = GetWindowTextLength(m_hwnd);
-    if (len <= 0) return L"";
-    
-    std::vector<wchar_t> buffer(len + 1);
-    GetWindowText(m_hwnd, &buffer[0], len + 1);
-    return std::wstring(&buffer[0]);
+Window::WindowText Window::WndHelper::getText() const {
+    // 其他进程的窗口可能无响应，统一通过文本获取服务
+    return TextFetcher::getInstance().getText(m_hwnd);
 }
 
 void Window::WndHelper::setText(const std::wstring& text) const {
@@ -147,7 +114,7 @@ void Window::WndHelper::setText(const std::wstring& text) const {
     }
 }
 
-std::wstring Window::WndHelper::getClassName() const {
+Window::WindowClassName Window::WndHelper::getClassName() const {
     // 使用缓存的API减少系统调用
     return Window::Cached::getWindowClassName(m_hwnd);
 }
@@ -1,38 +1,44 @@
 #include "core/stdafx.h"
 #include "window/window_monitor.h"
+#include "window/win_event_hook_manager.h"
 
-HWINEVENTHOOK EventHookWindowCreationMonitor::hook = nullptr;
+bool EventHookWindowCreationMonitor::installed = false;
 HWND EventHookWindowCreationMonitor::wnd = nullptr;
 int EventHookWindowCreationMonitor::msgId = 0;
 
 bool EventHookWindowCreationMonitor::init(HWND wnd, int msgId)
 {
-    if (!hook) {
-        hook = SetWinEventHook(EVENT_OBJECT_CREATE, EVENT_OBJECT_CREATE, 
-            nullptr, proc, 0, 0, WINEVENT_OUTOFCONTEXT);
-        if (hook) {
-            this->wnd = wnd;
-            this->msgId = msgId;
+    if (!installed) {
+        // 窗口创建事件需要覆盖所有进程，这是唯一的全局钩子，仅在启用自动图钉时安装
+        this->wnd = wnd;
+        this->msgId = msgId;
+        installed = Window::WinEventHookManager::getInstance().acquire(
+            EVENT_OBJECT_CREATE, EVENT_OBJECT_CREATE, proc);
+        if (!installed) {
+            Window::WinEventHookManager::getInstance().release(
+                EVENT_OBJECT_CREATE, EVENT_OBJECT_CREATE, proc);
         }
     }
-    return hook != nullptr;
+    return installed;
 }
 
 bool EventHookWindowCreationMonitor::term()
 {
-    if (hook && UnhookWinEvent(hook)) {
-        hook = nullptr;
+    if (installed) {
+        Window::WinEventHookManager::getInstance().release(
+            EVENT_OBJECT_CREATE, EVENT_OBJECT_CREATE, proc);
+        installed = false;
     }
-    return !hook;
+    return !installed;
 }
 
 VOID CALLBACK EventHookWindowCreationMonitor::proc(HWINEVENTHOOK hook, DWORD event,
     HWND hwnd, LONG idObject, LONG idChild, DWORD dwEventThread, DWORD dwmsEventTime)
 {
-    if (hook == EventHookWindowCreationMonitor::hook &&
+    if (installed &&
         event == EVENT_OBJECT_CREATE &&
         idObject == OBJID_WINDOW)
     {
         PostMessage(wnd, msgId, (WPARAM)hwnd, 0);
     }
-}
\ No newline at end of file
+}
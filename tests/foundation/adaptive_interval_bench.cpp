@@ -0,0 +1,113 @@
+#include "foundation/adaptive_interval.h"
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// 按合成的目标窗口活动记录回放一个图钉的跟踪：固定间隔与自适应间隔（只靠轮询、以及由窗口事件唤醒）
+// 每秒的唤醒次数，以及目标开始移动到图钉第一次跟踪之间的延迟。
+// 参数与默认设置相同：TrackRate 20ms，IdleTrackRate 250ms，静止1秒后开始放慢。
+// 每条记录10分钟，由若干段连续移动组成，移动期间每次跟踪都看到变化。
+
+namespace {
+
+    constexpr int FAST = 20;
+    constexpr int SLOW = 250;
+    constexpr uint32_t IDLE_DELAY = 1000;
+    constexpr uint32_t DURATION = 600000;
+
+    struct Burst {
+        uint32_t start;
+        uint32_t end;
+    };
+
+    // 间隔gapMin-gapMax毫秒出现一段lengthMin-lengthMax毫秒的移动
+    std::vector<Burst> makeTrace(uint32_t gapMin, uint32_t gapMax, uint32_t lengthMin, uint32_t lengthMax, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector<Burst> trace;
+        uint32_t t = 0;
+        for (;;) {
+            t += gapMin + rng() % (gapMax - gapMin + 1);
+            uint32_t length = lengthMin + rng() % (lengthMax - lengthMin + 1);
+            if (t + length >= DURATION) break;
+            trace.push_back({ t, t + length });
+            t += length;
+        }
+        return trace;
+    }
+
+    struct Result {
+        double wakeupsPerSecond;
+        double meanLatency;     // 毫秒
+        uint32_t maxLatency;
+    };
+
+    // adaptive为假时固定按FAST跟踪；events为真时移动开始的事件立即唤醒处于慢速的图钉
+    Result replay(const std::vector<Burst>& trace, bool adaptive, bool events) {
+        Foundation::AdaptiveInterval rate;
+        rate.reset(FAST, 0);
+
+        size_t wakeups = 0, next = 0, first = 0;
+        uint64_t latencySum = 0;
+        uint32_t maxLatency = 0;
+        uint32_t now = 0;
+        while (now < DURATION) {
+            uint32_t tick = now + rate.current();
+            bool woken = false;
+            // 下一段移动在这个周期内开始
+            if (events && next < trace.size() && trace[next].start < tick && rate.wake(trace[next].start)) {
+                tick = trace[next].start;
+                woken = true;
+            }
+
+            // 上次跟踪之后是否有移动：(now, tick]与某段移动重叠
+            while (first < trace.size() && trace[first].end <= now) {
+                ++first;
+            }
+            bool changed = woken || (first < trace.size() && trace[first].start <= tick);
+            // 记录每段移动被第一次跟踪到的延迟
+            while (next < trace.size() && trace[next].start <= tick) {
+                uint32_t latency = tick - trace[next].start;
+                latencySum += latency;
+                if (latency > maxLatency) maxLatency = latency;
+                ++next;
+            }
+
+            now = tick;
+            ++wakeups;
+            if (adaptive) {
+                rate.update(changed, now, SLOW, IDLE_DELAY);
+            }
+        }
+
+        return { wakeups * 1000.0 / DURATION, trace.empty() ? 0.0 : double(latencySum) / trace.size(), maxLatency };
+    }
+
+} // namespace
+
+int main() {
+    struct Scenario {
+        const char* name;
+        std::vector<Burst> trace;
+    };
+    const Scenario scenarios[] = {
+        { "stationary", {} },
+        { "reading", makeTrace(10000, 60000, 300, 2000, 1) },     // 偶尔拖动或调整大小
+        { "arranging", makeTrace(1000, 5000, 500, 3000, 2) },     // 频繁移动
+        { "continuous", makeTrace(50, 200, 2000, 10000, 3) },     // 几乎一直在移动
+    };
+
+    std::printf("%-11s %7s %22s %22s %22s\n", "trace", "moves",
+                "fixed wakeups/s (lat)", "polling wakeups/s (lat)", "events wakeups/s (lat)");
+    for (const Scenario& s : scenarios) {
+        Result fixed = replay(s.trace, false, false);
+        Result polling = replay(s.trace, true, false);
+        Result events = replay(s.trace, true, true);
+        std::printf("%-11s %7zu %10.1f (%4.1f/%3u) %10.1f (%4.1f/%3u) %10.1f (%4.1f/%3u)\n", s.name, s.trace.size(),
+                    fixed.wakeupsPerSecond, fixed.meanLatency, fixed.maxLatency,
+                    polling.wakeupsPerSecond, polling.meanLatency, polling.maxLatency,
+                    events.wakeupsPerSecond, events.meanLatency, events.maxLatency);
+    }
+    std::printf("(lat = mean/max ms from a move starting to the first tick that sees it)\n");
+    return 0;
+}
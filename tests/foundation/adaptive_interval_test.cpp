@@ -0,0 +1,65 @@
+#include "foundation/adaptive_interval.h"
+#include "test_common.h"
+#include <cstdint>
+
+using Foundation::AdaptiveInterval;
+
+namespace {
+
+    constexpr int FAST = 20;
+    constexpr int SLOW = 250;
+    constexpr uint32_t DELAY = 1000;
+
+    // 静止超过idleDelay后逐次加倍到慢速间隔，变化时立即回到快速间隔
+    void testRamp() {
+        AdaptiveInterval rate;
+        rate.reset(FAST, 0);
+        CHECK(rate.current() == FAST && rate.fast() == FAST);
+
+        CHECK(rate.update(false, 500, SLOW, DELAY) == FAST);
+        CHECK(rate.update(false, 999, SLOW, DELAY) == FAST);
+        CHECK(rate.update(false, 1000, SLOW, DELAY) == 40);
+        CHECK(rate.update(false, 1040, SLOW, DELAY) == 80);
+        CHECK(rate.update(false, 1120, SLOW, DELAY) == 160);
+        CHECK(rate.update(false, 1280, SLOW, DELAY) == SLOW);
+        CHECK(rate.update(false, 1530, SLOW, DELAY) == SLOW);
+
+        CHECK(rate.update(true, 1780, SLOW, DELAY) == FAST);
+        // 变化之后重新计算静止时间
+        CHECK(rate.update(false, 2700, SLOW, DELAY) == FAST);
+        CHECK(rate.update(false, 2780, SLOW, DELAY) == 40);
+    }
+
+    // 事件唤醒：已在快速间隔时不需要重新设置定时器，但同样推迟放慢
+    void testWake() {
+        AdaptiveInterval rate;
+        rate.reset(FAST, 0);
+        CHECK(!rate.wake(900));
+        CHECK(rate.update(false, 1500, SLOW, DELAY) == FAST);
+        CHECK(rate.update(false, 1900, SLOW, DELAY) == 40);
+
+        CHECK(rate.wake(1940));
+        CHECK(rate.current() == FAST);
+        CHECK(!rate.wake(1950));
+        CHECK(rate.update(false, 2900, SLOW, DELAY) == FAST);
+    }
+
+    // 慢速间隔不小于快速间隔；tick计数回绕时静止时间仍正确
+    void testLimits() {
+        AdaptiveInterval rate;
+        rate.reset(100, 0);
+        CHECK(rate.update(false, 5000, 50, DELAY) == 100);
+
+        rate.reset(FAST, 0xFFFFFF00u);
+        CHECK(rate.update(false, 0x100u, SLOW, DELAY) == FAST);
+        CHECK(rate.update(false, 0x300u, SLOW, DELAY) == 40);
+    }
+
+} // namespace
+
+int main() {
+    testRamp();
+    testWake();
+    testLimits();
+    return Test::report("adaptive_interval_test");
+}
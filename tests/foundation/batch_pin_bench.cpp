@@ -0,0 +1,174 @@
+#include "foundation/bound_window_set.h"
+#include "foundation/placement_batch.h"
+#include <chrono>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+// 一次钉住/取消1/10/100个窗口：逐个操作（PinManager::BatchScope之前）与批量操作比较。
+// 使用程序中的PlacementBatch和BoundWindowSet，按PinManager的流程组合：
+// - 钉住：每个图钉请求移动到目标旁并调整层级，目标加入绑定列表，之后处理一次图钉状态通知；
+// - 逐个操作每个图钉提交一次层级（一次DeferWindowPos事务）并刷新一次托盘提示，
+//   自动图钉还在每个图钉之后Sleep(DEFAULT_BLINK_DELAY)；
+// - 批量操作在作用域结束时提交一次，绑定列表只应用最终状态，状态通知只有第一个带来刷新；
+// - 取消：每个目标请求取消置顶，目标移出绑定列表。
+// 计数对应系统调用和界面刷新，计时只反映不含系统调用的维护开销。
+
+namespace {
+
+    struct Point {
+        long x;
+        long y;
+    };
+    using Batch = Foundation::PlacementBatch<int>;
+    using Set = Foundation::BoundWindowSet<int, Point>;
+    constexpr int TOP = -1;
+    constexpr int NOTOPMOST = -2;
+    constexpr int PIN_BASE = 100000;    // 图钉窗口的句柄，与目标窗口区分
+    constexpr int BLINK_DELAY = 50;     // Constants::DEFAULT_BLINK_DELAY
+
+    struct Result {
+        long commits = 0;       // DeferWindowPos事务
+        long items = 0;         // 事务中的窗口项
+        long rects = 0;         // 绑定窗口的位置查询
+        long refreshes = 0;     // 托盘提示/关于对话框刷新
+        long sleepMs = 0;       // 自动图钉阻塞消息循环的时间
+        double nanos = 0;
+    };
+
+    struct Model {
+        Batch batch;
+        Set bound;
+        Result result;
+        size_t pinsUsed = 0;
+        size_t registry = 0;
+        std::unordered_map<int, bool> deferred;     // WindowBindingManager的推迟更新
+        bool batching = false;
+
+        bool locate(int wnd, Point& point) {
+            ++result.rects;
+            point = { wnd * 10L, wnd * 20L };
+            return true;
+        }
+
+        void commit() {
+            std::vector<Batch::Request> plan = batch.buildPlan(batch.take());
+            if (plan.empty()) return;
+            ++result.commits;
+            result.items += static_cast<long>(plan.size());
+            for (const Batch::Request& req : plan) {
+                batch.markApplied(req);
+            }
+        }
+
+        void applyBinding(int target, bool add) {
+            if (add) {
+                bound.add(target, [this](int wnd, Point& point) { return locate(wnd, point); });
+            } else {
+                bound.remove(target);
+            }
+        }
+
+        void binding(int target, bool add) {
+            if (batching) {
+                deferred[target] = add;
+            } else {
+                applyBinding(target, add);
+            }
+        }
+
+        // MainWnd::handlePinStatus：数量未变时直接返回
+        void pinStatus() {
+            if (registry == pinsUsed) return;
+            pinsUsed = registry;
+            ++result.refreshes;
+        }
+
+        void pin(int target) {
+            bool merged;
+            batch.requestMove(PIN_BASE + target, target * 10, target * 20 - 16, merged);
+            batch.requestZOrder(PIN_BASE + target, TOP, merged);
+            binding(target, true);
+            ++registry;
+        }
+
+        void unpin(int target) {
+            bool merged;
+            batch.requestZOrder(target, NOTOPMOST, merged);
+            binding(target, false);
+            --registry;
+        }
+
+        // 逐个操作：每个窗口的状态通知在下一个窗口之前处理
+        template<typename F>
+        void eachWindow(int count, bool autoPin, F&& op) {
+            for (int target = 1; target <= count; ++target) {
+                op(target);
+                commit();
+                pinStatus();
+                if (autoPin) result.sleepMs += BLINK_DELAY;
+            }
+        }
+
+        // 批量操作：作用域结束时一次提交，再应用绑定的最终状态，之后处理全部状态通知
+        template<typename F>
+        void batched(int count, F&& op) {
+            batching = true;
+            for (int target = 1; target <= count; ++target) {
+                op(target);
+            }
+            batching = false;
+            commit();
+            std::unordered_map<int, bool> changes;
+            changes.swap(deferred);
+            for (const auto& change : changes) {
+                applyBinding(change.first, change.second);
+            }
+            for (int n = 0; n < count; ++n) {
+                pinStatus();
+            }
+        }
+    };
+
+    // setup在计时和计数之外执行，例如取消之前先钉住窗口
+    template<typename Setup, typename F>
+    Result measure(int iterations, Setup&& setup, F&& run) {
+        Result total;
+        double nanos = 0;
+        for (int n = 0; n < iterations; ++n) {
+            Model model;
+            setup(model);
+            model.result = Result();
+            auto start = std::chrono::steady_clock::now();
+            run(model);
+            nanos += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            total = model.result;
+        }
+        total.nanos = nanos / iterations;
+        return total;
+    }
+
+    void print(const char* name, int count, const Result& r) {
+        std::printf("%-18s %5d %8ld %8ld %8ld %10ld %10ld %12.0f\n",
+                    name, count, r.commits, r.items, r.rects, r.refreshes, r.sleepMs, r.nanos);
+    }
+
+} // namespace
+
+int main() {
+    constexpr int ITERATIONS = 2000;
+    std::printf("%-18s %5s %8s %8s %8s %10s %10s %12s\n",
+                "operation", "pins", "commits", "items", "rects", "refreshes", "sleep ms", "ns");
+    for (int count : { 1, 10, 100 }) {
+        auto none = [](Model&) {};
+        auto pinAll = [count](Model& m) { m.batched(count, [&m](int t) { m.pin(t); }); };
+        auto pinEach = [count](Model& m) { m.eachWindow(count, true, [&m](int t) { m.pin(t); }); };
+        auto unpinEach = [count](Model& m) { m.eachWindow(count, false, [&m](int t) { m.unpin(t); }); };
+        auto unpinBatch = [count](Model& m) { m.batched(count, [&m](int t) { m.unpin(t); }); };
+        print("auto-pin (each)", count, measure(ITERATIONS, none, pinEach));
+        print("auto-pin (batch)", count, measure(ITERATIONS, none, pinAll));
+        print("unpin all (each)", count, measure(ITERATIONS, pinAll, unpinEach));
+        print("unpin all (batch)", count, measure(ITERATIONS, pinAll, unpinBatch));
+    }
+    return 0;
+}
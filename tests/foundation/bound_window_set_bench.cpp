@@ -0,0 +1,84 @@
+#include "foundation/bound_window_set.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// 已绑定5/50/500个窗口时，再置顶并取消置顶一个窗口的开销：
+// 逐个加入/移除与原先每次图钉状态变化都完整重建（WindowBindingManager::updateBoundWindows）比较。
+// 位置查询在程序中是GetWindowRect（加上IsWindow/IsIconic），钩子引用在重建时全部释放再逐个取得，
+// 这里只计数、不含系统调用本身的耗时；计时只反映集合维护的开销。
+
+namespace {
+
+    struct Point {
+        long x;
+        long y;
+    };
+    using Set = Foundation::BoundWindowSet<int, Point>;
+
+    struct Counters {
+        long queries = 0;
+        long hooks = 0;
+    };
+
+    template<typename F>
+    double nanosPer(int iterations, F&& f) {
+        auto start = std::chrono::steady_clock::now();
+        for (int n = 0; n < iterations; ++n) {
+            f();
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+    }
+
+} // namespace
+
+int main() {
+    constexpr int ITERATIONS = 20000;
+    std::printf("%6s %18s %14s %14s %18s %14s %14s\n", "bound",
+                "ns/op (incr)", "rects (incr)", "hooks (incr)", "ns/op (rebuild)", "rects (rebuild)", "hooks (rebuild)");
+    for (int bound : { 5, 50, 500 }) {
+        Counters counters;
+        auto locate = [&counters](int wnd, Point& point) {
+            ++counters.queries;
+            point = { wnd * 10L, wnd * 20L };
+            return true;
+        };
+
+        std::vector<int> pinned;
+        for (int wnd = 1; wnd <= bound; ++wnd) {
+            pinned.push_back(wnd);
+        }
+        const int extra = bound + 1;
+
+        // 一次操作 = 置顶一个窗口再取消置顶，与addBoundWindow/removeBoundWindow相同
+        Set incremental;
+        incremental.assign(pinned, locate);
+        counters = Counters();
+        double incrNanos = nanosPer(ITERATIONS, [&] {
+            if (incremental.add(extra, locate)) ++counters.hooks;
+            if (incremental.remove(extra)) ++counters.hooks;
+        });
+        Counters incr = counters;
+
+        // 原先两次状态变化各自重建一次
+        Set rebuilt;
+        std::vector<int> withExtra = pinned;
+        withExtra.push_back(extra);
+        counters = Counters();
+        double rebuildNanos = nanosPer(ITERATIONS, [&] {
+            for (const std::vector<int>* list : { &withExtra, &pinned }) {
+                // 先释放全部钩子引用，再为每个窗口重新取得
+                counters.hooks += static_cast<long>(rebuilt.size());
+                rebuilt.assign(*list, locate);
+                counters.hooks += static_cast<long>(rebuilt.size());
+            }
+        });
+        Counters rebuild = counters;
+
+        std::printf("%6d %18.1f %14.1f %14.1f %18.1f %14.1f %14.1f\n", bound,
+                    incrNanos, double(incr.queries) / ITERATIONS, double(incr.hooks) / ITERATIONS,
+                    rebuildNanos, double(rebuild.queries) / ITERATIONS, double(rebuild.hooks) / ITERATIONS);
+    }
+    std::printf("(rects = position queries per op, hooks = hook reference changes per op)\n");
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "foundation/bound_window_set.h"
+#include "test_common.h"
+#include <map>
+#include <vector>
+
+namespace {
+
+    struct Point {
+        int x;
+        int y;
+    };
+    using Set = Foundation::BoundWindowSet<int, Point>;
+
+    // 模拟的桌面：窗口i位于(i*10, i*20)，minimized中的窗口没有位置；记录查询次数
+    struct Desktop {
+        std::map<int, bool> minimized;
+        int queries = 0;
+
+        bool operator()(int wnd, Point& point) {
+            ++queries;
+            if (minimized[wnd]) return false;
+            point = { wnd * 10, wnd * 20 };
+            return true;
+        }
+    };
+
+    bool hasPosition(Set& set, int wnd, int x, int y) {
+        auto it = set.committed().find(wnd);
+        return it != set.committed().end() && it->second.x == x && it->second.y == y;
+    }
+
+    // 逐个加入/移除只查询变化的那一个窗口
+    void testIncremental() {
+        Set set;
+        Desktop desktop;
+        desktop.minimized[3] = true;
+        CHECK(set.add(1, desktop));
+        CHECK(set.add(2, desktop));
+        CHECK(set.add(3, desktop));
+        CHECK(desktop.queries == 3);
+        CHECK(!set.add(2, desktop));
+        CHECK(desktop.queries == 3);
+
+        CHECK(set.size() == 3 && set.contains(3));
+        CHECK(hasPosition(set, 1, 10, 20) && hasPosition(set, 2, 20, 40));
+        CHECK(set.committed().count(3) == 0);
+
+        set.targets()[2] = { 5, 5 };
+        CHECK(set.remove(2));
+        CHECK(!set.remove(2));
+        CHECK(!set.contains(2) && set.size() == 2);
+        CHECK(set.committed().count(2) == 0 && set.targets().count(2) == 0);
+        CHECK(desktop.queries == 3);
+    }
+
+    // 完整重建与逐个更新的结果相同，并丢弃尚未提交的目标位置
+    void testAssign() {
+        Set incremental, rebuilt;
+        Desktop desktop;
+        desktop.minimized[4] = true;
+        std::vector<int> pinned;
+        for (int wnd = 1; wnd <= 5; ++wnd) {
+            incremental.add(wnd, desktop);
+            pinned.push_back(wnd);
+        }
+        incremental.remove(2);
+        pinned.erase(pinned.begin() + 1);
+
+        rebuilt.add(9, desktop);
+        rebuilt.targets()[1] = { 0, 0 };
+        desktop.queries = 0;
+        rebuilt.assign(pinned, desktop);
+        CHECK(desktop.queries == 4);
+        CHECK(rebuilt.size() == 4 && !rebuilt.contains(9) && !rebuilt.contains(2));
+        CHECK(rebuilt.targets().empty());
+        CHECK(rebuilt.committed().size() == incremental.committed().size());
+        for (int wnd : { 1, 3, 5 }) {
+            CHECK(hasPosition(rebuilt, wnd, wnd * 10, wnd * 20));
+            CHECK(hasPosition(incremental, wnd, wnd * 10, wnd * 20));
+        }
+
+        // 恢复后重新查询得到之前没有的位置
+        desktop.minimized[4] = false;
+        rebuilt.relocate(desktop);
+        CHECK(hasPosition(rebuilt, 4, 40, 80));
+
+        rebuilt.clear();
+        CHECK(rebuilt.size() == 0 && rebuilt.committed().empty());
+    }
+
+} // namespace
+
+int main() {
+    testIncremental();
+    testAssign();
+    return Test::report("bound_window_set_test");
+}
@@ -0,0 +1,173 @@
+#include "foundation/inline_string.h"
+#include "test_common.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 统计全局operator new的调用次数，用于测量每个刻度的堆分配
+namespace {
+    size_t g_allocations = 0;
+}
+
+void* operator new(size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+    using Foundation::InlineWString;
+
+    // 容量包含结尾的0，最多保存Capacity-1个字符
+    void testTruncation() {
+        InlineWString<5> s(L"abcdefgh");
+        CHECK(s == L"abcd");
+        CHECK(s.size() == 4 && s.c_str()[4] == L'\0');
+
+        s = std::wstring_view(L"wxyz");
+        CHECK(s == L"wxyz");
+        s = std::wstring_view(L"wxyz!", 5);
+        CHECK(s == L"wxyz");
+        s.assign(L"12", 2);
+        CHECK(s == L"12");
+
+        // 没有结尾0的源只读取到容量为止
+        const wchar_t unterminated[8] = { L'p', L'q', L'r', L's', L't', L'u', L'v', L'w' };
+        InlineWString<4> t(unterminated);
+        CHECK(t == L"pqr");
+
+        InlineWString<1> empty(L"abc");
+        CHECK(empty.empty() && empty.c_str()[0] == L'\0');
+        InlineWString<4> null(static_cast<const wchar_t*>(nullptr));
+        CHECK(null.empty());
+    }
+
+    // setLength截断到Capacity-1并补上结尾的0
+    void testSetLength() {
+        InlineWString<6> s;
+        auto fill = [&s] {
+            for (size_t n = 0; n < s.capacity(); ++n) {
+                s.buffer()[n] = L'a' + wchar_t(n);
+            }
+        };
+        fill();
+        s.setLength(3);
+        CHECK(s == L"abc" && s.c_str()[3] == L'\0');
+        fill();
+        s.setLength(100);
+        CHECK(s.size() == 5 && s == L"abcde" && s.c_str()[5] == L'\0');
+        s.setLength(0);
+        CHECK(s.empty() && s.c_str()[0] == L'\0');
+    }
+
+    // 源与自身的缓冲区重叠时按memmove复制
+    void testOverlap() {
+        InlineWString<16> s(L"0123456789");
+        s = s;
+        CHECK(s == L"0123456789");
+
+        s.assign(s.data() + 3, 5);
+        CHECK(s == L"34567");
+
+        s = s.view().substr(1);
+        CHECK(s == L"4567");
+
+        s.assign(s.data(), s.size());
+        CHECK(s == L"4567");
+
+        InlineWString<16> copy(s);
+        copy = copy.view().substr(0, 2);
+        CHECK(copy == L"45" && s == L"4567");
+    }
+
+    // 与窗口缓存中每个刻度的工作相同：为每个窗口取标题和类名（由API直接写入缓冲区），
+    // 与缓存项比较后更新，再按规则查找子串。标题长度超过std::wstring的短字符串缓冲区
+    struct Window {
+        std::wstring title;
+        std::wstring cls;
+    };
+
+    template<typename Text, typename ClassName>
+    struct Entry {
+        Text title;
+        ClassName cls;
+    };
+
+    template<typename Text>
+    void fetch(Text& out, const std::wstring& source);
+
+    template<>
+    void fetch(std::wstring& out, const std::wstring& source) {
+        // 原先的做法：写入栈上的缓冲区后构造std::wstring
+        wchar_t buffer[256];
+        size_t length = source.copy(buffer, 255);
+        out = std::wstring(buffer, length);
+    }
+
+    template<size_t N>
+    void fetch(InlineWString<N>& out, const std::wstring& source) {
+        out.setLength(source.copy(out.buffer(), out.capacity() - 1));
+    }
+
+    template<typename Text, typename ClassName>
+    size_t tick(const std::vector<Window>& windows, std::unordered_map<size_t, Entry<Text, ClassName>>& cache) {
+        size_t matches = 0;
+        for (size_t n = 0; n < windows.size(); ++n) {
+            Text title;
+            ClassName cls;
+            fetch(title, windows[n].title);
+            fetch(cls, windows[n].cls);
+
+            Entry<Text, ClassName>& entry = cache[n];
+            if (!(entry.title == title)) entry.title = title;
+            if (!(entry.cls == cls)) entry.cls = cls;
+            if (entry.title.find(L"Notepad") != Text::npos) ++matches;
+        }
+        return matches;
+    }
+
+    template<typename Text, typename ClassName>
+    size_t allocationsPerTick(const std::vector<Window>& windows) {
+        std::unordered_map<size_t, Entry<Text, ClassName>> cache;
+        cache.reserve(windows.size());
+        tick(windows, cache);       // 第一个刻度创建缓存项
+
+        constexpr size_t TICKS = 100;
+        size_t before = g_allocations;
+        for (size_t n = 0; n < TICKS; ++n) {
+            tick(windows, cache);
+        }
+        return (g_allocations - before) / TICKS;
+    }
+
+    void testAllocationsPerTick() {
+        std::vector<Window> windows;
+        for (int n = 0; n < 50; ++n) {
+            windows.push_back({ L"Document " + std::to_wstring(n) + L" - Notepad - a fairly typical window title",
+                                L"Notepad_MainWindowClass_" + std::to_wstring(n) });
+        }
+
+        using WindowText = InlineWString<256>;
+        size_t before = allocationsPerTick<std::wstring, std::wstring>(windows);
+        size_t after = allocationsPerTick<WindowText, WindowText>(windows);
+        std::printf("allocations per tick (50 windows): std::wstring %zu, InlineWString %zu\n", before, after);
+        CHECK(before >= windows.size());
+        CHECK(after == 0);
+    }
+
+} // namespace
+
+int main() {
+    testTruncation();
+    testSetLength();
+    testOverlap();
+    testAllocationsPerTick();
+    return Test::report("inline_string_test");
+}
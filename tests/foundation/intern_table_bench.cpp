@@ -0,0 +1,292 @@
+#include "foundation/intern_table.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 窗口检测函数和自动图钉规则在300个窗口上的一轮检查：类名驻留之前与之后比较。
+// 之前：每个检测函数从窗口缓存复制一次类名（256字符的InlineWString）并逐个不区分大小写地比较，
+//       isProgManWnd总是获取标题，每条规则都获取标题和类名再做通配符匹配；
+// 之后：每次按类原子查ID（ClassRegistry::classOf，加锁查表），检测函数比较整数或特性位，
+//       规则的类名模式不含通配符时先按ID预筛选（规则的类ID在编译规则时驻留，窗口的类ID每个窗口查询一次），
+//       类不同就不获取类名和标题。
+// 标题通过TextFetcher获取（可能向其他进程发送WM_GETTEXT），这里只计数；类原子的读取不计时。
+// 规则中八成按确切的类名（一半是桌面上存在的类），两成为类名"*"加标题通配符。
+
+namespace {
+
+    constexpr size_t CAPACITY = 256;    // Constants::MAX_CLASSNAME_LEN
+    using Table = Foundation::InternTable<CAPACITY>;
+    using ClassName = Table::Name;
+
+    // 与StringUtils::wildcardMatch相同（string_utils.cpp依赖Windows的格式化函数，不能在此链接）
+    bool wildcardMatch(const wchar_t* pattern, const wchar_t* str) {
+        if (!pattern || !*pattern)
+            return !str || !*str;
+        if (!str || !*str) {
+            while (*pattern == L'*') pattern++;
+            return !*pattern;
+        }
+        if (*pattern == L'*') {
+            while (*(pattern + 1) == L'*') pattern++;
+            return wildcardMatch(pattern + 1, str) || wildcardMatch(pattern, str + 1);
+        }
+        if (*pattern == L'?' || *pattern == *str)
+            return wildcardMatch(pattern + 1, str + 1);
+        return false;
+    }
+
+    // 与StringUtils::strimatch相同：按ASCII不区分大小写的完整比较
+    bool strimatch(const wchar_t* a, const wchar_t* b) {
+        for (;; ++a, ++b) {
+            wchar_t x = (*a >= L'A' && *a <= L'Z') ? wchar_t(*a + 32) : *a;
+            wchar_t y = (*b >= L'A' && *b <= L'Z') ? wchar_t(*b + 32) : *b;
+            if (x != y) return false;
+            if (!x) return true;
+        }
+    }
+
+    const wchar_t* const CLASSES[] = {
+        L"Chrome_WidgetWin_1", L"CabinetWClass", L"Notepad", L"ConsoleWindowClass", L"CASCADIA_HOSTING_WINDOW_CLASS",
+        L"ApplicationFrameWindow", L"Windows.UI.Core.CoreWindow", L"XAML_WindowedPopupClass", L"TApplication",
+        L"Shell_TrayWnd", L"Shell_SecondaryTrayWnd", L"Progman", L"WorkerW", L"tooltips_class32", L"#32770",
+        L"IME", L"MSCTFIME UI", L"GDI+ Hook Window Class", L"OleMainThreadWndClass", L"MozillaWindowClass",
+        L"SunAwtFrame", L"Qt5QWindowIcon", L"HwndWrapper[DefaultDomain;;]", L"WindowsForms10.Window.8.app.0.1",
+        L"OpusApp", L"XLMAIN", L"PPTFrameClass", L"rctrl_renwnd32", L"Vim", L"SDL_app",
+    };
+    constexpr size_t CLASS_COUNT = sizeof(CLASSES) / sizeof(CLASSES[0]);
+
+    struct Window {
+        int wnd;
+        uint16_t atom;
+        std::wstring cls;
+        std::wstring title;
+    };
+
+    struct Rule {
+        std::wstring ttl;
+        std::wstring cls;
+        Table::Id classId = 0;  // 类名模式不含通配符时的类ID（AutoPinMatcher::compile）
+    };
+
+    std::wstring word(std::mt19937& rng) {
+        std::wstring w;
+        for (int n = 3 + int(rng() % 6); n > 0; --n) {
+            w += wchar_t(L'a' + rng() % 26);
+        }
+        return w;
+    }
+
+    std::vector<Window> makeDesktop(std::mt19937& rng) {
+        std::vector<Window> windows;
+        for (int n = 0; n < 300; ++n) {
+            size_t c = rng() % CLASS_COUNT;
+            windows.push_back({ n + 1, uint16_t(0xC000 + c), CLASSES[c], word(rng) + L" " + word(rng) + L" - " + word(rng) });
+        }
+        return windows;
+    }
+
+    std::vector<Rule> makeRules(int count, std::mt19937& rng) {
+        std::vector<Rule> rules;
+        for (int n = 0; n < count; ++n) {
+            if (n % 5 == 4) {
+                rules.push_back({ L"*" + word(rng) + L"*", L"*" });
+            } else if (n % 2) {
+                rules.push_back({ L"*", CLASSES[rng() % CLASS_COUNT] });
+            } else {
+                rules.push_back({ L"*" + word(rng) + L"*", L"Missing" + word(rng) });
+            }
+        }
+        return rules;
+    }
+
+    struct Counters {
+        long titleFetches = 0;
+        long matches = 0;
+    };
+
+    // 驻留之前：窗口缓存中的类名按值返回
+    struct Before {
+        std::mutex mutex;
+        std::unordered_map<int, ClassName> classNames;
+        Counters counters;
+
+        explicit Before(const std::vector<Window>& windows) {
+            for (const Window& w : windows) {
+                classNames[w.wnd] = ClassName(w.cls);
+            }
+        }
+
+        ClassName className(const Window& w) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return classNames[w.wnd];
+        }
+
+        const std::wstring& title(const Window& w) {
+            ++counters.titleFetches;
+            return w.title;
+        }
+
+        int run(const Window& w, const std::vector<Rule>& rules) {
+            int hits = 0;
+            ClassName cls = className(w);
+            const std::wstring& text = title(w);
+            hits += strimatch(cls.c_str(), L"ProgMan") && strimatch(text.c_str(), L"Program Manager");
+            hits += strimatch(className(w).c_str(), L"Shell_TrayWnd");
+            hits += strimatch(L"TApplication", className(w).c_str());
+            cls = className(w);
+            hits += strimatch(L"ApplicationFrameWindow", cls.c_str()) ||
+                    strimatch(L"Windows.UI.Core.CoreWindow", cls.c_str()) ||
+                    strimatch(L"XAML_WindowedPopupClass", cls.c_str());
+            cls = className(w);
+            hits += cls == L"Windows.UI.Core.CoreWindow" || cls == L"DirectUIHWND" ||
+                    cls.find(L"Chrome") != ClassName::npos || cls.find(L"Content") != ClassName::npos;
+            for (const Rule& rule : rules) {
+                const std::wstring& ruleTitle = title(w);
+                ClassName ruleClass = className(w);
+                if (wildcardMatch(rule.ttl.c_str(), ruleTitle.c_str()) && wildcardMatch(rule.cls.c_str(), ruleClass.c_str())) {
+                    ++counters.matches;
+                }
+            }
+            return hits;
+        }
+    };
+
+    // 驻留之后：与ClassRegistry相同的结构
+    struct After {
+        enum : Table::Id { PROGMAN = 1, SHELL_TRAY, VCL_APPLICATION, APPLICATION_FRAME, CORE_WINDOW, XAML_POPUP, DIRECT_UI };
+        enum : uint8_t { TRAIT_MODERN_APP = 1, TRAIT_PROXY_CONTENT = 2 };
+
+        mutable std::mutex mutex;
+        Table table;
+        std::vector<uint8_t> traits{ 0 };
+        std::unordered_map<uint16_t, Table::Id> atoms;
+        std::unordered_map<int, ClassName> classNames;
+        Counters counters;
+
+        After(const std::vector<Window>& windows, std::vector<Rule>& rules) {
+            for (const wchar_t* name : { L"ProgMan", L"Shell_TrayWnd", L"TApplication", L"ApplicationFrameWindow",
+                                         L"Windows.UI.Core.CoreWindow", L"XAML_WindowedPopupClass", L"DirectUIHWND" }) {
+                intern(name);
+            }
+            // 类原子映射在第一轮之后都已命中
+            for (const Window& w : windows) {
+                atoms[w.atom] = intern(w.cls);
+                classNames[w.wnd] = ClassName(w.cls);
+            }
+            for (Rule& rule : rules) {
+                if (!rule.cls.empty() && rule.cls.find_first_of(L"*?") == std::wstring::npos) {
+                    rule.classId = intern(rule.cls);
+                }
+            }
+        }
+
+        Table::Id intern(std::wstring_view name) {
+            bool added = false;
+            Table::Id id = table.intern(name, &added);
+            if (added) {
+                std::wstring_view folded = table.folded(id);
+                uint8_t t = 0;
+                if (folded == L"applicationframewindow" || folded == L"windows.ui.core.corewindow" ||
+                    folded == L"xaml_windowedpopupclass") {
+                    t |= TRAIT_MODERN_APP;
+                }
+                if (folded == L"windows.ui.core.corewindow" || folded == L"directuihwnd" ||
+                    folded.find(L"chrome") != std::wstring_view::npos || folded.find(L"content") != std::wstring_view::npos) {
+                    t |= TRAIT_PROXY_CONTENT;
+                }
+                traits.push_back(t);
+            }
+            return id;
+        }
+
+        Table::Id classOf(const Window& w) {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = atoms.find(w.atom);
+            return it != atoms.end() ? it->second : 0;
+        }
+
+        bool hasTrait(Table::Id id, uint8_t trait) const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return id < traits.size() && (traits[id] & trait) != 0;
+        }
+
+        ClassName className(const Window& w) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return classNames[w.wnd];
+        }
+
+        const std::wstring& title(const Window& w) {
+            ++counters.titleFetches;
+            return w.title;
+        }
+
+        int run(const Window& w, const std::vector<Rule>& rules) {
+            int hits = 0;
+            hits += classOf(w) == PROGMAN && strimatch(title(w).c_str(), L"Program Manager");
+            hits += classOf(w) == SHELL_TRAY;
+            hits += classOf(w) == VCL_APPLICATION;
+            hits += hasTrait(classOf(w), TRAIT_MODERN_APP);
+            hits += hasTrait(classOf(w), TRAIT_PROXY_CONTENT);
+            // AutoPinMatcher::match
+            Table::Id wndClass = 0;
+            bool classLooked = false;
+            for (const Rule& rule : rules) {
+                if (rule.classId) {
+                    if (!classLooked) {
+                        wndClass = classOf(w);
+                        classLooked = true;
+                    }
+                    if (wndClass != rule.classId) continue;
+                }
+                if (rule.cls != L"*" && !wildcardMatch(rule.cls.c_str(), className(w).c_str())) continue;
+                if (rule.ttl == L"*" || wildcardMatch(rule.ttl.c_str(), title(w).c_str())) {
+                    ++counters.matches;
+                }
+            }
+            return hits;
+        }
+    };
+
+    template<typename Impl>
+    double nanosPerWindow(Impl& impl, const std::vector<Window>& windows, const std::vector<Rule>& rules, int rounds) {
+        int hits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            for (const Window& w : windows) {
+                hits += impl.run(w, rules);
+            }
+        }
+        double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (hits < 0) std::printf("%d", hits);
+        return nanos / (double(rounds) * windows.size());
+    }
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(1);
+    std::vector<Window> windows = makeDesktop(rng);
+
+    std::printf("%6s %16s %16s %16s %16s %10s\n", "rules", "ns/wnd (before)", "titles (before)",
+                "ns/wnd (after)", "titles (after)", "matches");
+    for (int count : { 0, 10, 50 }) {
+        std::vector<Rule> rules = makeRules(count, rng);
+        const int rounds = 200;
+        Before before(windows);
+        After after(windows, rules);
+        double beforeNanos = nanosPerWindow(before, windows, rules, rounds);
+        double afterNanos = nanosPerWindow(after, windows, rules, rounds);
+        double scale = double(rounds) * windows.size();
+        std::printf("%6d %16.0f %16.2f %16.0f %16.2f %5ld/%-5ld\n", count,
+                    beforeNanos, before.counters.titleFetches / scale,
+                    afterNanos, after.counters.titleFetches / scale,
+                    long(before.counters.matches / rounds), long(after.counters.matches / rounds));
+    }
+    std::printf("(titles = title fetches per window; matches = rule matches per round, before/after)\n");
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "foundation/intern_table.h"
+#include "test_common.h"
+#include <string>
+
+using Table = Foundation::InternTable<16>;
+
+namespace {
+
+    // 按ASCII不区分大小写，ID从1开始连续分配，保存第一次出现时的大小写
+    void testIntern() {
+        Table table;
+        CHECK(table.size() == 0);
+        CHECK(table.intern(L"") == 0);
+
+        bool added = false;
+        Table::Id progman = table.intern(L"Progman", &added);
+        CHECK(progman == 1 && added);
+        CHECK(table.intern(L"PROGMAN", &added) == progman && !added);
+        CHECK(table.intern(L"Shell_TrayWnd") == 2);
+        CHECK(table.size() == 2);
+
+        CHECK(table.name(progman) == L"Progman");
+        CHECK(table.folded(progman) == L"progman");
+        CHECK(table.name(0).empty() && table.name(99).empty());
+    }
+
+    // find不驻留新名称
+    void testFind() {
+        Table table;
+        table.intern(L"Notepad");
+        CHECK(table.find(L"notepad") == 1);
+        CHECK(table.find(L"NOTEPAD") == 1);
+        CHECK(table.find(L"Notepad2") == 0);
+        CHECK(table.find(L"") == 0);
+        CHECK(table.size() == 1);
+    }
+
+    // 只转换ASCII字母；超长的名称按容量截断后比较
+    void testFoldAndTruncate() {
+        Table table;
+        Table::Id a = table.intern(L"Äpfel");
+        CHECK(table.find(L"äpfel") == 0);
+        CHECK(table.find(L"ÄPFEL") == a);
+
+        Table::Id longName = table.intern(L"ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+        CHECK(table.name(longName) == L"ABCDEFGHIJKLMNO");
+        CHECK(table.find(L"abcdefghijklmnoXYZ") == longName);
+
+        // 键引用的字符串在后续驻留时不移动
+        for (int n = 0; n < 1000; ++n) {
+            table.intern(L"c" + std::to_wstring(n));
+        }
+        CHECK(table.find(L"ÄPFEL") == a && table.find(L"c999") == table.size());
+    }
+
+} // namespace
+
+int main() {
+    testIntern();
+    testFind();
+    testFoldAndTruncate();
+    return Test::report("intern_table_test");
+}
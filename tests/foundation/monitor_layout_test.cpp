@@ -0,0 +1,229 @@
+#include "foundation/monitor_layout.h"
+#include "test_common.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using Foundation::MonitorLayout;
+using Rect = MonitorLayout::Rect;
+
+namespace {
+
+    // 逐个比较的参考实现，与MONITOR_DEFAULTTONEAREST的规则相同
+    long long distanceSq(const Rect& rc, int x, int y) {
+        long long dx = x < rc.left ? rc.left - x : (x >= rc.right ? x - rc.right + 1 : 0);
+        long long dy = y < rc.top ? rc.top - y : (y >= rc.bottom ? y - rc.bottom + 1 : 0);
+        return dx * dx + dy * dy;
+    }
+
+    size_t referenceFromPoint(const std::vector<MonitorLayout::Monitor>& monitors, int x, int y) {
+        for (size_t i = 0; i < monitors.size(); ++i) {
+            if (monitors[i].bounds.contains(x, y)) return i;
+        }
+        size_t best = MonitorLayout::npos;
+        long long bestDist = 0;
+        for (size_t i = 0; i < monitors.size(); ++i) {
+            long long dist = distanceSq(monitors[i].bounds, x, y);
+            if (best == MonitorLayout::npos || dist < bestDist) {
+                best = i;
+                bestDist = dist;
+            }
+        }
+        return best;
+    }
+
+    size_t referenceFromRect(const std::vector<MonitorLayout::Monitor>& monitors, const Rect& rc) {
+        int cx = rc.left + (rc.right - rc.left) / 2;
+        int cy = rc.top + (rc.bottom - rc.top) / 2;
+        if (rc.empty()) return referenceFromPoint(monitors, cx, cy);
+
+        size_t best = MonitorLayout::npos;
+        long long bestArea = 0;
+        for (size_t i = 0; i < monitors.size(); ++i) {
+            const Rect& m = monitors[i].bounds;
+            long long w = (std::min)(m.right, rc.right) - (std::max)(m.left, rc.left);
+            long long h = (std::min)(m.bottom, rc.bottom) - (std::max)(m.top, rc.top);
+            long long area = (w > 0 && h > 0) ? w * h : 0;
+            if (area > bestArea) {
+                best = i;
+                bestArea = area;
+            }
+        }
+        return best != MonitorLayout::npos ? best : referenceFromPoint(monitors, cx, cy);
+    }
+
+    MonitorLayout::Monitor monitor(uintptr_t id, int left, int top, int width, int height, int dpi) {
+        Rect bounds = { left, top, left + width, top + height };
+        // 任务栏在底部，高度随DPI缩放
+        Rect workArea = { left, top, left + width, top + height - 48 * dpi / 96 };
+        return { id, bounds, workArea, dpi };
+    }
+
+    // 与Windows中按物理像素报告的混合DPI布局相同：
+    // 主显示器2560x1440（144 DPI）在原点，左侧1920x1080（96 DPI）下沿对齐，
+    // 上方4K（192 DPI）右边缘与主显示器对齐，右侧竖屏1080x1920（96 DPI）向上偏移
+    std::vector<MonitorLayout::Monitor> mixedLayout() {
+        return {
+            monitor(1, 0, 0, 2560, 1440, 144),
+            monitor(2, -1920, 360, 1920, 1080, 96),
+            monitor(3, -1280, -2160, 3840, 2160, 192),
+            monitor(4, 2560, -240, 1080, 1920, 96),
+        };
+    }
+
+    bool overlaps(const Rect& a, const Rect& b) {
+        return a.left < b.right && b.left < a.right && a.top < b.bottom && b.top < a.bottom;
+    }
+
+    // 随机布局：每个显示器贴在已有显示器的某一边上，位置沿该边随机偏移，不重叠
+    std::vector<MonitorLayout::Monitor> randomLayout(std::mt19937& rng, size_t count) {
+        struct Mode { int width, height, dpi; };
+        const Mode modes[] = {
+            { 1920, 1080, 96 }, { 2560, 1440, 120 }, { 2560, 1440, 144 }, { 3840, 2160, 144 },
+            { 3840, 2160, 192 }, { 1366, 768, 96 }, { 1080, 1920, 96 }, { 2160, 3840, 168 },
+        };
+
+        std::vector<MonitorLayout::Monitor> monitors;
+        const Mode& first = modes[rng() % 8];
+        monitors.push_back(monitor(1, 0, 0, first.width, first.height, first.dpi));
+        while (monitors.size() < count) {
+            const Mode& mode = modes[rng() % 8];
+            const Rect& base = monitors[rng() % monitors.size()].bounds;
+            int left, top;
+            switch (rng() % 4) {
+            case 0:
+                left = base.left - mode.width;
+                top = base.top - mode.height + 1 + int(rng() % (base.bottom - base.top + mode.height - 1));
+                break;
+            case 1:
+                left = base.right;
+                top = base.top - mode.height + 1 + int(rng() % (base.bottom - base.top + mode.height - 1));
+                break;
+            case 2:
+                top = base.top - mode.height;
+                left = base.left - mode.width + 1 + int(rng() % (base.right - base.left + mode.width - 1));
+                break;
+            default:
+                top = base.bottom;
+                left = base.left - mode.width + 1 + int(rng() % (base.right - base.left + mode.width - 1));
+                break;
+            }
+            MonitorLayout::Monitor m = monitor(monitors.size() + 1, left, top, mode.width, mode.height, mode.dpi);
+            bool free = true;
+            for (const MonitorLayout::Monitor& other : monitors) {
+                free = free && !overlaps(other.bounds, m.bounds);
+            }
+            if (free) monitors.push_back(m);
+        }
+        return monitors;
+    }
+
+    // 随机点和矩形与参考实现一致，包括桌面之外、显示器边界和空矩形
+    void compareWithReference(const std::vector<MonitorLayout::Monitor>& monitors, std::mt19937& rng, int queries) {
+        MonitorLayout layout;
+        layout.assign(monitors);
+
+        int left = monitors[0].bounds.left, top = monitors[0].bounds.top;
+        int right = monitors[0].bounds.right, bottom = monitors[0].bounds.bottom;
+        for (const MonitorLayout::Monitor& m : monitors) {
+            left = (std::min)(left, m.bounds.left);
+            top = (std::min)(top, m.bounds.top);
+            right = (std::max)(right, m.bounds.right);
+            bottom = (std::max)(bottom, m.bounds.bottom);
+        }
+        auto coord = [&rng](int lo, int hi) { return lo - 500 + int(rng() % unsigned(hi - lo + 1000)); };
+
+        int mismatches = 0;
+        for (int n = 0; n < queries; ++n) {
+            int x = coord(left, right), y = coord(top, bottom);
+            if (layout.fromPoint(x, y) != referenceFromPoint(monitors, x, y)) ++mismatches;
+
+            // 显示器的边和角上的点
+            const Rect& edge = monitors[rng() % monitors.size()].bounds;
+            int ex = (rng() & 1) ? edge.left : edge.right - 1 + int(rng() % 2);
+            int ey = (rng() & 1) ? edge.top : edge.bottom - 1 + int(rng() % 2);
+            if (layout.fromPoint(ex, ey) != referenceFromPoint(monitors, ex, ey)) ++mismatches;
+
+            // 图钉大小到窗口大小的矩形，偶尔为空
+            int w = int(rng() % 4) == 0 ? 0 : 32 + int(rng() % 3000);
+            int h = int(rng() % 4) == 0 ? 0 : 32 + int(rng() % 2000);
+            Rect rc = { x, y, x + w, y + h };
+            if (layout.fromRect(rc) != referenceFromRect(monitors, rc)) ++mismatches;
+        }
+        CHECK(mismatches == 0);
+    }
+
+    void testMixedLayout() {
+        std::vector<MonitorLayout::Monitor> monitors = mixedLayout();
+        MonitorLayout layout;
+        layout.assign(monitors);
+
+        for (size_t i = 0; i < monitors.size(); ++i) {
+            for (size_t j = i + 1; j < monitors.size(); ++j) {
+                CHECK(!overlaps(monitors[i].bounds, monitors[j].bounds));
+            }
+        }
+        CHECK(layout.monitors().size() == 4);
+        CHECK(layout.monitors()[2].dpi == 192);
+        CHECK(layout.monitors()[0].workArea.bottom == 1440 - 72);
+
+        CHECK(layout.fromPoint(0, 0) == 0);
+        CHECK(layout.fromPoint(-1, 360) == 1);
+        // 与两个显示器距离相同时取序号小的
+        CHECK(layout.fromPoint(-1, 359) == 0);
+        CHECK(layout.fromPoint(-1920, 1439) == 1);
+        CHECK(layout.fromPoint(-1280, -1) == 2);
+        CHECK(layout.fromPoint(2559, -1) == 2);
+        CHECK(layout.fromPoint(2560, -1) == 3);
+        CHECK(layout.fromPoint(3639, 1679) == 3);
+        // 右边界和下边界不属于显示器
+        CHECK(layout.fromPoint(2560, 1439) == 3);
+        CHECK(layout.fromPoint(100, 1440) == 0);
+
+        // 桌面之外的点取最近的显示器
+        CHECK(layout.fromPoint(-5000, 800) == 1);
+        CHECK(layout.fromPoint(5000, 0) == 3);
+        CHECK(layout.fromPoint(100, -5000) == 2);
+        CHECK(layout.fromPoint(-1000, 2000) == 1);
+
+        // 跨越显示器的窗口取相交面积最大的
+        CHECK(layout.fromRect({ -300, 400, 700, 900 }) == 0);
+        CHECK(layout.fromRect({ -900, 400, 100, 900 }) == 1);
+        CHECK(layout.fromRect({ 2400, -300, 3000, 200 }) == 3);
+        CHECK(layout.fromRect({ 1000, -100, 1200, 100 }) == 0 || layout.fromRect({ 1000, -100, 1200, 100 }) == 2);
+        CHECK(layout.fromRect({ 1000, -101, 1200, 99 }) == 2);
+        CHECK(layout.fromRect({ 5000, 5000, 5100, 5100 }) == 3);
+
+        std::mt19937 rng(42);
+        compareWithReference(monitors, rng, 20000);
+    }
+
+    void testRandomLayouts() {
+        std::mt19937 rng(7);
+        for (int n = 0; n < 200; ++n) {
+            std::vector<MonitorLayout::Monitor> monitors = randomLayout(rng, 1 + n % 8);
+            compareWithReference(monitors, rng, 500);
+        }
+    }
+
+    void testEmpty() {
+        MonitorLayout layout;
+        CHECK(layout.empty());
+        CHECK(layout.fromPoint(0, 0) == MonitorLayout::npos);
+        CHECK(layout.fromRect({ 0, 0, 10, 10 }) == MonitorLayout::npos);
+
+        // 重新分配后旧的索引不残留
+        layout.assign(mixedLayout());
+        layout.assign({ monitor(9, -1024, -768, 1024, 768, 96) });
+        CHECK(layout.fromPoint(100, 100) == 0);
+        CHECK(layout.monitors()[0].id == 9);
+    }
+
+} // namespace
+
+int main() {
+    testMixedLayout();
+    testRandomLayouts();
+    testEmpty();
+    return Test::report("monitor_layout_test");
+}
@@ -0,0 +1,202 @@
+#include "foundation/motion_predictor.h"
+#include "test_common.h"
+#include <cmath>
+#include <vector>
+
+using Foundation::MotionPredictor;
+
+namespace {
+
+    // 与图钉跟踪的外推时间相同（Constants::PREDICTION_HORIZON）
+    constexpr double HORIZON = 16.0;
+
+    // 跟踪定时器的采样间隔（毫秒），按拖动时实际的抖动循环，31为漏掉一次
+    const double TICKS[] = { 16, 15, 17, 16, 16, 31, 16, 15, 17, 16, 16, 16 };
+
+    // 拖动轨迹的一段：持续时间内以恒定速度（像素/毫秒）移动
+    struct Segment {
+        double duration;
+        double vx;
+        double vy;
+    };
+
+    struct Sample {
+        double time;
+        MotionPredictor::Point pos;
+    };
+
+    // 由速度分段描述的拖动，按跟踪定时器的节奏采样
+    class Trace {
+    public:
+        Trace(double x, double y, std::vector<Segment> segments)
+            : m_x(x), m_y(y), m_segments(std::move(segments)) {}
+
+        // t时刻窗口的实际位置
+        void position(double t, double& x, double& y) const {
+            x = m_x;
+            y = m_y;
+            for (const Segment& s : m_segments) {
+                double d = t < s.duration ? t : s.duration;
+                x += s.vx * d;
+                y += s.vy * d;
+                t -= d;
+                if (t <= 0) break;
+            }
+        }
+
+        double duration() const {
+            double total = 0;
+            for (const Segment& s : m_segments) total += s.duration;
+            return total;
+        }
+
+        std::vector<Sample> samples() const {
+            std::vector<Sample> result;
+            size_t tick = 0;
+            for (double t = 0; t <= duration(); t += TICKS[tick++ % (sizeof(TICKS) / sizeof(TICKS[0]))]) {
+                double x, y;
+                position(t, x, y);
+                result.push_back({ t, { int(std::lround(x)), int(std::lround(y)) } });
+            }
+            return result;
+        }
+
+    private:
+        double m_x;
+        double m_y;
+        std::vector<Segment> m_segments;
+    };
+
+    double distance(MotionPredictor::Point p, double x, double y) {
+        return std::hypot(p.x - x, p.y - y);
+    }
+
+    double distance(MotionPredictor::Point a, MotionPredictor::Point b) {
+        return std::hypot(double(a.x - b.x), double(a.y - b.y));
+    }
+
+    // 匀速拖动：预热后外推误差明显小于不预测（直接使用当前位置）的误差
+    void testSteadyDrag() {
+        // 主显示器左侧的副显示器上，坐标为负
+        Trace trace(-1800, 200, { { 1000, 1.2, 0.3 } });
+        MotionPredictor predictor;
+        double predictedError = 0, laggingError = 0;
+        int count = 0;
+        std::vector<Sample> samples = trace.samples();
+        for (size_t n = 0; n < samples.size(); ++n) {
+            predictor.addSample(samples[n].time, samples[n].pos);
+            if (n < 5) continue;
+            double x, y;
+            trace.position(samples[n].time + HORIZON, x, y);
+            predictedError += distance(predictor.predict(samples[n].time + HORIZON), x, y);
+            laggingError += distance(samples[n].pos, x, y);
+            ++count;
+        }
+        CHECK(count > 40);
+        CHECK(predictedError < laggingError * 0.1);
+        CHECK(predictedError / count < 2.0);
+        CHECK(predictor.errorSamples() > 0);
+        CHECK(predictor.averageError() < 2.0);
+    }
+
+    // 停止后立即回到实际位置，不再外推
+    void testStop() {
+        Trace trace(400, 300, { { 400, 0.9, -0.6 }, { 300, 0, 0 } });
+        MotionPredictor predictor;
+        std::vector<Sample> samples = trace.samples();
+        bool stopped = false;
+        for (size_t n = 0; n < samples.size(); ++n) {
+            predictor.addSample(samples[n].time, samples[n].pos);
+            if (n > 0 && distance(samples[n].pos, samples[n - 1].pos) == 0) {
+                stopped = true;
+                CHECK(!predictor.isMoving());
+                CHECK(distance(predictor.predict(samples[n].time + HORIZON), samples[n].pos) == 0);
+            }
+        }
+        CHECK(stopped);
+    }
+
+    // 反向拖动：外推距离始终有上限，换向后几个采样内重新跟上
+    void testReversal() {
+        Trace trace(1000, 500, { { 300, 1.5, 0 }, { 300, -1.5, 0 } });
+        MotionPredictor predictor;
+        std::vector<Sample> samples = trace.samples();
+        size_t afterReversal = 0;
+        for (const Sample& s : samples) {
+            predictor.addSample(s.time, s.pos);
+            MotionPredictor::Point predicted = predictor.predict(s.time + HORIZON);
+            CHECK(distance(predicted, s.pos) <= MotionPredictor::MAX_EXTRAPOLATION + 1);
+            if (s.time > 300 && ++afterReversal > 6) {
+                double x, y;
+                trace.position(s.time + HORIZON, x, y);
+                CHECK(distance(predicted, x, y) < 8.0);
+            }
+        }
+        CHECK(afterReversal > 6);
+    }
+
+    // 采样间隔过长视为运动中断
+    void testLongGap() {
+        MotionPredictor predictor;
+        double t = 0;
+        int x = 0;
+        for (; t < 200; t += 16, x += 20) {
+            predictor.addSample(t, { x, 0 });
+        }
+        CHECK(predictor.isMoving());
+        predictor.addSample(t + MotionPredictor::MAX_SAMPLE_GAP + 50, { x + 10, 0 });
+        CHECK(!predictor.isMoving());
+        CHECK(predictor.predict(t + MotionPredictor::MAX_SAMPLE_GAP + 66).x == x + 10);
+    }
+
+    // 快速甩动：外推距离不超过上限
+    void testFling() {
+        Trace trace(-3000, -400, { { 200, 12, -4 } });
+        MotionPredictor predictor;
+        for (const Sample& s : trace.samples()) {
+            predictor.addSample(s.time, s.pos);
+            CHECK(distance(predictor.predict(s.time + HORIZON), s.pos) <= MotionPredictor::MAX_EXTRAPOLATION + 1);
+        }
+        CHECK(predictor.isMoving());
+    }
+
+    // 同一时刻的重复读取（位置相同）不影响速度估计
+    void testDuplicateReads() {
+        Trace trace(0, 0, { { 500, 0.8, 0.8 } });
+        MotionPredictor plain, repeated;
+        for (const Sample& s : trace.samples()) {
+            plain.addSample(s.time, s.pos);
+            repeated.addSample(s.time, s.pos);
+            repeated.addSample(s.time + 1, s.pos);
+            MotionPredictor::Point a = plain.predict(s.time + HORIZON);
+            MotionPredictor::Point b = repeated.predict(s.time + HORIZON);
+            CHECK(a.x == b.x && a.y == b.y);
+        }
+    }
+
+    void testReset() {
+        MotionPredictor predictor;
+        CHECK(!predictor.hasSample());
+        predictor.addSample(0, { 10, 10 });
+        predictor.addSample(16, { 30, 10 });
+        CHECK(predictor.isMoving());
+        predictor.reset();
+        CHECK(!predictor.hasSample());
+        CHECK(!predictor.isMoving());
+        predictor.addSample(32, { 500, 500 });
+        MotionPredictor::Point p = predictor.predict(48);
+        CHECK(p.x == 500 && p.y == 500);
+    }
+
+} // namespace
+
+int main() {
+    testSteadyDrag();
+    testStop();
+    testReversal();
+    testLongGap();
+    testFling();
+    testDuplicateReads();
+    testReset();
+    return Test::report("motion_predictor_test");
+}
@@ -0,0 +1,88 @@
+#include "foundation/ownership_index.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// 所有者链深度为10/100/1000时topParent和ownedWindows的开销，以及事件到来后的更新开销：
+// 逐项更新与原先的整线程重新枚举（此处用assign整线程结果代替，不含EnumThreadWindows
+// 和每个窗口一次GetWindow的系统调用，实际差距更大）比较。
+// 链上窗口i被窗口i-1拥有，全部位于同一线程；事件为链末端反复创建/销毁一个被拥有的窗口。
+
+namespace {
+
+    using Index = Foundation::OwnershipIndex<int, int>;
+    constexpr int THREAD = 1;
+
+    template<typename F>
+    double nanosPer(int iterations, F&& f) {
+        auto start = std::chrono::steady_clock::now();
+        for (int n = 0; n < iterations; ++n) {
+            f(n);
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+    }
+
+    // 与OwnershipGraph::topParent相同地沿所有者链向上
+    int topParent(const Index& index, int wnd) {
+        int owner = 0;
+        while (index.ownerOf(wnd, owner) && owner) {
+            wnd = owner;
+        }
+        return wnd;
+    }
+
+    // 链上的窗口按z-order排列：被拥有的窗口在所有者之上
+    void buildChain(int depth, std::vector<int>& windows, std::vector<int>& owners) {
+        windows.clear();
+        owners.clear();
+        for (int wnd = depth; wnd >= 1; --wnd) {
+            windows.push_back(wnd);
+            owners.push_back(wnd - 1);
+        }
+    }
+
+} // namespace
+
+int main() {
+    std::printf("%6s %14s %16s %18s %18s %16s\n",
+                "depth", "ns/topParent", "ns/ownedWindows", "ns/event (incr)", "ns/event (reenum)", "reenum windows");
+    for (int depth : { 10, 100, 1000 }) {
+        std::vector<int> windows, owners;
+        buildChain(depth, windows, owners);
+        Index index;
+        index.assign(THREAD, windows, owners);
+
+        volatile int sink = 0;
+        int iterations = 2000000 / depth;
+        double walk = nanosPer(iterations, [&](int) { sink = topParent(index, depth); });
+        double owned = nanosPer(iterations, [&](int n) {
+            sink = int(index.ownedWindows(THREAD, 1 + n % depth).size());
+        });
+
+        // 每个事件后有一次查询：逐项更新直接改索引，重新枚举在查询时替换整个线程
+        int extra = depth + 1;
+        double incremental = nanosPer(iterations, [&](int n) {
+            if (n % 2 == 0) {
+                index.insert(THREAD, extra, depth);
+            } else {
+                index.erase(extra);
+            }
+            sink = topParent(index, extra);
+        });
+        std::vector<int> withExtra = windows, withExtraOwners = owners;
+        withExtra.insert(withExtra.begin(), extra);
+        withExtraOwners.insert(withExtraOwners.begin(), depth);
+        double reenumerate = nanosPer(iterations, [&](int n) {
+            if (n % 2 == 0) {
+                index.assign(THREAD, withExtra, withExtraOwners);
+            } else {
+                index.assign(THREAD, windows, owners);
+            }
+            sink = topParent(index, extra);
+        });
+
+        std::printf("%6d %14.1f %16.1f %18.1f %18.1f %16d\n",
+                    depth, walk, owned, incremental, reenumerate, depth + 1);
+    }
+    return 0;
+}
@@ -0,0 +1,274 @@
+#include "foundation/ownership_index.h"
+#include "test_common.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+    // 测试中用整数代替窗口句柄和线程ID，0表示无所有者/桌面
+    using Index = Foundation::OwnershipIndex<int, int>;
+
+    enum EventType { CREATE, DESTROY, PARENTCHANGE };
+
+    struct Event {
+        EventType type;
+        int wnd;
+        int thread;
+    };
+
+    // 模拟的桌面：窗口的线程、父窗口和所有者，以及顶级窗口的z-order，
+    // 每次改变都按系统的方式产生创建/销毁/父窗口改变事件
+    class SimulatedDesktop {
+    public:
+        int createTop(int thread, int owner) {
+            int wnd = newWindow(thread, 0, owner);
+            m_zorder.insert(m_zorder.begin(), wnd);
+            return wnd;
+        }
+
+        int createChild(int thread, int parent) {
+            return newWindow(thread, parent, 0);
+        }
+
+        // 与DestroyWindow相同，先销毁被拥有的窗口和子窗口
+        void destroy(int wnd) {
+            for (int other = 1; other < int(m_windows.size()); ++other) {
+                const Wnd& w = m_windows[other];
+                if (w.alive && (w.owner == wnd || w.parent == wnd)) {
+                    destroy(other);
+                }
+            }
+            Wnd& w = m_windows[wnd];
+            w.alive = false;
+            m_zorder.erase(std::remove(m_zorder.begin(), m_zorder.end(), wnd), m_zorder.end());
+            events.push_back(Event{ DESTROY, wnd, w.thread });
+        }
+
+        // 变为parent的子窗口，parent为0时变为无所有者的顶级窗口（位于z-order顶部）
+        void setParent(int wnd, int parent) {
+            Wnd& w = m_windows[wnd];
+            m_zorder.erase(std::remove(m_zorder.begin(), m_zorder.end(), wnd), m_zorder.end());
+            w.parent = parent;
+            w.owner = 0;
+            if (!parent) {
+                m_zorder.insert(m_zorder.begin(), wnd);
+            }
+            events.push_back(Event{ PARENTCHANGE, wnd, w.thread });
+        }
+
+        bool isWindow(int wnd) const { return wnd > 0 && wnd < int(m_windows.size()) && m_windows[wnd].alive; }
+        bool isTopLevel(int wnd) const { return isWindow(wnd) && m_windows[wnd].parent == 0; }
+        int parent(int wnd) const { return m_windows[wnd].parent; }
+        int owner(int wnd) const { return m_windows[wnd].owner; }
+        int thread(int wnd) const { return m_windows[wnd].thread; }
+        int count() const { return int(m_windows.size()); }
+
+        // 不拥有其他窗口、也没有子窗口的窗口，可以安全地改变父窗口
+        bool isLeaf(int wnd) const {
+            for (const Wnd& w : m_windows) {
+                if (w.alive && (w.owner == wnd || w.parent == wnd)) return false;
+            }
+            return true;
+        }
+
+        // 与EnumThreadWindows相同：线程的顶级窗口，按z-order从上到下
+        std::vector<int> enumerate(int thread) const {
+            std::vector<int> result;
+            for (int wnd : m_zorder) {
+                if (m_windows[wnd].thread == thread) result.push_back(wnd);
+            }
+            return result;
+        }
+
+        // 线程上的owner本身及被owner拥有的顶级窗口
+        std::vector<int> ownedWindows(int thread, int owner) const {
+            std::vector<int> result;
+            for (int wnd : enumerate(thread)) {
+                if (wnd == owner || m_windows[wnd].owner == owner) result.push_back(wnd);
+            }
+            return result;
+        }
+
+        // 与Window::getTopParent相同：子窗口沿父窗口，顶级窗口沿所有者
+        int topParent(int wnd) const {
+            for (;;) {
+                int next = m_windows[wnd].parent ? m_windows[wnd].parent : m_windows[wnd].owner;
+                if (!next) return wnd;
+                wnd = next;
+            }
+        }
+
+        std::vector<Event> events;
+
+    private:
+        struct Wnd {
+            int thread;
+            int parent;
+            int owner;
+            bool alive;
+        };
+
+        int newWindow(int thread, int parent, int owner) {
+            int wnd = int(m_windows.size());
+            m_windows.push_back(Wnd{ thread, parent, owner, true });
+            events.push_back(Event{ CREATE, wnd, thread });
+            return wnd;
+        }
+
+        std::vector<Wnd> m_windows = { Wnd{ 0, 0, 0, false } };   // 0号不使用
+        std::vector<int> m_zorder;
+    };
+
+    // 与OwnershipGraph::applyEvent相同：按处理事件时窗口的实际状态更新索引
+    void applyEvent(Index& index, const SimulatedDesktop& desktop, const Event& event) {
+        if (event.type == DESTROY || !desktop.isTopLevel(event.wnd)) {
+            index.erase(event.wnd);
+            return;
+        }
+        index.insert(event.thread, event.wnd, desktop.owner(event.wnd));
+    }
+
+    // 用索引回答topParent：顶级窗口的所有者来自索引
+    int topParent(const Index& index, const SimulatedDesktop& desktop, int wnd) {
+        for (;;) {
+            int next = desktop.parent(wnd);
+            if (!next && !index.ownerOf(wnd, next)) {
+                next = desktop.owner(wnd);
+            }
+            if (!next) return wnd;
+            wnd = next;
+        }
+    }
+
+    std::vector<int> sorted(std::vector<int> v) {
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+
+    // 全量替换与逐项更新
+    void testBasics() {
+        Index index;
+        index.assign(1, { 10, 11, 12 }, { 0, 10, 10 });
+        index.assign(2, { 20 }, { 10 });
+        CHECK(index.size() == 4);
+        CHECK((index.ownedWindows(1, 10) == std::vector<int>{ 10, 11, 12 }));
+        CHECK((index.ownedWindows(2, 10) == std::vector<int>{ 20 }));
+        CHECK(index.ownedWindows(3, 10).empty());
+
+        int owner = -1, thread = -1;
+        CHECK(index.ownerOf(11, owner) && owner == 10);
+        CHECK(index.threadOf(20, thread) && thread == 2);
+        CHECK(!index.ownerOf(99, owner));
+
+        // 新窗口放在最前面；已有窗口只更新所有者，位置不变
+        index.insert(1, 13, 10);
+        index.insert(1, 12, 0);
+        CHECK((*index.windows(1) == std::vector<int>{ 13, 10, 11, 12 }));
+        CHECK((index.ownedWindows(1, 10) == std::vector<int>{ 13, 10, 11 }));
+
+        CHECK(index.erase(11));
+        CHECK(!index.erase(11));
+        CHECK(index.setOwner(13, 12));
+        CHECK(!index.setOwner(11, 12));
+        CHECK((index.ownedWindows(1, 12) == std::vector<int>{ 13, 12 }));
+
+        // 重新枚举替换线程的全部记录
+        index.assign(1, { 14 }, { 0 });
+        CHECK(!index.contains(10) && !index.contains(13));
+        CHECK(index.contains(20));
+        CHECK(index.size() == 2);
+
+        index.removeThread(1);
+        CHECK(!index.hasThread(1) && index.windows(1) == nullptr);
+        CHECK(index.size() == 1);
+        index.removeThread(1);
+    }
+
+    // 在模拟桌面上随机创建、销毁窗口和改变父窗口，逐个应用事件后索引与重新枚举的结果一致。
+    // delay为真时积攒若干事件再处理，模拟事件异步到达：窗口可能已被销毁或再次改变，
+    // 此时z-order不保证准确（由定期校验纠正），但所有关系必须一致
+    void testSimulatedDesktop(unsigned seed, bool delay) {
+        constexpr int THREADS = 3;
+        std::mt19937 rng(seed);
+        SimulatedDesktop desktop;
+        Index index;
+        for (int t = 1; t <= THREADS; ++t) {
+            index.assign(t, {}, {});
+        }
+
+        auto pick = [&](bool topLevel) {
+            std::vector<int> candidates;
+            for (int wnd = 1; wnd < desktop.count(); ++wnd) {
+                if (topLevel ? desktop.isTopLevel(wnd) : desktop.isWindow(wnd)) candidates.push_back(wnd);
+            }
+            return candidates.empty() ? 0 : candidates[rng() % candidates.size()];
+        };
+
+        int failures = Test::failures();
+        size_t applied = 0;
+        for (int step = 0; step < 3000; ++step) {
+            int thread = 1 + int(rng() % THREADS);
+            switch (rng() % 6) {
+            case 0:
+            case 1:
+                desktop.createTop(thread, rng() % 2 ? pick(true) : 0);
+                break;
+            case 2:
+                if (int parent = pick(false)) desktop.createChild(desktop.thread(parent), parent);
+                break;
+            case 3:
+                if (int wnd = pick(false)) desktop.destroy(wnd);
+                break;
+            case 4:
+            case 5:
+                if (int wnd = pick(false)) {
+                    // 顶级窗口变为子窗口，子窗口变为顶级窗口或换一个父窗口
+                    int parent = desktop.isTopLevel(wnd) || rng() % 2 ? pick(true) : 0;
+                    if (desktop.isLeaf(wnd) && parent != wnd && (parent || !desktop.isTopLevel(wnd))) {
+                        desktop.setParent(wnd, parent);
+                    }
+                }
+                break;
+            }
+
+            if (delay && rng() % 4 != 0) continue;
+            for (; applied < desktop.events.size(); ++applied) {
+                applyEvent(index, desktop, desktop.events[applied]);
+            }
+
+            for (int t = 1; t <= THREADS; ++t) {
+                std::vector<int> expected = desktop.enumerate(t);
+                if (delay) {
+                    CHECK(sorted(*index.windows(t)) == sorted(expected));
+                } else {
+                    CHECK(*index.windows(t) == expected);
+                }
+                for (int owner : expected) {
+                    std::vector<int> owned = index.ownedWindows(t, owner);
+                    std::vector<int> truth = desktop.ownedWindows(t, owner);
+                    CHECK(delay ? sorted(owned) == sorted(truth) : owned == truth);
+                }
+            }
+            for (int wnd = 1; wnd < desktop.count(); ++wnd) {
+                if (desktop.isWindow(wnd)) {
+                    CHECK(topParent(index, desktop, wnd) == desktop.topParent(wnd));
+                }
+            }
+            if (Test::failures() != failures) {
+                std::fprintf(stderr, "seed %u, step %d\n", seed, step);
+                return;
+            }
+        }
+    }
+
+} // namespace
+
+int main() {
+    testBasics();
+    for (unsigned seed = 1; seed <= 5; ++seed) {
+        testSimulatedDesktop(seed, false);
+        testSimulatedDesktop(seed, true);
+    }
+    return Test::report("ownership_index_test");
+}
@@ -0,0 +1,83 @@
+#include "foundation/placement_batch.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// 图钉和绑定窗口的位置请求频率：逐个调用SetWindowPos（合并前）与按帧批量提交（合并后）
+// 模拟10秒：
+// - pins个图钉按20ms的跟踪间隔各请求一次移动，目标窗口静止，只有第一个图钉的目标在前2秒被拖动；
+// - 图钉层级检查（500ms）各请求一次层级调整；
+// - 一组bindings个绑定窗口在第3到第5秒被拖动，位置变化事件约每4ms一次，每次移动整组窗口；
+// - 消息循环空闲时提交，按16ms一帧计。
+
+namespace {
+
+    using Batch = Foundation::PlacementBatch<int>;
+    constexpr int TOPMOST = -1;
+
+    struct Result {
+        size_t requests;    // 合并前的SetWindowPos次数
+        size_t applied;     // 合并后实际应用的窗口项
+        size_t batches;     // 合并后的批量提交次数
+        double nanosPerRequest;
+    };
+
+    Result simulate(int pins, int bindings) {
+        constexpr int DURATION = 10000;
+        Batch batch;
+        Result result = {};
+        bool merged;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < DURATION; ++t) {
+            if (t % 20 == 0) {
+                for (int p = 0; p < pins; ++p) {
+                    int x = 100 + p * 40 + ((p == 0 && t < 2000) ? t / 4 : 0);
+                    batch.requestMove(p, x, 100, merged);
+                    ++result.requests;
+                }
+            }
+            if (t % 500 == 0) {
+                for (int p = 0; p < pins; ++p) {
+                    batch.requestZOrder(p, TOPMOST, merged);
+                    ++result.requests;
+                }
+            }
+            if (t >= 3000 && t < 5000 && t % 4 == 0) {
+                for (int b = 0; b < bindings; ++b) {
+                    batch.requestMove(10000 + b, b * 300 + t / 4, 500, merged);
+                    ++result.requests;
+                }
+            }
+            if (t % 16 == 15 && !batch.empty()) {
+                std::vector<Batch::Request> plan = batch.buildPlan(batch.take());
+                if (!plan.empty()) {
+                    ++result.batches;
+                    result.applied += plan.size();
+                    for (const Batch::Request& req : plan) {
+                        batch.markApplied(req);
+                    }
+                }
+            }
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        result.nanosPerRequest = result.requests ? elapsed / result.requests : 0;
+        return result;
+    }
+
+} // namespace
+
+int main() {
+    std::printf("%6s %9s %18s %18s %18s %12s\n",
+                "pins", "bindings", "SetWindowPos/s", "applied items/s", "batches/s", "ns/request");
+    const int pinCounts[] = { 1, 10, 100 };
+    const int bindingCounts[] = { 0, 5 };
+    for (int pins : pinCounts) {
+        for (int bindings : bindingCounts) {
+            Result r = simulate(pins, bindings);
+            std::printf("%6d %9d %18.1f %18.1f %18.1f %12.1f\n",
+                        pins, bindings, r.requests / 10.0, r.applied / 10.0, r.batches / 10.0, r.nanosPerRequest);
+        }
+    }
+    return 0;
+}
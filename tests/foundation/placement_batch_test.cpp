@@ -0,0 +1,140 @@
+#include "foundation/placement_batch.h"
+#include "test_common.h"
+#include <vector>
+
+namespace {
+
+    // 测试中用整数代替窗口句柄
+    using Batch = Foundation::PlacementBatch<int>;
+    constexpr int TOPMOST = -1;
+    constexpr int NOTOPMOST = -2;
+
+    const Batch::Request* find(const std::vector<Batch::Request>& requests, int wnd) {
+        for (const Batch::Request& req : requests) {
+            if (req.wnd == wnd) return &req;
+        }
+        return nullptr;
+    }
+
+    // 同一帧内同一窗口的请求合并为一项，后到的覆盖先到的，顺序按首次请求
+    void testMerge() {
+        Batch batch;
+        bool merged = true;
+        batch.requestMove(1, 10, 20, merged);
+        CHECK(!merged);
+        batch.requestZOrder(2, TOPMOST, merged);
+        CHECK(!merged);
+        batch.requestMove(1, 11, 21, merged);
+        CHECK(merged);
+        batch.requestZOrder(1, NOTOPMOST, merged);
+        CHECK(merged);
+        batch.requestZOrder(1, TOPMOST, merged);
+        CHECK(merged);
+        CHECK(batch.hasPendingMove(1));
+        CHECK(!batch.hasPendingMove(2));
+
+        std::vector<Batch::Request> pending = batch.take();
+        CHECK(batch.empty());
+        CHECK(!batch.hasPendingMove(1));
+        CHECK(pending.size() == 2);
+        CHECK(pending[0].wnd == 1 && pending[1].wnd == 2);
+        CHECK(pending[0].move && pending[0].x == 11 && pending[0].y == 21);
+        CHECK(pending[0].zorder && pending[0].insertAfter == TOPMOST);
+        CHECK(!pending[1].move && pending[1].zorder);
+
+        // 新的一帧重新开始合并
+        batch.requestMove(1, 0, 0, merged);
+        CHECK(!merged);
+    }
+
+    // 与已应用位置相同的移动被剔除；同时请求了层级的项保留层级部分
+    void testNoOp() {
+        Batch batch;
+        bool merged;
+        batch.requestMove(1, 10, 20, merged);
+        batch.requestMove(2, 30, 40, merged);
+        std::vector<Batch::Request> plan = batch.buildPlan(batch.take());
+        CHECK(plan.size() == 2);
+        for (const Batch::Request& req : plan) {
+            batch.markApplied(req);
+        }
+
+        batch.requestMove(1, 10, 20, merged);
+        batch.requestMove(2, 31, 40, merged);
+        batch.requestMove(3, 10, 20, merged);
+        batch.requestMove(4, 0, 0, merged);
+        batch.requestZOrder(4, TOPMOST, merged);
+        plan = batch.buildPlan(batch.take());
+        CHECK(plan.size() == 3);
+        CHECK(!find(plan, 1));
+        CHECK(find(plan, 2) && find(plan, 2)->x == 31);
+        CHECK(find(plan, 3) && find(plan, 3)->move);
+        for (const Batch::Request& req : plan) {
+            batch.markApplied(req);
+        }
+
+        // 已应用(0,0)之后，同一位置的移动被剔除，层级调整仍然保留
+        batch.requestMove(4, 0, 0, merged);
+        batch.requestZOrder(4, NOTOPMOST, merged);
+        plan = batch.buildPlan(batch.take());
+        CHECK(plan.size() == 1);
+        CHECK(!plan[0].move && plan[0].zorder && plan[0].insertAfter == NOTOPMOST);
+
+        // 只调整层级不影响已应用的位置
+        batch.markApplied(plan[0]);
+        batch.requestMove(4, 0, 0, merged);
+        CHECK(batch.buildPlan(batch.take()).empty());
+    }
+
+    // 应用失败的移动不记录位置，下一次相同的请求不会被当作无变化
+    void testFailedApply() {
+        Batch batch;
+        bool merged;
+        batch.requestMove(1, 5, 5, merged);
+        std::vector<Batch::Request> plan = batch.buildPlan(batch.take());
+        CHECK(plan.size() == 1);
+
+        batch.requestMove(1, 5, 5, merged);
+        plan = batch.buildPlan(batch.take());
+        CHECK(plan.size() == 1);
+        batch.markApplied(plan[0]);
+
+        batch.requestMove(1, 5, 5, merged);
+        CHECK(batch.buildPlan(batch.take()).empty());
+    }
+
+    // forget清空待处理的请求和已应用位置，其他窗口的请求不受影响
+    void testForget() {
+        Batch batch;
+        bool merged;
+        batch.requestMove(1, 1, 1, merged);
+        batch.markApplied(batch.take()[0]);
+
+        batch.requestMove(2, 2, 2, merged);
+        batch.requestMove(3, 3, 3, merged);
+        batch.requestZOrder(2, TOPMOST, merged);
+        batch.forget(2);
+        batch.forget(1);
+        batch.forget(9);
+        CHECK(!batch.hasPendingMove(2));
+        CHECK(batch.hasPendingMove(3));
+
+        batch.requestMove(1, 1, 1, merged);
+        batch.requestMove(3, 4, 4, merged);
+        CHECK(merged);
+        std::vector<Batch::Request> plan = batch.buildPlan(batch.take());
+        CHECK(plan.size() == 2);
+        CHECK(!find(plan, 2));
+        CHECK(find(plan, 1) && find(plan, 1)->move);
+        CHECK(find(plan, 3) && find(plan, 3)->x == 4);
+    }
+
+} // namespace
+
+int main() {
+    testMerge();
+    testNoOp();
+    testFailedApply();
+    testForget();
+    return Test::report("placement_batch_test");
+}
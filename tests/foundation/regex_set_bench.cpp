@@ -0,0 +1,128 @@
+#include "foundation/regex_set.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// 100万个合成窗口标题上，正则规则（一个RegexSet一次扫描）与通配符规则（逐条wildcardMatch）的比较。
+// 每条规则形如*词1*词2*，对应的正则为词1.*词2；标题由随机单词组成，约一成含有规则中的词。
+// 标题按每批65536个生成，生成时间不计入。
+// 每条规则都含有.*时，DFA状态需要记住每条规则的前半部分是否已出现，规则多到上百条时状态数
+// 随标题组合增长，缓存反复清空，匹配退化为逐字符构造状态，此时比逐条通配符还慢（见resets一列）。
+
+namespace {
+
+    // 与StringUtils::wildcardMatch相同（string_utils.cpp依赖Windows的格式化函数，不能在此链接）
+    bool wildcardMatch(const wchar_t* pattern, const wchar_t* str) {
+        if (!pattern || !*pattern)
+            return !str || !*str;
+        if (!str || !*str) {
+            while (*pattern == L'*') pattern++;
+            return !*pattern;
+        }
+        if (*pattern == L'*') {
+            while (*(pattern + 1) == L'*') pattern++;
+            return wildcardMatch(pattern + 1, str) || wildcardMatch(pattern, str + 1);
+        }
+        if (*pattern == L'?' || *pattern == *str)
+            return wildcardMatch(pattern + 1, str + 1);
+        return false;
+    }
+
+    constexpr size_t TITLES = 1 << 20;
+    constexpr size_t BATCH = 1 << 16;
+
+    std::wstring word(std::mt19937& rng) {
+        std::wstring w;
+        for (int n = 3 + int(rng() % 6); n > 0; --n) {
+            w += wchar_t(L'a' + rng() % 26);
+        }
+        return w;
+    }
+
+    struct Rules {
+        std::vector<std::wstring> globs;
+        Foundation::RegexSet regexes;
+        std::vector<std::wstring> words;
+    };
+
+    void makeRules(int count, Rules& rules) {
+        std::mt19937 rng(count);
+        for (int n = 0; n < count; ++n) {
+            std::wstring a = word(rng), b = word(rng);
+            rules.words.push_back(a);
+            rules.words.push_back(b);
+            rules.globs.push_back(L"*" + a + L"*" + b + L"*");
+            rules.regexes.add(a + L".*" + b);
+        }
+    }
+
+    // 4到12个单词，约一成的单词取自规则
+    std::wstring makeTitle(std::mt19937& rng, const Rules& rules) {
+        std::wstring title;
+        for (int n = 4 + int(rng() % 9); n > 0; --n) {
+            if (!title.empty()) title += L' ';
+            title += rng() % 10 == 0 ? rules.words[rng() % rules.words.size()] : word(rng);
+        }
+        return title;
+    }
+
+    double seconds(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+} // namespace
+
+int main() {
+    std::printf("%6s %14s %14s %10s %10s %10s %8s\n",
+                "rules", "glob titles/s", "regex titles/s", "speedup", "matches", "states", "resets");
+    for (int count : { 1, 10, 100 }) {
+        Rules rules;
+        makeRules(count, rules);
+        std::mt19937 rng(1);
+        std::vector<std::wstring> titles(BATCH);
+        std::vector<uint64_t> matched;
+        double globTime = 0, regexTime = 0;
+        size_t globMatches = 0, regexMatches = 0;
+
+        for (size_t done = 0; done < TITLES; done += BATCH) {
+            for (std::wstring& title : titles) {
+                title = makeTitle(rng, rules);
+            }
+
+            // 与AutoPinMatcher相同：通配符规则逐条尝试，正则规则一次扫描后查看各自的位
+            auto start = std::chrono::steady_clock::now();
+            for (const std::wstring& title : titles) {
+                for (const std::wstring& glob : rules.globs) {
+                    if (wildcardMatch(glob.c_str(), title.c_str())) {
+                        ++globMatches;
+                        break;
+                    }
+                }
+            }
+            globTime += seconds(start);
+
+            start = std::chrono::steady_clock::now();
+            for (const std::wstring& title : titles) {
+                rules.regexes.match(title, matched);
+                for (uint64_t word : matched) {
+                    if (word) {
+                        ++regexMatches;
+                        break;
+                    }
+                }
+            }
+            regexTime += seconds(start);
+        }
+
+        if (globMatches != regexMatches) {
+            std::fprintf(stderr, "mismatch: %zu glob vs %zu regex matches\n", globMatches, regexMatches);
+            return 1;
+        }
+        Foundation::RegexSet::Stats stats = rules.regexes.getStats();
+        std::printf("%6d %14.0f %14.0f %9.1fx %10zu %10zu %8zu\n", count, TITLES / globTime, TITLES / regexTime,
+                    globTime / regexTime, regexMatches, stats.states, stats.cacheResets);
+    }
+    return 0;
+}
@@ -0,0 +1,317 @@
+#include "foundation/regex_set.h"
+#include "test_common.h"
+#include <cstdio>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+using Foundation::RegexSet;
+
+namespace {
+
+    // 同一个模式的两种写法：RegexSet的语法，以及语义相同的ECMAScript写法（std::wregex）。
+    // 两者的差别正是regex_set.h中说明的几点：.匹配换行、类开头的]是字面字符、^和$作用于整个模式。
+    struct Pattern {
+        std::wstring ours;
+        std::wstring ecma;
+    };
+
+    class Generator {
+    public:
+        explicit Generator(unsigned seed) : m_rng(seed) {}
+
+        int pick(int n) { return int(m_rng() % unsigned(n)); }
+
+        // 顶层的若干分支，不加括号
+        Pattern alternation(int depth) {
+            Pattern p;
+            int branches = 1 + pick(depth > 0 ? 3 : 2);
+            for (int b = 0; b < branches; ++b) {
+                if (b) {
+                    p.ours += L'|';
+                    p.ecma += L'|';
+                }
+                for (int n = 1 + pick(3); n > 0; --n) {
+                    Pattern a = quantified(depth);
+                    p.ours += a.ours;
+                    p.ecma += a.ecma;
+                }
+            }
+            return p;
+        }
+
+        // 完整的模式：可选的(?i)和首尾锚点
+        Pattern pattern(int depth, bool& icase) {
+            Pattern body = alternation(depth);
+            bool start = pick(3) == 0, end = pick(3) == 0;
+            icase = pick(4) == 0;
+            Pattern p;
+            p.ours = (icase ? L"(?i)" : L"") + std::wstring(start ? L"^" : L"") + body.ours + (end ? L"$" : L"");
+            p.ecma = (start ? L"^" : L"") + (L"(?:" + body.ecma + L")") + (end ? L"$" : L"");
+            return p;
+        }
+
+        // 文本默认很短：std::wregex是回溯实现，嵌套的量词在长文本上是指数时间
+        std::wstring text(int minLength = 0, int maxLength = 7) {
+            static const wchar_t alphabet[] = L"abcAB1 x.]\n";
+            std::wstring t;
+            for (int n = minLength + pick(maxLength - minLength + 1); n > 0; --n) {
+                t += alphabet[pick(int(sizeof(alphabet) / sizeof(alphabet[0])) - 1)];
+            }
+            return t;
+        }
+
+    private:
+        Pattern atom(int depth) {
+            switch (pick(14)) {
+            case 0: case 1: case 2: case 3: {
+                std::wstring c(1, L"abcAB"[pick(5)]);
+                return { c, c };
+            }
+            case 4:
+                return { L".", L"[\\s\\S]" };
+            case 5:
+                return { L"[a-c]", L"[a-c]" };
+            case 6:
+                return { L"[^b]", L"[^b]" };
+            case 7:
+                return { L"[]a]", L"[\\]a]" };
+            case 8:
+                return { L"[^]x]", L"[^\\]x]" };
+            case 9:
+                return { L"\\d", L"\\d" };
+            case 10:
+                return pick(2) ? Pattern{ L"\\w", L"\\w" } : Pattern{ L"\\s", L"\\s" };
+            case 11:
+                return { L"\\.", L"\\." };
+            default:
+                if (depth > 0) {
+                    Pattern inner = alternation(depth - 1);
+                    return { L"(" + inner.ours + L")", L"(?:" + inner.ecma + L")" };
+                }
+                return { L"b", L"b" };
+            }
+        }
+
+        Pattern quantified(int depth) {
+            Pattern a = atom(depth);
+            std::wstring q;
+            switch (pick(10)) {
+            case 0: q = L"*"; break;
+            case 1: q = L"+"; break;
+            case 2: q = L"?"; break;
+            case 3: q = L"*?"; break;
+            case 4: {
+                int m = pick(3);
+                q = L"{" + std::to_wstring(m) + L"," + std::to_wstring(m + pick(3)) + L"}";
+                break;
+            }
+            case 5:
+                q = L"{" + std::to_wstring(pick(3)) + (pick(2) ? L",}" : L"}");
+                break;
+            default:
+                break;
+            }
+            a.ours += q;
+            a.ecma += q;
+            return a;
+        }
+
+        std::mt19937 m_rng;
+    };
+
+    // 与std::wregex的regex_search逐个比较；一部分集合使用很小的内存预算，覆盖缓存清空后继续匹配
+    void testAgainstStdRegex() {
+        Generator gen(49);
+        int mismatches = 0;
+        size_t cacheResets = 0;
+        for (int iteration = 0; iteration < 300; ++iteration) {
+            RegexSet set(iteration % 3 == 0 ? 2000 : RegexSet::DEFAULT_MEMORY_BUDGET);
+            std::vector<Pattern> patterns;
+            std::vector<std::wregex> expected;
+            int count = 1 + gen.pick(100);
+            for (int n = 0; n < count; ++n) {
+                bool icase;
+                Pattern p = gen.pattern(1, icase);
+                std::wstring error;
+                if (!CHECK(set.add(p.ours, &error) == size_t(n))) {
+                    std::fprintf(stderr, "  rejected: %ls (%ls)\n", p.ours.c_str(), error.c_str());
+                    return;
+                }
+                patterns.push_back(p);
+                expected.emplace_back(p.ecma, icase ? std::regex::ECMAScript | std::regex::icase : std::regex::ECMAScript);
+            }
+
+            std::vector<uint64_t> matched;
+            for (int k = 0; k < 20; ++k) {
+                std::wstring text = gen.text();
+                set.match(text, matched);
+                for (int n = 0; n < count; ++n) {
+                    if (RegexSet::isSet(matched, n) != std::regex_search(text, expected[n]) && ++mismatches <= 5) {
+                        std::fprintf(stderr, "  %ls on \"%ls\"\n", patterns[n].ours.c_str(), text.c_str());
+                    }
+                }
+            }
+            cacheResets += set.getStats().cacheResets;
+        }
+        CHECK(mismatches == 0);
+        CHECK(cacheResets > 0);
+    }
+
+    // 窗口标题长度（64-255个字符）的文本配合很小的内存预算，一次匹配中途会多次清空缓存，
+    // 清空前已匹配的模式必须保留。不嵌套分组的模式在长文本上std::wregex也不会指数爆炸
+    void testLongTitles() {
+        Generator gen(64);
+        int mismatches = 0;
+        size_t cacheResets = 0;
+        for (int iteration = 0; iteration < 100; ++iteration) {
+            RegexSet small(1500), large;
+            std::vector<Pattern> patterns;
+            std::vector<std::wregex> expected;
+            int count = 1 + gen.pick(60);
+            for (int n = 0; n < count; ++n) {
+                bool icase;
+                Pattern p = gen.pattern(0, icase);
+                if (!CHECK(small.add(p.ours) == size_t(n) && large.add(p.ours) == size_t(n))) {
+                    return;
+                }
+                patterns.push_back(p);
+                expected.emplace_back(p.ecma, icase ? std::regex::ECMAScript | std::regex::icase : std::regex::ECMAScript);
+            }
+
+            std::vector<uint64_t> matched, reference;
+            for (int k = 0; k < 10; ++k) {
+                std::wstring text = gen.text(64, 255);
+                size_t resets = small.getStats().cacheResets;
+                small.match(text, matched);
+                large.match(text, reference);
+                cacheResets += small.getStats().cacheResets - resets;
+                CHECK(matched == reference);
+                for (int n = 0; n < count; ++n) {
+                    if (RegexSet::isSet(matched, n) != std::regex_search(text, expected[n]) && ++mismatches <= 5) {
+                        std::fprintf(stderr, "  %ls on \"%ls\"\n", patterns[n].ours.c_str(), text.c_str());
+                    }
+                }
+            }
+        }
+        CHECK(mismatches == 0);
+        CHECK(cacheResets > 100);
+
+        // 开头就匹配的模式在之后的缓存清空中保留
+        RegexSet set(1500);
+        set.add(L"^ab");
+        set.add(L"z$");
+        for (int n = 0; n < 40; ++n) {
+            set.add(L"[a-c]{" + std::to_wstring(n % 4 + 1) + L"}" + std::wstring(1, wchar_t(L'd' + n % 20)));
+        }
+        std::wstring text = L"ab";
+        for (int n = 0; n < 250; ++n) {
+            text += L"abcdefghijklmnopqrstuvw"[(n * 7) % 23];
+        }
+        std::vector<uint64_t> m;
+        size_t resets = set.getStats().cacheResets;
+        set.match(text, m);
+        CHECK(set.getStats().cacheResets > resets);
+        CHECK(RegexSet::isSet(m, 0));
+        CHECK(!RegexSet::isSet(m, 1));
+    }
+
+    // regex_set.h中说明的行为
+    void testDocumentedSyntax() {
+        RegexSet set;
+        size_t dot = set.add(L"a.b");
+        size_t bracket = set.add(L"^[]x]+$");
+        size_t negated = set.add(L"^[^]]$");
+        size_t anchored = set.add(L"^ab|cd$");
+        size_t literalEnd = set.add(L"x\\$");
+        CHECK(literalEnd != RegexSet::npos);
+
+        std::vector<uint64_t> m;
+        set.match(L"a\nb", m);
+        CHECK(RegexSet::isSet(m, dot));
+
+        set.match(L"]x]", m);
+        CHECK(RegexSet::isSet(m, bracket));
+        CHECK(!RegexSet::isSet(m, negated));
+        set.match(L"q", m);
+        CHECK(RegexSet::isSet(m, negated));
+
+        // 锚点作用于整个模式：等价于^(?:ab|cd)$
+        set.match(L"cd", m);
+        CHECK(RegexSet::isSet(m, anchored));
+        set.match(L"abx", m);
+        CHECK(!RegexSet::isSet(m, anchored));
+        set.match(L"xcd", m);
+        CHECK(!RegexSet::isSet(m, anchored));
+
+        set.match(L"ax$", m);
+        CHECK(RegexSet::isSet(m, literalEnd));
+    }
+
+    // 语法错误返回npos并给出说明，集合保持不变
+    void testErrors() {
+        const wchar_t* invalid[] = {
+            L"(", L")", L"a)", L"a**", L"[", L"[]", L"\\", L"\\q", L"a^", L"$a",
+            L"(?=a)", L"(?<a>b)", L"a{3,2}", L"a{1001}", L"*", L"+a", L"[z-a]",
+        };
+        RegexSet set;
+        set.add(L"ok");
+        for (const wchar_t* pattern : invalid) {
+            std::wstring error;
+            if (!CHECK(set.add(pattern, &error) == RegexSet::npos)) {
+                std::fprintf(stderr, "  accepted: %ls\n", pattern);
+            }
+            CHECK(!error.empty());
+        }
+        CHECK(set.size() == 1);
+
+        std::vector<uint64_t> m;
+        set.match(L"look", m);
+        CHECK(RegexSet::isSet(m, 0));
+    }
+
+    // 分组嵌套深度有上限，过深的模式不会耗尽栈
+    void testNesting() {
+        for (int depth : { 1, 64, 65, 200000 }) {
+            RegexSet set;
+            std::wstring pattern = std::wstring(depth, L'(') + L"a" + std::wstring(depth, L')');
+            std::wstring error;
+            size_t index = set.add(pattern, &error);
+            if (depth <= 64) {
+                CHECK(index == 0);
+                std::vector<uint64_t> m;
+                set.match(L"xa", m);
+                CHECK(RegexSet::isSet(m, 0));
+            } else {
+                CHECK(index == RegexSet::npos);
+                CHECK(!error.empty());
+            }
+        }
+    }
+
+    // 会让回溯引擎指数爆炸的模式，匹配时间与文本长度成线性关系
+    void testNoBacktracking() {
+        RegexSet set;
+        set.add(L"(x+x+)+y");
+        set.add(L"^(a|aa)*$");
+        std::vector<uint64_t> m;
+        set.match(std::wstring(100000, L'x'), m);
+        CHECK(!RegexSet::isSet(m, 0));
+        set.match(std::wstring(100000, L'a') + L"b", m);
+        CHECK(!RegexSet::isSet(m, 1));
+        set.match(std::wstring(100000, L'a'), m);
+        CHECK(RegexSet::isSet(m, 1));
+    }
+
+} // namespace
+
+int main() {
+    testAgainstStdRegex();
+    testLongTitles();
+    testDocumentedSyntax();
+    testErrors();
+    testNesting();
+    testNoBacktracking();
+    return Test::report("regex_set_test");
+}
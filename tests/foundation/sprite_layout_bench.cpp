@@ -0,0 +1,183 @@
+#include "foundation/sprite_layout.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Foundation;
+
+// 10/100个图钉时图钉覆盖层（PinOverlay）与每个图钉一个分层窗口的内存和每次跟踪的开销。
+// 按PinOverlay::commit/redraw的流程使用程序中的SpriteGrid、SpriteBoundsRule和像素合成：
+// 3840x2160显示器，32x32的图钉图像，分散（整个屏幕）或集中（屏幕左半部分）的随机布局。
+// 每次跟踪有1个或全部图钉各移动4像素，移动前后的矩形加入待提交区域（DirtyRegion），
+// 逐个区域重绘并各提交一次；位图不再包含所有图钉时按规则重新分配并整体重绘。
+// 作为对比，union列为把所有变化合并为一个外接矩形（之前的做法）时的开销。
+// 图钉窗口方式的位图为每个窗口自己的32x32表面（由DWM合成），每次跟踪每个移动的图钉一次SetWindowPos；
+// 其像素由系统绘制，这里不计时。
+
+namespace {
+
+    struct Rect {
+        long left, top, right, bottom;
+    };
+
+    constexpr int PIN = 32;
+    constexpr Rect AREA = { 0, 0, 3840, 2160 };
+    constexpr int GRID_CELL = 64;
+    constexpr SpriteBoundsRule RULE = { 2 * GRID_CELL, 8, 4 };
+    constexpr int TICKS = 200;
+
+    struct Overlay {
+        std::vector<Rect> pins;
+        std::vector<uint32_t> image = std::vector<uint32_t>(PIN * PIN, 0xFF3060C0u);
+        SpriteGrid<int, Rect> grid;
+        std::vector<uint32_t> bits;
+        Rect bounds{};
+        bool allocated = false;
+        DirtyRegion<Rect> dirty;
+        // 统计
+        long reallocs = 0;
+        long long uploadedPixels = 0;   // 重绘并提交的像素
+        long uploads = 0;               // UpdateLayeredWindowIndirect调用次数
+
+        Overlay(const std::vector<Rect>& layout, size_t maxRects) : pins(layout), dirty(maxRects) {
+            grid.reset(AREA, GRID_CELL);
+            for (int n = 0; n < int(pins.size()); ++n) {
+                grid.insert(n, pins[n]);
+                dirty.add(pins[n]);
+            }
+            redraw();
+        }
+
+        // PinOverlay::fitSurface
+        bool fit() {
+            Rect needed{};
+            for (const Rect& rc : pins) {
+                needed = unionRect(needed, rc);
+            }
+            intersectRect(needed, needed, AREA);
+            Rect target;
+            if (!RULE.fit(needed, AREA, allocated ? &bounds : nullptr, target)) {
+                return false;
+            }
+            bits.assign(size_t(rectArea(target)), 0u);
+            bounds = target;
+            dirty.clear();
+            dirty.add(target);
+            if (allocated) ++reallocs;
+            allocated = true;
+            return true;
+        }
+
+        // PinOverlay::redraw
+        void redraw() {
+            fit();
+            std::vector<int> found;
+            for (Rect piece : dirty.rects()) {
+                if (!intersectRect(piece, piece, bounds)) continue;
+                clearPixels(bits.data(), bounds, piece);
+                grid.query(piece, found);
+                for (int n : found) {
+                    Rect clip;
+                    if (intersectRect(clip, pins[n], piece)) {
+                        blendPixels(bits.data(), bounds, image.data(), pins[n], clip);
+                    }
+                }
+                uploadedPixels += rectArea(piece);
+                ++uploads;
+            }
+            dirty.clear();
+        }
+
+        void move(const std::vector<int>& moved, long dx) {
+            for (int n : moved) {
+                Rect rc = pins[n];
+                rc.left += dx;
+                rc.right += dx;
+                if (rc.left < AREA.left || rc.right > AREA.right) continue;
+                grid.remove(n, pins[n]);
+                dirty.add(pins[n]);
+                pins[n] = rc;
+                grid.insert(n, rc);
+                dirty.add(rc);
+            }
+            redraw();
+        }
+    };
+
+    std::vector<Rect> layout(int count, long width, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector<Rect> pins;
+        for (int n = 0; n < count; ++n) {
+            long x = long(rng() % (width - PIN - 400)) + 200;
+            long y = long(rng() % (AREA.bottom - PIN));
+            pins.push_back({ x, y, x + PIN, y + PIN });
+        }
+        return pins;
+    }
+
+    struct Result {
+        double bitmapMiB;
+        double windowsMiB;
+        double nanosPerTick;
+        double uploadedPerTick;
+        double uploadsPerTick;
+        double reallocs;
+    };
+
+    // maxRects为1时所有变化合并为一个外接矩形
+    Result run(int count, long width, bool all, size_t maxRects) {
+        constexpr int LAYOUTS = 5;
+        Result r = {};
+        for (unsigned seed = 1; seed <= LAYOUTS; ++seed) {
+            Overlay overlay(layout(count, width, seed), maxRects);
+            r.bitmapMiB += rectArea(overlay.bounds) * 4.0 / (1 << 20);
+            overlay.uploadedPixels = 0;
+            overlay.uploads = 0;
+
+            std::vector<int> moved;
+            for (int n = 0; n < (all ? count : 1); ++n) {
+                moved.push_back(n);
+            }
+            auto start = std::chrono::steady_clock::now();
+            for (int tick = 0; tick < TICKS; ++tick) {
+                // 来回移动，保持在原来的范围附近
+                overlay.move(moved, (tick / 25) % 2 ? -4 : 4);
+            }
+            r.nanosPerTick += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / TICKS;
+            r.uploadedPerTick += double(overlay.uploadedPixels) / TICKS;
+            r.uploadsPerTick += double(overlay.uploads) / TICKS;
+            r.reallocs += overlay.reallocs;
+        }
+        r.bitmapMiB /= LAYOUTS;
+        r.windowsMiB = count * PIN * PIN * 4.0 / (1 << 20);
+        r.nanosPerTick /= LAYOUTS;
+        r.uploadedPerTick /= LAYOUTS;
+        r.uploadsPerTick /= LAYOUTS;
+        r.reallocs /= LAYOUTS;
+        return r;
+    }
+
+} // namespace
+
+int main() {
+    std::printf("%5s %10s %6s %12s %12s %10s %10s %8s %9s %12s %12s\n", "pins", "layout", "moving",
+                "overlay MiB", "windows MiB", "ns/tick", "px/tick", "uploads", "reallocs", "union ns", "union px");
+    for (int count : { 10, 100 }) {
+        for (bool clustered : { false, true }) {
+            for (bool all : { false, true }) {
+                long width = clustered ? AREA.right / 2 : AREA.right;
+                Result r = run(count, width, all, 64);
+                Result u = run(count, width, all, 1);
+                std::printf("%5d %10s %6d %12.2f %12.2f %10.0f %10.0f %8.1f %9.1f %12.0f %12.0f\n", count,
+                            clustered ? "clustered" : "scattered", all ? count : 1,
+                            r.bitmapMiB, r.windowsMiB, r.nanosPerTick, r.uploadedPerTick, r.uploadsPerTick, r.reallocs,
+                            u.nanosPerTick, u.uploadedPerTick);
+            }
+        }
+    }
+    std::printf("(overlay: 1 window, uploads = UpdateLayeredWindowIndirect calls per tick;\n"
+                " windows: 1 layered window per pin and 1 SetWindowPos per moving pin; reallocs per %d ticks)\n", TICKS);
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include "foundation/sprite_layout.h"
+#include "test_common.h"
+#include <cstdint>
+#include <vector>
+
+using namespace Foundation;
+
+namespace {
+
+    struct Rect {
+        long left, top, right, bottom;
+    };
+
+    bool equal(const Rect& a, const Rect& b) {
+        return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+    }
+
+    void testRect() {
+        Rect out;
+        CHECK(intersectRect(out, Rect{ 0, 0, 10, 10 }, Rect{ 5, -5, 20, 5 }));
+        CHECK(equal(out, Rect{ 5, 0, 10, 5 }));
+        CHECK(!intersectRect(out, Rect{ 0, 0, 10, 10 }, Rect{ 10, 0, 20, 10 }));
+        CHECK(rectEmpty(out) && rectArea(out) == 0);
+        CHECK(rectArea(Rect{ -2, -3, 2, 3 }) == 24);
+    }
+
+    // 网格只索引与区域相交的部分，区域外（包括右边和下边之外）的部分不产生单元格
+    void testGrid() {
+        SpriteGrid<int, Rect> grid;
+        grid.reset(Rect{ 1000, 0, 1640, 480 }, 64);
+
+        grid.insert(1, Rect{ 1000, 0, 1032, 32 });
+        CHECK(grid.cellCount() == 1);
+        grid.insert(2, Rect{ 1050, 50, 1082, 82 });       // 跨4个单元格
+        CHECK(grid.cellCount() == 4);
+        grid.insert(3, Rect{ 1620, 470, 1652, 502 });     // 超出右下角
+        CHECK(grid.cellCount() == 5);
+        grid.insert(4, Rect{ 1700, 100, 1732, 132 });     // 完全在区域外
+        grid.insert(5, Rect{ 960, -40, 992, -8 });
+        CHECK(grid.cellCount() == 5);
+
+        std::vector<int> found;
+        grid.query(Rect{ 1000, 0, 1640, 480 }, found);
+        CHECK(found == (std::vector<int>{ 1, 2, 3 }));
+        grid.query(Rect{ 1060, 60, 1070, 70 }, found);
+        CHECK(found == (std::vector<int>{ 1, 2 }));
+        grid.query(Rect{ 0, 0, 100, 100 }, found);
+        CHECK(found.empty());
+
+        const std::vector<int>* cell = grid.at(1639L, 479L);
+        CHECK(cell && cell->size() == 1 && (*cell)[0] == 3);
+        CHECK(!grid.at(1640L, 479L) && !grid.at(999L, 0L) && !grid.at(1300L, 300L));
+
+        grid.remove(2, Rect{ 1050, 50, 1082, 82 });
+        CHECK(grid.cellCount() == 2);
+        grid.remove(3, Rect{ 1620, 470, 1652, 502 });
+        grid.remove(1, Rect{ 1000, 0, 1032, 32 });
+        CHECK(grid.cellCount() == 0);
+    }
+
+    // 位图范围：外接矩形加余量并限制在区域内；仍包含外接矩形且没有大出太多时保留
+    void testBoundsRule() {
+        const SpriteBoundsRule rule = { 128, 8, 4 };
+        const Rect area = { 0, 0, 3840, 2160 };
+        Rect target;
+
+        CHECK(rule.fit(Rect{ 100, 100, 132, 132 }, area, static_cast<const Rect*>(nullptr), target));
+        CHECK(equal(target, Rect{ 0, 0, 132 + 480, 132 + 270 }));
+
+        Rect current = target;
+        CHECK(!rule.fit(Rect{ 300, 200, 332, 232 }, area, &current, target));
+        CHECK(rule.fit(Rect{ 600, 200, 632, 232 }, area, &current, target));
+        CHECK(equal(target, Rect{ 120, 0, 632 + 480, 232 + 270 }));
+
+        // 余量不小于minMargin
+        const Rect small = { 0, 0, 640, 480 };
+        CHECK(rule.fit(Rect{ 300, 200, 332, 232 }, small, static_cast<const Rect*>(nullptr), target));
+        CHECK(equal(target, Rect{ 172, 72, 460, 360 }));
+
+        // 整个显示器大小的位图在只剩一个图钉时缩小
+        CHECK(rule.fit(Rect{ 100, 100, 132, 132 }, area, &area, target));
+        current = Rect{ 0, 0, 1200, 800 };
+        CHECK(!rule.fit(Rect{ 100, 100, 132, 132 }, area, &current, target));
+    }
+
+    // 相交的矩形合并，数量达到上限时并入使面积增加最少的矩形，结果始终互不相交
+    void testDirtyRegion() {
+        DirtyRegion<Rect> region(3);
+        region.add(Rect{ 0, 0, 0, 10 });
+        CHECK(region.empty());
+        region.add(Rect{ 0, 0, 10, 10 });
+        region.add(Rect{ 100, 0, 110, 10 });
+        region.add(Rect{ 5, 5, 15, 15 });
+        CHECK(region.rects().size() == 2);
+        CHECK(equal(region.rects()[1], Rect{ 0, 0, 15, 15 }));
+
+        // 合并后与另一个矩形相交，继续合并
+        region.add(Rect{ 12, 0, 102, 4 });
+        CHECK(region.rects().size() == 1);
+        CHECK(equal(region.rects()[0], Rect{ 0, 0, 110, 15 }));
+
+        region.clear();
+        region.add(Rect{ 0, 0, 10, 10 });
+        region.add(Rect{ 100, 0, 110, 10 });
+        region.add(Rect{ 0, 100, 10, 110 });
+        region.add(Rect{ 120, 0, 130, 10 });
+        CHECK(region.rects().size() == 3);
+        CHECK(equal(region.rects()[2], Rect{ 100, 0, 130, 10 }));
+
+        Rect overlap;
+        for (size_t i = 0; i < region.rects().size(); ++i) {
+            for (size_t j = i + 1; j < region.rects().size(); ++j) {
+                CHECK(!intersectRect(overlap, region.rects()[i], region.rects()[j]));
+            }
+        }
+    }
+
+    void testPixels() {
+        CHECK(blendOver(0x80402010u, 0xFF000000u) == 0xFF000000u);
+        CHECK(blendOver(0x80402010u, 0x00000000u) == 0x80402010u);
+        // 半透明白色盖在不透明黑色上
+        CHECK(blendOver(0xFF000000u, 0x80808080u) == 0xFF808080u);
+
+        const Rect bounds = { 10, 20, 14, 23 };     // 4x3位图
+        std::vector<uint32_t> bits(12, 0xFF000000u);
+        const uint32_t image[4] = { 0xFFFFFFFFu, 0u, 0x80808080u, 0xFF0000FFu };
+        const Rect sprite = { 12, 21, 14, 23 };     // 2x2图像位于右下
+        blendPixels(bits.data(), bounds, image, sprite, Rect{ 12, 21, 14, 22 });
+        CHECK(bits[6] == 0xFFFFFFFFu && bits[7] == 0xFF000000u);
+        CHECK(bits[10] == 0xFF000000u && bits[11] == 0xFF000000u);
+
+        blendPixels(bits.data(), bounds, image, sprite, Rect{ 12, 22, 14, 23 });
+        CHECK(bits[10] == 0xFF808080u && bits[11] == 0xFF0000FFu);
+
+        clearPixels(bits.data(), bounds, Rect{ 11, 21, 13, 23 });
+        CHECK(bits[5] == 0 && bits[6] == 0 && bits[9] == 0 && bits[10] == 0);
+        CHECK(bits[4] == 0xFF000000u && bits[7] == 0xFF000000u && bits[11] == 0xFF0000FFu);
+    }
+
+} // namespace
+
+int main() {
+    testRect();
+    testGrid();
+    testBoundsRule();
+    testDirtyRegion();
+    testPixels();
+    return Test::report("sprite_layout_test");
+}
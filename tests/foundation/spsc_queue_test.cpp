@@ -0,0 +1,108 @@
+#include "foundation/spsc_queue.h"
+#include "test_common.h"
+#include <cstdint>
+#include <thread>
+
+using Foundation::SpscQueue;
+
+namespace {
+
+    // 空队列和满队列：满时push失败且不覆盖已有元素，空时pop失败且不改动输出
+    void testFullAndEmpty() {
+        SpscQueue<int, 8> queue;
+        int value = -1;
+        CHECK(queue.size() == 0);
+        CHECK(!queue.pop(value));
+        CHECK(value == -1);
+
+        for (int n = 0; n < 8; ++n) {
+            CHECK(queue.push(n));
+        }
+        CHECK(queue.size() == 8);
+        CHECK(!queue.push(100));
+        CHECK(queue.size() == 8);
+
+        for (int n = 0; n < 8; ++n) {
+            CHECK(queue.pop(value));
+            CHECK(value == n);
+        }
+        CHECK(queue.size() == 0);
+        CHECK(!queue.pop(value));
+        CHECK(value == 7);
+    }
+
+    // 下标多次越过容量回绕，元素保持先进先出，满和空的判断在回绕后仍然正确
+    void testWrapAround() {
+        SpscQueue<int, 4> queue;
+        int next = 0, expected = 0, value = 0;
+        for (int round = 0; round < 1000; ++round) {
+            // 每轮写入和读取的数量不同，使读写位置在环中错开
+            int writes = 1 + round % 4;
+            for (int n = 0; n < writes; ++n) {
+                if (queue.push(next)) {
+                    ++next;
+                } else {
+                    CHECK(queue.size() == 4);
+                }
+            }
+            int reads = 1 + (round * 7) % 4;
+            for (int n = 0; n < reads && queue.pop(value); ++n) {
+                CHECK(value == expected);
+                ++expected;
+            }
+            CHECK(queue.size() == size_t(next - expected));
+        }
+        while (queue.pop(value)) {
+            CHECK(value == expected);
+            ++expected;
+        }
+        CHECK(expected == next);
+        CHECK(next > 1000);
+    }
+
+    // 两个线程同时读写：消费者按顺序收到生产者写入的全部元素，且元素内容完整
+    void testProducerConsumer() {
+        struct Item {
+            uint64_t sequence;
+            uint64_t check;
+        };
+        constexpr uint64_t COUNT = 2000000;
+        SpscQueue<Item, 64> queue;
+
+        std::thread producer([&queue]() {
+            for (uint64_t n = 0; n < COUNT; ) {
+                if (queue.push({ n, ~n })) {
+                    ++n;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        uint64_t expected = 0;
+        size_t errors = 0;
+        Item item;
+        while (expected < COUNT) {
+            if (queue.pop(item)) {
+                if (item.sequence != expected || item.check != ~expected) {
+                    ++errors;
+                }
+                ++expected;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+
+        CHECK(errors == 0);
+        CHECK(!queue.pop(item));
+    }
+
+} // namespace
+
+int main() {
+    testFullAndEmpty();
+    testWrapAround();
+    testProducerConsumer();
+    return Test::report("spsc_queue_test");
+}
@@ -0,0 +1,86 @@
+#include "foundation/stats_reporter.h"
+#include "test_common.h"
+#include <cstddef>
+#include <cstdint>
+
+using Foundation::StatsReporter;
+
+namespace {
+
+    constexpr uint32_t INTERVAL = Constants::STATS_REPORT_INTERVAL;
+
+    struct Stats {
+        size_t events;
+    };
+
+    // 第一次调用只记录时间，之后每个间隔输出一次与上次输出之间的增量
+    void testInterval() {
+        StatsReporter<Stats> reporter;
+        int reports = 0;
+        size_t delta = 0;
+        uint32_t elapsed = 0;
+        auto format = [&](const Stats& stats, const Stats& reported, uint32_t ms) {
+            ++reports;
+            delta = stats.events - reported.events;
+            elapsed = ms;
+            return true;
+        };
+
+        reporter.update(1000, { 5 }, format);
+        CHECK(reports == 0);
+        reporter.update(1000 + INTERVAL - 1, { 7 }, format);
+        CHECK(reports == 0);
+        reporter.update(1000 + INTERVAL + 50, { 9 }, format);
+        CHECK(reports == 1 && delta == 9 && elapsed == INTERVAL + 50);
+        reporter.update(1000 + 2 * INTERVAL, { 12 }, format);
+        CHECK(reports == 1);
+        reporter.update(1050 + 2 * INTERVAL, { 12 }, format);
+        CHECK(reports == 2 && delta == 3 && elapsed == INTERVAL);
+    }
+
+    // format返回false时保留快照和时间，下次调用再试
+    void testDeferred() {
+        StatsReporter<Stats> reporter;
+        int reports = 0;
+        size_t delta = 0;
+        auto format = [&](const Stats& stats, const Stats& reported, uint32_t) {
+            if (stats.events == reported.events) return false;
+            ++reports;
+            delta = stats.events - reported.events;
+            return true;
+        };
+
+        reporter.update(1, { 0 }, format);
+        reporter.update(1 + INTERVAL, { 0 }, format);
+        CHECK(reports == 0);
+        reporter.update(2 + INTERVAL, { 4 }, format);
+        CHECK(reports == 1 && delta == 4);
+    }
+
+    // tick计数回绕时间隔仍正确；64位tick
+    void testTicks() {
+        StatsReporter<Stats> reporter;
+        int reports = 0;
+        auto format = [&](const Stats&, const Stats&, uint32_t) { ++reports; return true; };
+        reporter.update(0xFFFFFF00u, { 0 }, format);
+        reporter.update(INTERVAL - 0x200u, { 0 }, format);
+        CHECK(reports == 0);
+        reporter.update(INTERVAL, { 0 }, format);
+        CHECK(reports == 1);
+
+        StatsReporter<Stats, uint64_t> reporter64;
+        reports = 0;
+        auto format64 = [&](const Stats&, const Stats&, uint64_t) { ++reports; return true; };
+        reporter64.update(0x100000000ull, { 0 }, format64);
+        reporter64.update(0x100000000ull + INTERVAL, { 0 }, format64);
+        CHECK(reports == 1);
+    }
+
+} // namespace
+
+int main() {
+    testInterval();
+    testDeferred();
+    testTicks();
+    return Test::report("stats_reporter_test");
+}
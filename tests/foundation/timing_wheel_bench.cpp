@@ -0,0 +1,77 @@
+#include "foundation/timing_wheel.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// 1/10/100/1000个图钉的跟踪调度：一个共用定时器加时间轮，与每个图钉各自一个定时器比较唤醒次数，
+// 并测量时间轮本身的开销。模拟60秒，刻度10ms（与TrackScheduler相同）：
+// 约一成图钉的目标在移动，按20ms跟踪；其余静止，按250ms跟踪；每秒有一成图钉在两种间隔之间切换。
+// 定时器按nextDeadline唤醒，不模拟系统时钟精度造成的延迟。
+
+namespace {
+
+    constexpr uint64_t ACTIVE_INTERVAL = 2;     // 20ms
+    constexpr uint64_t IDLE_INTERVAL = 25;      // 250ms
+    constexpr uint64_t DURATION = 6000;         // 60秒
+
+    struct Result {
+        double wakeups;         // 共用定时器每秒唤醒次数
+        double perPinTimers;    // 每个图钉一个定时器时每秒的唤醒次数
+        double dispatched;      // 每秒跟踪次数
+        double nanosPerWakeup;
+        double nanosPerDispatch;
+    };
+
+    Result simulate(int pins) {
+        std::mt19937 rng(static_cast<unsigned>(pins));
+        Foundation::TimingWheel wheel;
+        std::vector<unsigned> ids(pins);
+        std::vector<bool> active(pins);
+        for (int p = 0; p < pins; ++p) {
+            active[p] = rng() % 10 == 0;
+            ids[p] = wheel.add(active[p] ? ACTIVE_INTERVAL : IDLE_INTERVAL, 0);
+        }
+
+        size_t wakeups = 0, dispatched = 0;
+        double perPinTimers = 0;
+        uint64_t now = 0, nextSwitch = 100, lastSwitch = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (now < DURATION) {
+            now = wheel.nextDeadline();
+            if (now >= nextSwitch) {
+                // 切换前的这段时间内每个图钉各自的定时器触发次数
+                for (int p = 0; p < pins; ++p) {
+                    perPinTimers += double(nextSwitch - lastSwitch) / (active[p] ? ACTIVE_INTERVAL : IDLE_INTERVAL);
+                }
+                for (int n = 0; n < (pins + 9) / 10; ++n) {
+                    int p = int(rng() % unsigned(pins));
+                    active[p] = !active[p];
+                    wheel.reschedule(ids[p], active[p] ? ACTIVE_INTERVAL : IDLE_INTERVAL, nextSwitch);
+                }
+                lastSwitch = nextSwitch;
+                nextSwitch += 100;
+                continue;
+            }
+            ++wakeups;
+            dispatched += wheel.dispatch(now, [](unsigned) {});
+        }
+        double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        double seconds = DURATION / 100.0;
+        return { wakeups / seconds, perPinTimers / seconds, dispatched / seconds,
+                 wakeups ? elapsed / wakeups : 0, dispatched ? elapsed / dispatched : 0 };
+    }
+
+} // namespace
+
+int main() {
+    std::printf("%6s %12s %16s %12s %12s %14s\n",
+                "pins", "wakeups/s", "per-pin timers/s", "tracks/s", "ns/wakeup", "ns/track");
+    for (int pins : { 1, 10, 100, 1000 }) {
+        Result r = simulate(pins);
+        std::printf("%6d %12.1f %16.1f %12.1f %12.1f %14.1f\n",
+                    pins, r.wakeups, r.perPinTimers, r.dispatched, r.nanosPerWakeup, r.nanosPerDispatch);
+    }
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include "foundation/timing_wheel.h"
+#include "test_common.h"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+using Foundation::TimingWheel;
+
+namespace {
+
+    // 逐个比较的参考实现：每项保存下次到期刻度，到期时从当前刻度重新计时
+    class Reference {
+    public:
+        void set(unsigned id, uint64_t interval, uint64_t now) { m_items[id] = { interval, now + interval }; }
+        void remove(unsigned id) { m_items.erase(id); }
+
+        std::vector<unsigned> dispatch(uint64_t now) {
+            std::vector<unsigned> due;
+            for (auto& item : m_items) {
+                if (item.second.deadline <= now) {
+                    due.push_back(item.first);
+                    item.second.deadline = now + item.second.interval;
+                }
+            }
+            return due;
+        }
+
+        uint64_t nextDeadline() const {
+            uint64_t next = 0;
+            for (const auto& item : m_items) {
+                if (!next || item.second.deadline < next) next = item.second.deadline;
+            }
+            return next;
+        }
+
+        size_t size() const { return m_items.size(); }
+
+    private:
+        struct Item {
+            uint64_t interval;
+            uint64_t deadline;
+        };
+        std::map<unsigned, Item> m_items;
+    };
+
+    std::vector<unsigned> dispatchSorted(TimingWheel& wheel, uint64_t now) {
+        std::vector<unsigned> due;
+        wheel.dispatch(now, [&due](unsigned id) { due.push_back(id); });
+        std::sort(due.begin(), due.end());
+        return due;
+    }
+
+    // 跨越第一级、第二级以及超出第二级范围的间隔，到期刻度准确；
+    // 只在nextDeadline返回的刻度推进（与定时器的用法相同）时结果也一样
+    void testCascade() {
+        const uint64_t intervals[] = { 1, 3, 63, 64, 65, 100, 4095, 4096, 5000, 9000 };
+        for (bool jump : { false, true }) {
+            TimingWheel wheel;
+            std::vector<unsigned> ids;
+            for (uint64_t interval : intervals) {
+                ids.push_back(wheel.add(interval, 1000));
+            }
+
+            std::vector<std::vector<uint64_t>> fired(ids.size());
+            uint64_t now = 1000;
+            while (now < 1000 + 20000) {
+                uint64_t next = wheel.nextDeadline();
+                CHECK(next > now);
+                now = jump ? next : now + 1;
+                wheel.dispatch(now, [&](unsigned id) { fired[id].push_back(now); });
+            }
+
+            int mismatches = 0;
+            for (size_t i = 0; i < ids.size(); ++i) {
+                for (size_t k = 0; k < fired[ids[i]].size(); ++k) {
+                    if (fired[ids[i]][k] != 1000 + (k + 1) * intervals[i]) ++mismatches;
+                }
+                CHECK(fired[ids[i]].size() == 20000 / intervals[i]);
+            }
+            CHECK(mismatches == 0);
+        }
+    }
+
+    // 重新调度从当前刻度按新间隔计时，旧的到期记录不再触发；移除后编号被复用
+    void testReschedule() {
+        TimingWheel wheel;
+        unsigned a = wheel.add(10, 0);
+        unsigned b = wheel.add(200, 0);
+        CHECK(wheel.size() == 2);
+
+        CHECK(dispatchSorted(wheel, 5).empty());
+        wheel.reschedule(a, 30, 5);
+        wheel.reschedule(b, 3, 5);
+        CHECK(wheel.nextDeadline() == 8);
+        CHECK(dispatchSorted(wheel, 8) == std::vector<unsigned>{ b });
+        CHECK(dispatchSorted(wheel, 10).empty());
+        CHECK(dispatchSorted(wheel, 34).size() == 1);
+        CHECK(dispatchSorted(wheel, 35) == std::vector<unsigned>{ a });
+
+        wheel.remove(b);
+        CHECK(!wheel.contains(b));
+        CHECK(wheel.size() == 1);
+        unsigned c = wheel.add(100, 35);
+        CHECK(c == b);
+        // b原来的记录（38、41……）不会以c的身份触发
+        CHECK(dispatchSorted(wheel, 65) == std::vector<unsigned>{ a });
+        CHECK(dispatchSorted(wheel, 135) == (std::vector<unsigned>{ a, c }));
+
+        // 对不存在的编号调用不产生影响
+        wheel.remove(99);
+        wheel.reschedule(99, 1, 135);
+        CHECK(wheel.size() == 2);
+    }
+
+    // 处理函数中移除、重新调度和添加项：同一批到期但尚未调用的项不再调用，新项按自己的时刻到期
+    void testChangesWhileDispatching() {
+        TimingWheel wheel;
+        unsigned first = wheel.add(10, 0);
+        unsigned removed = wheel.add(10, 0);
+        unsigned moved = wheel.add(10, 0);
+        unsigned self = wheel.add(10, 0);
+        unsigned added = ~0u;
+
+        std::vector<unsigned> calls;
+        size_t dispatched = wheel.dispatch(10, [&](unsigned id) {
+            calls.push_back(id);
+            if (id == first) {
+                added = wheel.add(1, 10);
+                wheel.remove(removed);
+                wheel.reschedule(moved, 5, 10);
+            } else if (id == self) {
+                wheel.remove(self);
+            }
+        });
+        CHECK(dispatched == 2);
+        CHECK(calls == (std::vector<unsigned>{ first, self }));
+        CHECK(wheel.size() == 3);
+        CHECK(wheel.contains(added) && !wheel.contains(self) && !wheel.contains(removed));
+
+        CHECK(dispatchSorted(wheel, 11) == std::vector<unsigned>{ added });
+        std::vector<unsigned> expected = { moved, added };
+        std::sort(expected.begin(), expected.end());
+        CHECK(dispatchSorted(wheel, 15) == expected);
+        expected = { first, moved, added };
+        std::sort(expected.begin(), expected.end());
+        CHECK(dispatchSorted(wheel, 20) == expected);
+    }
+
+    // 长时间没有推进（如系统休眠）后所有项都到期一次
+    void testLongGap() {
+        TimingWheel wheel;
+        unsigned a = wheel.add(5, 0);
+        unsigned b = wheel.add(3000, 0);
+        CHECK(dispatchSorted(wheel, 100000).size() == 2);
+        CHECK(dispatchSorted(wheel, 100004).empty());
+        CHECK(dispatchSorted(wheel, 100005) == std::vector<unsigned>{ a });
+        CHECK(dispatchSorted(wheel, 103000).size() == 2);
+        (void)b;
+    }
+
+    // 随机的添加、移除、重新调度与参考实现一致，推进步长有时按nextDeadline，有时随机
+    void testAgainstReference() {
+        std::mt19937 rng(36);
+        for (int round = 0; round < 50; ++round) {
+            TimingWheel wheel;
+            Reference reference;
+            std::vector<unsigned> live;
+            uint64_t now = rng() % 100000;
+            int mismatches = 0;
+
+            for (int step = 0; step < 2000; ++step) {
+                switch (rng() % 8) {
+                case 0: case 1: {
+                    uint64_t interval = 1 + rng() % (rng() % 4 ? 100 : 4000);
+                    unsigned id = wheel.add(interval, now);
+                    reference.set(id, interval, now);
+                    live.push_back(id);
+                    break;
+                }
+                case 2:
+                    if (!live.empty()) {
+                        size_t n = rng() % live.size();
+                        wheel.remove(live[n]);
+                        reference.remove(live[n]);
+                        live.erase(live.begin() + n);
+                    }
+                    break;
+                case 3:
+                    if (!live.empty()) {
+                        unsigned id = live[rng() % live.size()];
+                        uint64_t interval = 1 + rng() % 300;
+                        wheel.reschedule(id, interval, now);
+                        reference.set(id, interval, now);
+                    }
+                    break;
+                default: {
+                    uint64_t next = wheel.nextDeadline();
+                    if (next && reference.size() && next > reference.nextDeadline()) ++mismatches;
+                    now = (next && rng() % 2) ? (std::max)(next, now + 1) : now + 1 + rng() % 200;
+                    if (dispatchSorted(wheel, now) != reference.dispatch(now)) ++mismatches;
+                    break;
+                }
+                }
+                if (wheel.size() != reference.size()) ++mismatches;
+            }
+            CHECK(mismatches == 0);
+        }
+    }
+
+} // namespace
+
+int main() {
+    testCascade();
+    testReschedule();
+    testChangesWhileDispatching();
+    testLongGap();
+    testAgainstReference();
+    return Test::report("timing_wheel_test");
+}
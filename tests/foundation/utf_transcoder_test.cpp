@@ -0,0 +1,340 @@
+#include "foundation/utf_transcoder.h"
+#include "test_common.h"
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// 用-fshort-wchar编译时覆盖Windows上的UTF-16路径，此时标准库的std::wstring与本文件的wchar_t大小不一致，不能使用
+#ifdef UTF_TEST_SHORT_WCHAR
+static_assert(sizeof(wchar_t) == 2, "UTF_TEST_SHORT_WCHAR需要2字节的wchar_t");
+#endif
+
+namespace Utf = Foundation::Utf;
+
+namespace {
+
+    constexpr bool WIDE_IS_UTF16 = sizeof(wchar_t) == 2;
+    // 写在输出缓冲区末尾之后，检查是否越界
+    constexpr wchar_t WIDE_GUARD = static_cast<wchar_t>(0x5A5A);
+    constexpr char BYTE_GUARD = 0x5A;
+
+    using Bytes = std::string;
+    using Units = std::vector<wchar_t>;
+
+    // ---- 参考实现：按定义逐个码点处理，不追求速度 ----
+
+    Bytes encodeUtf8(char32_t cp) {
+        Bytes out;
+        if (cp < 0x80) {
+            out += char(cp);
+        } else if (cp < 0x800) {
+            out += char(0xC0 | (cp >> 6));
+            out += char(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += char(0xE0 | (cp >> 12));
+            out += char(0x80 | ((cp >> 6) & 0x3F));
+            out += char(0x80 | (cp & 0x3F));
+        } else {
+            out += char(0xF0 | (cp >> 18));
+            out += char(0x80 | ((cp >> 12) & 0x3F));
+            out += char(0x80 | ((cp >> 6) & 0x3F));
+            out += char(0x80 | (cp & 0x3F));
+        }
+        return out;
+    }
+
+    void appendUnits(Units& out, char32_t cp) {
+        if (WIDE_IS_UTF16 && cp > 0xFFFF) {
+            out.push_back(wchar_t(0xD800 + ((cp - 0x10000) >> 10)));
+            out.push_back(wchar_t(0xDC00 + ((cp - 0x10000) & 0x3FF)));
+        } else {
+            out.push_back(wchar_t(cp));
+        }
+    }
+
+    bool isScalar(char32_t cp) {
+        return cp <= 0x10FFFF && (cp < 0xD800 || cp > 0xDFFF);
+    }
+
+    // 所有Unicode标量值的UTF-8编码及其真前缀，由编码器穷举得到
+    struct Utf8Table {
+        std::unordered_map<Bytes, char32_t> complete;
+        std::unordered_set<Bytes> prefixes;
+
+        Utf8Table() {
+            for (char32_t cp = 0; cp <= 0x10FFFF; ++cp) {
+                if (!isScalar(cp)) continue;
+                Bytes bytes = encodeUtf8(cp);
+                complete.emplace(bytes, cp);
+                for (size_t k = 1; k < bytes.size(); ++k) {
+                    prefixes.insert(bytes.substr(0, k));
+                }
+            }
+        }
+    };
+
+    const Utf8Table& table() {
+        static const Utf8Table instance;
+        return instance;
+    }
+
+    // 有效序列解码为码点；无效时把最长的有效前缀（至少一个字节）替换为一个U+FFFD
+    Units referenceToWide(const Bytes& src) {
+        const Utf8Table& t = table();
+        Units out;
+        size_t i = 0;
+        while (i < src.size()) {
+            size_t taken = 0;
+            char32_t cp = Utf::REPLACEMENT_CHAR;
+            for (size_t k = 1; k <= 4 && i + k <= src.size(); ++k) {
+                Bytes part = src.substr(i, k);
+                auto it = t.complete.find(part);
+                if (it != t.complete.end()) {
+                    taken = k;
+                    cp = it->second;
+                    break;
+                }
+                if (!t.prefixes.count(part)) break;
+                taken = k;
+            }
+            i += taken ? taken : 1;
+            appendUnits(out, cp);
+        }
+        return out;
+    }
+
+    // 代理对合并为一个码点；孤立的代理项和超出范围的值替换为U+FFFD
+    Bytes referenceToUtf8(const Units& src) {
+        Bytes out;
+        for (size_t i = 0; i < src.size(); ++i) {
+            char32_t cp = WIDE_IS_UTF16 ? char32_t(uint16_t(src[i])) : char32_t(uint32_t(src[i]));
+            if (WIDE_IS_UTF16 && cp >= 0xD800 && cp <= 0xDBFF && i + 1 < src.size()) {
+                char32_t next = uint16_t(src[i + 1]);
+                if (next >= 0xDC00 && next <= 0xDFFF) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (next - 0xDC00);
+                    ++i;
+                }
+            }
+            out += encodeUtf8(isScalar(cp) ? cp : Utf::REPLACEMENT_CHAR);
+        }
+        return out;
+    }
+
+    // ---- 被测实现：缓冲区按文档中的最大长度分配，末尾放置保护值 ----
+
+    Units toWide(const Bytes& src, bool& overrun) {
+        size_t capacity = Utf::maxWideLength(src.size());
+        Units out(capacity + 4, WIDE_GUARD);
+        size_t n = Utf::utf8ToWide(src.data(), src.size(), out.data());
+        overrun = n > capacity;
+        for (size_t k = capacity; k < out.size(); ++k) {
+            overrun = overrun || out[k] != WIDE_GUARD;
+        }
+        out.resize(n > capacity ? capacity : n);
+        return out;
+    }
+
+    Bytes toUtf8(const Units& src, bool& overrun) {
+        size_t capacity = Utf::maxUtf8Length(src.size());
+        Bytes out(capacity + 4, BYTE_GUARD);
+        size_t n = Utf::wideToUtf8(src.data(), src.size(), &out[0]);
+        overrun = n > capacity;
+        for (size_t k = capacity; k < out.size(); ++k) {
+            overrun = overrun || out[k] != BYTE_GUARD;
+        }
+        out.resize(n > capacity ? capacity : n);
+        return out;
+    }
+
+    struct Mismatches {
+        int decode = 0;
+        int encode = 0;
+        int overrun = 0;
+    };
+
+    void checkDecode(const Bytes& src, Mismatches& m) {
+        bool overrun;
+        if (toWide(src, overrun) != referenceToWide(src)) ++m.decode;
+        if (overrun) ++m.overrun;
+    }
+
+    void checkEncode(const Units& src, Mismatches& m) {
+        bool overrun;
+        if (toUtf8(src, overrun) != referenceToUtf8(src)) ++m.encode;
+        if (overrun) ++m.overrun;
+    }
+
+    // ---- 测试 ----
+
+    // 所有1字节和2字节输入，以及所有以多字节前导字节开头的3字节输入
+    void testExhaustiveShortInputs() {
+        Mismatches m;
+        for (int a = 0; a < 256; ++a) {
+            checkDecode(Bytes(1, char(a)), m);
+            for (int b = 0; b < 256; ++b) {
+                checkDecode(Bytes{ char(a), char(b) }, m);
+            }
+        }
+        for (int a = 0xE0; a <= 0xF4; ++a) {
+            for (int b = 0; b < 256; ++b) {
+                for (int c = 0; c < 256; ++c) {
+                    checkDecode(Bytes{ char(a), char(b), char(c) }, m);
+                }
+            }
+        }
+        CHECK(m.decode == 0);
+        CHECK(m.overrun == 0);
+    }
+
+    // 所有单个代码单元，以及UTF-16下按步长抽样的高/低代理项组合（含顺序颠倒和重复的高代理项）
+    void testExhaustiveUnits() {
+        Mismatches m;
+        for (uint32_t u = 0; u <= 0xFFFF; ++u) {
+            checkEncode(Units{ wchar_t(u) }, m);
+            checkEncode(Units{ L'a', wchar_t(u), L'b' }, m);
+        }
+        if (WIDE_IS_UTF16) {
+            for (uint32_t hi = 0xD800; hi <= 0xDBFF; hi += 7) {
+                for (uint32_t lo = 0xDC00; lo <= 0xDFFF; lo += 5) {
+                    checkEncode(Units{ wchar_t(hi), wchar_t(lo) }, m);
+                    checkEncode(Units{ wchar_t(lo), wchar_t(hi) }, m);
+                    checkEncode(Units{ wchar_t(hi), wchar_t(hi), wchar_t(lo) }, m);
+                }
+            }
+        } else {
+            const uint32_t values[] = { 0x10000, 0x1F600, 0x10FFFF, 0x110000, 0x7FFFFFFF, 0xFFFFFFFF };
+            for (uint32_t v : values) {
+                checkEncode(Units{ wchar_t(v) }, m);
+            }
+        }
+        CHECK(m.encode == 0);
+        CHECK(m.overrun == 0);
+    }
+
+    // 典型的无效序列
+    void testInvalidSequences() {
+        struct Case {
+            Bytes input;
+            std::vector<char32_t> expected;
+        };
+        const char32_t R = Utf::REPLACEMENT_CHAR;
+        const Case cases[] = {
+            { "\xC0\xAF", { R, R } },                       // 超长编码的前导字节
+            { "\xE0\x80\xAF", { R, R, R } },                // 超长的3字节编码
+            { "\xF0\x80\x80\xAF", { R, R, R, R } },         // 超长的4字节编码
+            { "\xED\xA0\x80", { R, R, R } },                // 编码的代理项
+            { "\xF4\x90\x80\x80", { R, R, R, R } },         // 超过U+10FFFF
+            { "\xF5\x80", { R, R } },
+            { "\x80\xBF", { R, R } },                       // 孤立的后续字节
+            { "\xE4\xB8", { R } },                          // 截断的3字节序列整体替换一次
+            { "\xF0\x9F\x98", { R } },                      // 截断的4字节序列
+            { "\xF0\x9F\x98" "a", { R, 'a' } },
+            { "\xE4\xB8\xAD\xE6\x96", { 0x4E2D, R } },
+            { "\xF0\x9F\x98\x80", { 0x1F600 } },
+        };
+        for (const Case& c : cases) {
+            Units expected;
+            for (char32_t cp : c.expected) appendUnits(expected, cp);
+            bool overrun;
+            CHECK(toWide(c.input, overrun) == expected);
+            CHECK(referenceToWide(c.input) == expected);
+        }
+    }
+
+    // 随机混合：跨越8/16字节块边界的ASCII段、中文、补充平面字符、随机字节、截断序列
+    void testRandomMixes() {
+        std::mt19937 rng(46);
+        Mismatches m;
+        for (int n = 0; n < 20000; ++n) {
+            Bytes text;
+            int parts = int(rng() % 24);
+            for (int p = 0; p < parts; ++p) {
+                switch (rng() % 6) {
+                case 0:
+                case 1:
+                    text.append(rng() % 40, char(0x20 + rng() % 0x5F));
+                    break;
+                case 2:
+                    for (int k = int(rng() % 8); k >= 0; --k) text += encodeUtf8(0x4E00 + rng() % 0x5200);
+                    break;
+                case 3:
+                    text += encodeUtf8(0x10000 + rng() % 0x100000);
+                    break;
+                case 4:
+                    for (int k = int(rng() % 5); k >= 0; --k) text += char(rng());
+                    break;
+                default: {
+                    Bytes full = encodeUtf8(0x80 + rng() % 0x10FF80);
+                    text += full.substr(0, 1 + rng() % full.size());
+                    break;
+                }
+                }
+            }
+            checkDecode(text, m);
+
+            Units units;
+            for (int p = int(rng() % 60); p >= 0; --p) {
+                uint32_t r = rng() % 10;
+                if (r < 4) units.push_back(wchar_t(0x20 + rng() % 0x5F));
+                else if (r < 6) units.push_back(wchar_t(0x80 + rng() % 0xFF80));
+                else if (r < 8) appendUnits(units, 0x10000 + rng() % 0x100000);
+                else units.push_back(wchar_t(0xD800 + rng() % 0x800));    // 孤立的代理项
+            }
+            checkEncode(units, m);
+        }
+        CHECK(m.decode == 0);
+        CHECK(m.encode == 0);
+        CHECK(m.overrun == 0);
+    }
+
+    // 有效文本往返转换后不变
+    void testRoundTrip() {
+        std::mt19937 rng(4646);
+        int failures = 0;
+        for (int n = 0; n < 5000; ++n) {
+            Bytes text;
+            for (int k = int(rng() % 100); k >= 0; --k) {
+                char32_t cp;
+                do {
+                    cp = (rng() & 1) ? rng() % 0x80 : rng() % 0x110000;
+                } while (!isScalar(cp));
+                text += encodeUtf8(cp);
+            }
+            bool overrun1, overrun2;
+            Units wide = toWide(text, overrun1);
+            if (toUtf8(wide, overrun2) != text || overrun1 || overrun2) ++failures;
+        }
+        CHECK(failures == 0);
+    }
+
+#ifndef UTF_TEST_SHORT_WCHAR
+    // 追加到已有内容之后
+    void testAppend() {
+        std::wstring wide = L"x";
+        Utf::appendWide(wide, "\xE4\xB8\xAD\xFF", 4);
+        CHECK(wide == std::wstring(L"x\u4E2D\uFFFD"));
+
+        std::string bytes = "y";
+        Utf::appendUtf8(bytes, wide.data(), wide.size());
+        CHECK(bytes == "yx\xE4\xB8\xAD\xEF\xBF\xBD");
+
+        Utf::appendWide(wide, "", 0);
+        CHECK(wide.size() == 3);
+    }
+#endif
+
+} // namespace
+
+int main() {
+    testExhaustiveShortInputs();
+    testExhaustiveUnits();
+    testInvalidSequences();
+    testRandomMixes();
+    testRoundTrip();
+#ifndef UTF_TEST_SHORT_WCHAR
+    testAppend();
+#endif
+    return Test::report(WIDE_IS_UTF16 ? "utf_transcoder_test (UTF-16)" : "utf_transcoder_test (UTF-32)");
+}
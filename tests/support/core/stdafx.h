@@ -0,0 +1,8 @@
+#pragma once
+
+// 单元测试用的预编译头替身
+// src/foundation 中的模块不依赖平台接口，只需要标准库头文件
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdio>
+
+// 单元测试的最小支持：不依赖测试框架，检查失败时输出位置，全部结束后返回进程退出码
+namespace Test {
+
+    inline int& failures() {
+        static int count = 0;
+        return count;
+    }
+
+    inline bool check(bool ok, const char* expr, const char* file, int line) {
+        if (!ok) {
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+            ++failures();
+        }
+        return ok;
+    }
+
+    // 输出结果，返回给main作为退出码
+    inline int report(const char* name) {
+        if (failures()) {
+            std::fprintf(stderr, "%s: %d check(s) failed\n", name, failures());
+            return 1;
+        }
+        std::printf("%s: passed\n", name);
+        return 0;
+    }
+
+} // namespace Test
+
+#define CHECK(expr) ::Test::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)